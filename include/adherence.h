@@ -0,0 +1,62 @@
+#pragma once
+
+// Medication adherence over the last 7 and 30 days, per medicine and per day.
+// Fed with dose outcomes (schedule status changes and confirmations); every
+// event updates the day bucket and the running window totals directly, so
+// recording and reading are O(1) and memory is fixed.
+//
+// Days are counted by the display clock passing midnight. Each dose is known
+// by reminder id and time for the current day, so the minder re-sending a
+// status, or a confirmation followed by "completed", is counted once; a later
+// outcome replaces an earlier one (missed -> taken).
+//
+// Up to ADHERENCE_MEDICINES medicines are counted separately, the rest under
+// "Other". A medicine's slot is reused once it has no doses in 30 days.
+
+#include <Arduino.h>
+#include "day_time.h"
+#include "name_table.h"
+
+#define ADHERENCE_DAYS      30
+#define ADHERENCE_WEEK      7
+#define ADHERENCE_MEDICINES 8
+#define ADHERENCE_OTHER     ADHERENCE_MEDICINES  // slot for untracked medicines
+#define ADHERENCE_TODAY_MAX 64   // doses remembered for the current day
+#define ADHERENCE_LATE_MIN  30   // taken this long after the dose time is late
+
+enum DoseOutcome : uint8_t {
+  DOSE_NONE,
+  DOSE_TAKEN,
+  DOSE_LATE,
+  DOSE_MISSED
+};
+
+struct AdherenceCounts {
+  uint16_t taken;
+  uint16_t late;
+  uint16_t missed;
+};
+
+void adherenceReset();
+void adherenceRecord(int reminderId, DayMinute time, NameId medicine, DoseOutcome outcome);
+DoseOutcome adherenceOutcome(int reminderId, DayMinute time);  // today, DOSE_NONE if not recorded
+
+// True once when the clock passes midnight (or jumps back by more than 12 h);
+// record what the day still owes, then call adherenceRollDay()
+bool adherenceDayEnded(DayMinute now);
+void adherenceRollDay();
+
+// Aggregates; month picks the 30-day window over the 7-day one
+const AdherenceCounts& adherenceTotal(bool month);
+NameId adherenceMedicine(int slot);  // NAME_NONE for unused slots and Other
+const AdherenceCounts& adherenceForMedicine(int slot, bool month);
+const AdherenceCounts& adherenceDay(int daysAgo);  // 0 = today
+int adherencePercent(const AdherenceCounts& counts);  // taken or late, -1 without doses
+uint32_t adherenceVersion();  // bumped by every change
+
+// Kept in the model snapshot (snapshot.h); the medicines' names must stay
+// interned, so markLiveNames() calls adherenceMarkNames()
+void adherenceSave();
+bool adherenceLoad();
+size_t adherenceStateSize();
+void adherenceMarkNames();
@@ -0,0 +1,18 @@
+#pragma once
+
+// Counts heap allocations made by one task, to check that a code path does
+// not allocate:
+//
+//   allocCountBegin();  // count allocations of the calling task from now on
+//   uint32_t before = allocCount();
+//   syncContainers(list);
+//   uint32_t allocations = allocCount() - before;
+//
+// Only active in builds with the ALLOC_COUNT flags from platformio.ini, which
+// wrap malloc/calloc/realloc at link time; otherwise allocCount() stays 0.
+
+#include <Arduino.h>
+
+void allocCountBegin();
+uint32_t allocCount();
+bool allocCountEnabled();
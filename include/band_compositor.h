@@ -0,0 +1,69 @@
+#pragma once
+
+// Off-screen composition in horizontal bands. A full 16-bit frame (300 KB at
+// 320x480) does not fit in DRAM, so one band of BAND_HEIGHT rows is kept as a
+// 4-bit (palettized) or 8-bit (RGB332) sprite. bandCompose() fills the band,
+// runs the paint function into it and pushes the finished rows, band after
+// band; the panel never shows the clear or the overdraw in between.
+//
+// With BAND_PING_PONG there are two bands: while a task on the other core
+// pushes one over SPI, the next is drawn into the other, so a full screen
+// takes about as long as the transfer alone. (The panel is an ILI9488 on
+// SPI, which needs 18-bit pixels; TFT_eSPI's pushImageDMA() only sends 16-bit
+// ones, so the second core does the transfer instead of DMA.)
+//
+// A screen is painted in two parts: its chrome (titles, labels, buttons,
+// the background) never changes, its fields do. The chrome is rendered once
+// into a static layer, kept as runs of palette colours per row in a pool of
+// BAND_LAYER_POOL bytes (a 4-bit copy of a whole screen would be 75 KB), and
+// later compositions copy the runs into the band and paint only the fields.
+// When the pool is full the layers are dropped and rebuilt as screens are
+// shown again.
+//
+// Paint functions draw in screen coordinates through the TFT_eSPI& they are
+// given. With a 4-bit band, 565 colours are mapped to the nearest palette
+// entry, so the palette should hold the colours the screens use; static
+// layers always store palette colours.
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+
+#ifndef BAND_HEIGHT
+#define BAND_HEIGHT 48  // rows; benchBandHeights() compares a few
+#endif
+#ifndef BAND_BITS
+#define BAND_BITS 4     // 4 (palette) or 8 (RGB332)
+#endif
+#ifndef BAND_PING_PONG
+#define BAND_PING_PONG 1
+#endif
+
+#ifndef BAND_LAYER_POOL
+#define BAND_LAYER_POOL (24 * 1024)
+#endif
+
+#define BAND_MAX_BYTES (40 * 1024)  // both bands together
+#define BAND_LAYERS 12              // static layer slots
+#define LAYER_NONE 0xFF
+
+typedef void (*BandPaint)(TFT_eSPI& gfx);
+
+// False (and drawing stays direct) if the band would exceed BAND_MAX_BYTES
+// or cannot be allocated
+bool bandBegin(TFT_eSPI& tft, int height, uint8_t bits, const uint16_t* palette, uint8_t colors,
+               bool pingPong);
+void bandEnd();
+bool bandActive();
+size_t bandBytes();
+
+// Renders the screen area x, y, w, h; only that area is pushed to the panel.
+// chrome goes into static layer slot layer (LAYER_NONE paints it every
+// time), fields are painted over it. The last pushes may still be running:
+// call bandWait() before drawing to the panel directly.
+void bandCompose(int x, int y, int w, int h, uint16_t background, BandPaint chrome, BandPaint fields,
+                 uint8_t layer);
+bool bandBusy();  // a push is queued or running
+void bandWait();
+
+void bandDropLayers();
+size_t bandLayerBytes();  // pool in use
@@ -0,0 +1,35 @@
+#pragma once
+
+// Record and replay of the incoming frame stream, for reproducing field issues
+// and timing UI changes against real traffic.
+//
+// Capture stores every received frame with its arrival time (millis):
+//   CAPTURE_SERIAL - a text line on the debug port:  CAP <ms> <payload as hex>
+//   CAPTURE_FLASH  - CAPTURE_FILE on LittleFS: "CAP1", then per frame
+//                    [ms u32 LE][length u16 LE][payload]
+// tools/replay.py reads both forms; the flash file can also be replayed on the
+// device itself with replayCapture().
+
+#include <Arduino.h>
+#include "frame.h"
+
+#define CAPTURE_FILE      "/capture.bin"
+#define CAPTURE_MAX_BYTES (256 * 1024)
+#define REPLAY_MAX_SPEED  0.0f  // no waits between frames
+
+enum CaptureMode { CAPTURE_OFF, CAPTURE_SERIAL, CAPTURE_FLASH };
+
+bool captureBegin(CaptureMode mode);  // CAPTURE_FLASH starts a fresh file
+void captureEnd();
+void captureFrame(const char* data, size_t len);
+
+// Parse/render cost per frame, fed by the receive path for live and replayed
+// traffic while a capture or replay runs (frameTimingActive())
+bool frameTimingActive();
+void frameTimingAdd(size_t len, uint32_t parseUs, uint32_t renderUs);
+void frameTimingReset();
+void frameTimingReport();
+
+// Plays CAPTURE_FILE into decoder. speed 1.0 keeps the recorded pace, 4.0 runs
+// four times faster, REPLAY_MAX_SPEED does not wait at all.
+bool replayCapture(FrameDecoder& decoder, float speed);
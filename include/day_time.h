@@ -0,0 +1,17 @@
+#pragma once
+
+// Times of day as minutes since midnight (0..1439), parsed once when the
+// minder's "HH:MM" strings arrive so nothing downstream handles text.
+
+#include <Arduino.h>
+
+typedef uint16_t DayMinute;
+
+#define MINUTE_NONE   0xFFFF  // missing or malformed; sorts after every real time
+#define MINUTES_PER_DAY 1440
+
+// "8:05", "08:05" or "08:05:30" -> 485; MINUTE_NONE otherwise
+DayMinute parseDayMinute(const char* text);
+
+// "HH:MM" into out (at least 6 bytes); "--:--" for MINUTE_NONE
+void formatDayMinute(DayMinute minute, char* out);
@@ -0,0 +1,32 @@
+#pragma once
+
+// Partial repaints for screens that rarely change. Changed areas are marked
+// with dirtyInvalidate(); overlapping or touching rectangles are merged, and
+// when the list is full the pair that grows least is merged. dirtyRepaint()
+// then fills each rectangle with the background and runs the screen's paint
+// functions clipped to it with setViewport(), so nothing outside the dirty
+// areas goes over SPI and a frame with nothing dirty sends nothing. With a
+// band compositor (band_compositor.h) the rectangles are composed off screen
+// and pushed finished instead.
+//
+// Screens are painted in two parts, their chrome and their fields (see
+// band_compositor.h); both draw the whole screen in screen coordinates
+// through the TFT_eSPI& they are given, without clearing it first.
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include "band_compositor.h"
+
+#define DIRTY_MAX_RECTS 8
+
+typedef BandPaint RegionPaint;
+
+void dirtyBegin(int width, int height);
+void dirtyInvalidate(int x, int y, int w, int h);
+void dirtyInvalidateAll();
+int dirtyRectCount();
+
+// Repaints and clears the dirty list; returns the number of rectangles.
+// layer is the chrome's static layer slot, or LAYER_NONE.
+int dirtyRepaint(TFT_eSPI& tft, uint16_t background, RegionPaint chrome, RegionPaint fields, uint8_t layer);
+uint32_t dirtyPixelsPainted();  // running total, for measuring
@@ -0,0 +1,67 @@
+#pragma once
+
+// Fixed-capacity string stored inline (no heap). Holds up to N characters;
+// longer values are truncated, never at a point that would split a UTF-8
+// sequence. Mirrors the parts of the Arduino String API the model uses, and
+// converts to const char* so it can go straight to tft.print()/printf("%s").
+
+#include <Arduino.h>
+
+template <size_t N>
+class FixedString {
+ public:
+  FixedString() { buf_[0] = '\0'; }
+  FixedString(const char* s) { assign(s); }
+
+  FixedString& operator=(const char* s) {
+    assign(s);
+    return *this;
+  }
+
+  template <size_t M>
+  FixedString& operator=(const FixedString<M>& other) {
+    assign(other.c_str());
+    return *this;
+  }
+
+  FixedString& operator+=(const char* s) {
+    size_t len = length();
+    copyTruncated(buf_ + len, s, N - len);
+    return *this;
+  }
+
+  void assign(const char* s) { copyTruncated(buf_, s, N); }
+  void clear() { buf_[0] = '\0'; }
+
+  const char* c_str() const { return buf_; }
+  operator const char*() const { return buf_; }
+  size_t length() const { return strlen(buf_); }
+  bool isEmpty() const { return buf_[0] == '\0'; }
+  static size_t capacity() { return N; }
+
+  bool operator==(const char* s) const { return strcmp(buf_, s ? s : "") == 0; }
+  bool operator!=(const char* s) const { return !(*this == s); }
+  template <size_t M>
+  bool operator==(const FixedString<M>& other) const { return strcmp(buf_, other.c_str()) == 0; }
+  template <size_t M>
+  bool operator!=(const FixedString<M>& other) const { return !(*this == other); }
+
+ private:
+  // Copies up to max bytes of src into dst and terminates it
+  static void copyTruncated(char* dst, const char* src, size_t max) {
+    size_t n = 0;
+    if (src) {
+      while (n < max && src[n]) n++;
+      // Cut before a partial UTF-8 sequence rather than in the middle of it
+      if (src[n] && n > 0) {
+        size_t start = n;
+        while (start > 0 && ((uint8_t)src[start] & 0xC0) == 0x80) start--;
+        n = start;
+      }
+      memcpy(dst, src, n);
+    }
+    dst[n] = '\0';
+  }
+
+  char buf_[N + 1];
+};
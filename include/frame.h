@@ -0,0 +1,37 @@
+#pragma once
+
+// UART framing used between the minder and the display:
+//   0x7E 0x7E | length hi | length lo | data | XOR of data | 0x00
+// The decoder is fed one byte at a time and calls its handler for every frame
+// whose checksum and trailer check out.
+
+#include <Arduino.h>
+
+#define FRAME_SYNC     0x7E
+#define FRAME_MAX_DATA 1023
+
+typedef void (*FrameHandler)(const char* data, size_t len);
+
+class FrameDecoder {
+ public:
+  explicit FrameDecoder(FrameHandler onFrame);
+
+  void feed(uint8_t b);
+
+  // Wraps data in the framing above and feeds it byte by byte, exactly as if it
+  // had arrived on the UART (used by replay)
+  void feedFrame(const char* data, size_t len);
+
+  uint32_t checksumErrors() const { return checksumErrors_; }
+
+ private:
+  enum State { SYNC1, SYNC2, LENGTH_HIGH, LENGTH_LOW, DATA, CHECKSUM, END };
+
+  FrameHandler onFrame_;
+  State state_;
+  uint16_t length_;
+  uint16_t count_;
+  uint8_t checksum_;
+  uint32_t checksumErrors_;
+  char buffer_[FRAME_MAX_DATA + 1];  // NUL-terminated for the JSON path
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+// Small open-addressing map from a record id to its slot in a fixed array,
+// so messages that name a container or reminder find it without a scan.
+// N must be a power of two. Up to about N / 2 records the probe chains stay
+// short; past N, put() fails and the caller has to fall back to a scan of
+// its array for ids that are not in the index. Entries are only added;
+// clear() and re-put() when the array is rebuilt.
+
+#include <Arduino.h>
+
+template <size_t N>
+class IdIndex {
+  static_assert((N & (N - 1)) == 0, "IdIndex size must be a power of two");
+
+ public:
+  IdIndex() { clear(); }
+
+  void clear() {
+    for (size_t i = 0; i < N; i++) keys_[i] = EMPTY;
+  }
+
+  // Maps id to slot, replacing an earlier mapping; false if the table is full
+  bool put(int id, uint16_t slot) {
+    size_t i = home(id);
+    for (size_t probes = 0; probes < N; probes++, i = (i + 1) & (N - 1)) {
+      if (keys_[i] == EMPTY || keys_[i] == id) {
+        keys_[i] = id;
+        slots_[i] = slot;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Slot for id, or -1
+  int find(int id) const {
+    size_t i = home(id);
+    for (size_t probes = 0; probes < N && keys_[i] != EMPTY; probes++, i = (i + 1) & (N - 1)) {
+      if (keys_[i] == id) return slots_[i];
+    }
+    return -1;
+  }
+
+ private:
+  static const int32_t EMPTY = INT32_MIN;
+
+  // Fibonacci hashing; the high bits are the well-mixed ones
+  static size_t home(int id) { return ((uint32_t)id * 2654435769u) >> 16 & (N - 1); }
+
+  int32_t keys_[N];
+  uint16_t slots_[N];
+};
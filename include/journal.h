@@ -0,0 +1,59 @@
+#pragma once
+
+// Append-only event journal (dispense, confirm, cancel, timeout, jam) in its
+// own flash partition, "journal" in partitions.csv. The partition is a ring of
+// 4 KB sectors written in order, so every sector is erased equally often.
+//
+// Sector: [magic u32][epoch u32][reserved 8] then 8-byte records.
+// Epoch e always lives in sector e % sectors, and record i in epoch i / 510,
+// slot i % 510, so a record's place follows from its index and reading
+// backwards is plain arithmetic. A record with a bad CRC (reset mid-write) is
+// skipped; the tail is found again at boot by scanning the newest sector.
+//
+// journalAppend() only copies into a RAM queue. A background task writes
+// queued records with one flash write per batch and erases the next sector
+// ahead of time, so loop() never waits for a flash erase.
+
+#include <Arduino.h>
+#include "day_time.h"
+
+#define JOURNAL_PARTITION   "journal"
+#define JOURNAL_QUEUE       32    // records waiting for the flush task
+#define JOURNAL_FLUSH_MS    2000  // write a partial batch after this long
+
+enum JournalType : uint8_t {
+  JOURNAL_DISPENSE = 1,  // value: pills dispensed
+  JOURNAL_CONFIRM,       // value: confirmation type
+  JOURNAL_CANCEL,        // value: confirmation type
+  JOURNAL_TIMEOUT,       // value: confirmation type
+  JOURNAL_JAM,           // value: pills remaining
+  JOURNAL_LOCAL_ALERT    // value: reminder id
+};
+
+struct JournalEvent {
+  DayMinute minute;  // clock time, MINUTE_NONE if not known
+  uint8_t type;      // JournalType
+  uint8_t container;
+  int16_t value;
+  uint8_t reserved;
+  uint8_t crc;
+};
+
+static_assert(sizeof(JournalEvent) == 8, "journal records are 8 bytes");
+
+// Finds the partition and the tail; false (journal off) without a partition
+bool journalBegin();
+void journalStartTask();
+
+// Never touches flash; counted in journalDropped() if the queue is full
+void journalAppend(JournalType type, uint8_t container, int16_t value, DayMinute minute);
+uint32_t journalDropped();
+
+// One step of background work (a batch write or an erase); false when idle
+bool journalService();
+
+// Newest first: start at journalEnd() and call journalPrev() until false
+uint32_t journalEnd();
+bool journalPrev(uint32_t& cursor, JournalEvent& event);
+
+const char* journalTypeName(uint8_t type);
@@ -0,0 +1,54 @@
+#pragma once
+
+// Capability handshake with the minder. At start-up the display sends "hello"
+// with what it supports; the minder answers "hello_ack" with its own side.
+// Both ends then use the common subset: lowest protocol version and frame
+// size, shared encodings and feature bits, slowest of the two maximum bauds.
+// A minder that never answers is treated as legacy: JSON lines, 9600 baud,
+// and hello keeps going out at a slow pace in case it boots later. A
+// negotiated link that goes silent or keeps failing checksums is dropped back
+// to legacy and negotiated again (a rebooted minder is back at 9600).
+
+#include <Arduino.h>
+#include "messages.h"
+
+#define LINK_PROTO_VERSION     1
+#define LINK_LEGACY_BAUD       9600
+#define LINK_MAX_BAUD          115200
+#define LINK_HELLO_INTERVAL_MS 2000
+#define LINK_HELLO_RETRIES     3      // at LINK_HELLO_INTERVAL_MS, then slow
+#define LINK_HELLO_SLOW_MS     30000
+#define LINK_RESYNC_ERRORS     5      // checksum errors within LINK_ERROR_WINDOW_MS
+#define LINK_ERROR_WINDOW_MS   10000
+
+// Encodings (bitmask); JSON is always available
+#define LINK_ENC_JSON   0x01
+#define LINK_ENC_BINARY 0x02  // binary payloads, framed the same way in both directions
+
+// Feature bits: a feature is used only when both sides set it. Unknown bits
+// from a newer peer drop out of the AND, so new bits can be added freely.
+#define LINK_FEAT_BATCH             0x0001  // "batch" envelope frames, applied with one repaint
+#define LINK_FEAT_OFFLINE_REMINDERS 0x0002  // display reports alerts it raised on its own
+#define LINK_FEAT_OUTBOX_ACK        0x0004  // minder acks user responses by seq (outbox_ack)
+
+struct LinkCaps {
+  uint32_t version;    // 0 = legacy peer, no handshake
+  uint32_t maxFrame;   // largest frame payload either side may send
+  uint32_t encodings;
+  uint32_t features;
+  uint32_t baud;
+};
+
+extern LinkCaps linkCaps;  // what the link currently runs with
+
+void linkBegin();  // reset to legacy and send hello
+// Resends hello until answered; renegotiates a negotiated link when the
+// minder has gone silent or checksumErrors (the receive decoder's running
+// count) climbs too fast
+void linkPoll(bool minderSilent, uint32_t checksumErrors);
+void linkAccept(const HelloAckMsg& peer);
+bool linkSettled();  // handshake answered or out of fast retries, so linkCaps holds for now
+
+inline bool linkHasFeature(uint32_t feature) {
+  return (linkCaps.features & feature) == feature;
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+// Leveled, deferred logging. LOG_xxx() calls only copy the format pointer and
+// the raw arguments into a ring buffer; a low-priority task does the printf
+// formatting and the Serial writes. Levels above LOG_LEVEL compile to nothing,
+// arguments included.
+//
+//   LOG_INFO("Synced %d containers", containerCount);
+//
+// The format string must be a literal (only its pointer is stored). String
+// arguments are copied, truncated to LOG_MAX_STR characters. Arguments that
+// no longer fit the record are dropped from there on and print as <trunc>.
+
+#include <Arduino.h>
+
+#define LOG_LEVEL_NONE  0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_INFO  3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#ifndef LOG_BUFFER_SIZE
+#define LOG_BUFFER_SIZE 2048  // bytes, power of two
+#endif
+
+#define LOG_MAX_STR  64   // longest string argument kept per record
+#define LOG_MAX_ARGS 120  // encoded argument bytes per record
+
+enum LogArgTag : uint8_t { LOG_ARG_INT, LOG_ARG_UINT, LOG_ARG_DOUBLE, LOG_ARG_STR };
+
+// Arguments of one record, tagged so the drain task can format them later
+class LogArgs {
+ public:
+  LogArgs() : len_(0), full_(false) {}
+
+  void add(int v) { putInt(LOG_ARG_INT, (uint32_t)v); }
+  void add(long v) { putInt(LOG_ARG_INT, (uint32_t)v); }
+  void add(unsigned v) { putInt(LOG_ARG_UINT, v); }
+  void add(unsigned long v) { putInt(LOG_ARG_UINT, (uint32_t)v); }
+  void add(double v) {
+    if (!reserve(1 + sizeof(v))) return;
+    buf_[len_++] = LOG_ARG_DOUBLE;
+    memcpy(buf_ + len_, &v, sizeof(v));
+    len_ += sizeof(v);
+  }
+  void add(const char* s) {
+    if (!s) s = "(null)";
+    size_t n = strnlen(s, LOG_MAX_STR);
+    // A string is cut to the space left rather than dropped
+    if (!full_ && len_ + 2 < sizeof(buf_) && len_ + 2 + n > sizeof(buf_)) n = sizeof(buf_) - len_ - 2;
+    if (!reserve(2 + n)) return;
+    buf_[len_++] = LOG_ARG_STR;
+    buf_[len_++] = (uint8_t)n;
+    memcpy(buf_ + len_, s, n);
+    len_ += n;
+  }
+  void add(const String& s) { add(s.c_str()); }
+
+  const uint8_t* data() const { return buf_; }
+  uint8_t length() const { return len_; }
+
+ private:
+  // Once one argument is dropped, later ones are too, so none of them
+  // lines up with the wrong conversion
+  bool reserve(size_t n) {
+    if (len_ + n > sizeof(buf_)) full_ = true;
+    return !full_;
+  }
+
+  void putInt(LogArgTag tag, uint32_t v) {
+    if (!reserve(1 + sizeof(v))) return;
+    buf_[len_++] = tag;
+    memcpy(buf_ + len_, &v, sizeof(v));
+    len_ += sizeof(v);
+  }
+
+  uint8_t buf_[LOG_MAX_ARGS];
+  uint8_t len_;
+  bool full_;
+};
+
+void logBegin();                 // start the drain task; records queue up before this
+void logDrain();                 // format and print everything queued, on the caller's task
+uint32_t logDroppedCount();      // records lost because the ring was full
+void logCommit(uint8_t level, const char* fmt, const LogArgs& args);
+
+inline void logPack(LogArgs&) {}
+
+template <typename T, typename... Rest>
+inline void logPack(LogArgs& args, const T& value, const Rest&... rest) {
+  args.add(value);
+  logPack(args, rest...);
+}
+
+template <typename... Args>
+inline void logWrite(uint8_t level, const char* fmt, const Args&... values) {
+  LogArgs args;
+  logPack(args, values...);
+  logCommit(level, fmt, args);
+}
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) logWrite(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(...) logWrite(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) logWrite(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) logWrite(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) do {} while (0)
+#endif
@@ -0,0 +1,992 @@
+// Generated by tools/gen_messages.py from schema/messages.json - do not edit.
+#pragma once
+
+#include "msg_codec.h"
+
+#define MSG_SCHEMA_VERSION 1
+
+enum MsgType : uint8_t {
+  MSG_UNKNOWN = 0,
+  MSG_STATUS = 1,
+  MSG_SYNC_ALL_DATA = 2,
+  MSG_CONTAINERS_INFO = 3,
+  MSG_REMINDERS_INFO = 4,
+  MSG_DAILY_SCHEDULE = 5,
+  MSG_SENSOR_DATA = 6,
+  MSG_SYSTEM_STATUS = 7,
+  MSG_DEVICE_INFO = 8,
+  MSG_ALARM_STATUS = 9,
+  MSG_CONFIRMATION_REQUEST = 10,
+  MSG_REMINDER_ALERT = 11,
+  MSG_GROUPED_REMINDER_ALERT = 12,
+  MSG_DISPENSING_STATUS = 13,
+  MSG_ALL_DISPENSING_COMPLETED = 14,
+  MSG_STOCK_ALERT = 15,
+  MSG_JAM_ALERT = 16,
+  MSG_WIFI_ERROR_ALERT = 17,
+  MSG_CURRENT_TIME = 18,
+  MSG_ERROR = 19,
+  MSG_CONTROL_QUEUE_COMPLETE = 20,
+  MSG_AP_MODE_STARTED = 21,
+  MSG_HELLO_ACK = 22,
+  MSG_BATCH = 23,
+  MSG_SCHEDULE_ITEM_STATUS = 24,
+  MSG_OUTBOX_ACK = 25,
+  MSG_CONFIRMATION_RESPONSE = 64,
+  MSG_QUANTITY_CONFIRMED = 65,
+  MSG_DISPENSING_REQUEST = 66,
+  MSG_JAM_CLEARED = 67,
+  MSG_HELLO = 68,
+  MSG_OFFLINE_REMINDER = 69,
+};
+
+const char* msgTypeName(MsgType type);
+MsgType msgTypeFromName(const char* name);
+MsgType msgTypeFromId(uint8_t id);
+bool readMsgHeader(BinReader& src, MsgType& type);
+
+// ---- Records ----
+
+struct ContainerRec {
+  int id = 0;
+  int container_id = 0;
+  int container_number = 0;
+  const char* medicine_name = "Unknown";
+  int current_capacity = 0;
+  int max_capacity = 0;
+  int quantity = 0;
+  bool low_stock = false;
+};
+
+struct ReminderTimeRec {
+  const char* time = "";
+  int dosage = 1;
+};
+
+struct ReminderRec {
+  int id = 0;
+  const char* medicine_name = "Unknown";
+  int container_id = 0;
+  int container_number = 0;
+  const char* schedule_type = "daily";
+  bool active = false;
+  const char* notes = "";
+  MsgList<ReminderTimeRec> times;
+};
+
+struct ScheduleRec {
+  const char* time = "";
+  const char* medicine_name = "";
+  int container_id = 0;
+  int container_number = 0;
+  int dosage = 1;
+  const char* schedule_type = "";
+  const char* notes = "";
+  int reminder_id = 0;
+  const char* status = "pending";
+};
+
+struct ReminderItemRec {
+  int id = 0;
+  const char* medicine_name = "";
+  int container_id = 0;
+  int dosage = 1;
+};
+
+struct AlertRec {
+  const char* medicine_name = "";
+  int container_id = 0;
+  int container_number = 0;
+  int dosage = 1;
+  const char* schedule_type = "";
+  const char* notes = "";
+  int reminder_id = 0;
+};
+
+bool decodeMsg(JsonObjectConst src, ContainerRec& dst);
+bool decodeMsg(BinReader& src, ContainerRec& dst);
+void encodeMsg(const ContainerRec& src, JsonObject dst);
+void encodeMsg(const ContainerRec& src, BinWriter& dst);
+void writeJson(const ContainerRec& src, JsonWriter& out);
+void hashMsg(const ContainerRec& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, ReminderTimeRec& dst);
+bool decodeMsg(BinReader& src, ReminderTimeRec& dst);
+void encodeMsg(const ReminderTimeRec& src, JsonObject dst);
+void encodeMsg(const ReminderTimeRec& src, BinWriter& dst);
+void writeJson(const ReminderTimeRec& src, JsonWriter& out);
+void hashMsg(const ReminderTimeRec& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, ReminderRec& dst);
+bool decodeMsg(BinReader& src, ReminderRec& dst);
+void encodeMsg(const ReminderRec& src, JsonObject dst);
+void encodeMsg(const ReminderRec& src, BinWriter& dst);
+void writeJson(const ReminderRec& src, JsonWriter& out);
+void hashMsg(const ReminderRec& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, ScheduleRec& dst);
+bool decodeMsg(BinReader& src, ScheduleRec& dst);
+void encodeMsg(const ScheduleRec& src, JsonObject dst);
+void encodeMsg(const ScheduleRec& src, BinWriter& dst);
+void writeJson(const ScheduleRec& src, JsonWriter& out);
+void hashMsg(const ScheduleRec& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, ReminderItemRec& dst);
+bool decodeMsg(BinReader& src, ReminderItemRec& dst);
+void encodeMsg(const ReminderItemRec& src, JsonObject dst);
+void encodeMsg(const ReminderItemRec& src, BinWriter& dst);
+void writeJson(const ReminderItemRec& src, JsonWriter& out);
+void hashMsg(const ReminderItemRec& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, AlertRec& dst);
+bool decodeMsg(BinReader& src, AlertRec& dst);
+void encodeMsg(const AlertRec& src, JsonObject dst);
+void encodeMsg(const AlertRec& src, BinWriter& dst);
+void writeJson(const AlertRec& src, JsonWriter& out);
+void hashMsg(const AlertRec& src, MsgHash& h);
+
+// ---- Messages ----
+
+struct StatusMsg {
+  static const MsgType TYPE = MSG_STATUS;
+  static const size_t MAX_JSON_LEN = 0;  // unbounded
+  const char* message = "";
+};
+
+struct SyncAllDataMsg {
+  static const MsgType TYPE = MSG_SYNC_ALL_DATA;
+  static const size_t MAX_JSON_LEN = 0;  // unbounded
+  bool wifi_connected = false;
+  bool mqtt_connected = false;
+  bool time_synced = false;
+  MsgList<ContainerRec> containers;
+  MsgList<ReminderRec> reminders;
+  MsgList<ScheduleRec> daily_schedule;
+};
+
+struct ContainersInfoMsg {
+  static const MsgType TYPE = MSG_CONTAINERS_INFO;
+  static const size_t MAX_JSON_LEN = 0;  // unbounded
+  uint32_t timestamp = 0;
+  MsgList<ContainerRec> containers;
+};
+
+struct RemindersInfoMsg {
+  static const MsgType TYPE = MSG_REMINDERS_INFO;
+  static const size_t MAX_JSON_LEN = 0;  // unbounded
+  uint32_t timestamp = 0;
+  MsgList<ReminderRec> reminders;
+};
+
+struct DailyScheduleMsg {
+  static const MsgType TYPE = MSG_DAILY_SCHEDULE;
+  static const size_t MAX_JSON_LEN = 0;  // unbounded
+  const char* current_time = "";
+  uint32_t timestamp = 0;
+  MsgList<ScheduleRec> schedule;
+};
+
+struct SensorDataMsg {
+  static const MsgType TYPE = MSG_SENSOR_DATA;
+  static const size_t MAX_JSON_LEN = 102;
+  float temperature = 0.0f;
+  float humidity = 0.0f;
+  uint32_t timestamp = 0;
+};
+
+struct SystemStatusMsg {
+  static const MsgType TYPE = MSG_SYSTEM_STATUS;
+  static const size_t MAX_JSON_LEN = 0;  // unbounded
+  const char* wifi_status = "disconnected";
+  const char* mqtt_status = "disconnected";
+  const char* sd_card_status = "";
+  bool ap_mode = false;
+  bool rtc_time_set = false;
+  float temperature = 0.0f;
+  float humidity = 0.0f;
+  const char* operation_mode = "offline";
+  int pending_actions = 0;
+  uint32_t timestamp = 0;
+};
+
+struct DeviceInfoMsg {
+  static const MsgType TYPE = MSG_DEVICE_INFO;
+  static const size_t MAX_JSON_LEN = 0;  // unbounded
+  int id = 0;
+  const char* uid = "";
+  const char* device_name = "";
+  const char* current_state = "";
+  float temperature = 0.0f;
+  float humidity = 0.0f;
+  uint32_t timestamp = 0;
+};
+
+struct AlarmStatusMsg {
+  static const MsgType TYPE = MSG_ALARM_STATUS;
+  static const size_t MAX_JSON_LEN = 0;  // unbounded
+  bool alarm_active = false;
+  const char* alarm_type = "";
+  uint32_t timestamp = 0;
+};
+
+struct ConfirmationRequestMsg {
+  static const MsgType TYPE = MSG_CONFIRMATION_REQUEST;
+  static const size_t MAX_JSON_LEN = 0;  // unbounded
+  const char* request_type = "medication";
+  int timeout_seconds = 60;
+  MsgList<ReminderItemRec> reminders;
+  int control_id = 0;
+  const char* action = "";
+  const char* medicine_name = "";
+  int container_id = 0;
+  int quantity = 0;
+  const char* message = "";
+};
+
+struct ReminderAlertMsg {
+  static const MsgType TYPE = MSG_REMINDER_ALERT;
+  static const size_t MAX_JSON_LEN = 0;  // unbounded
+  const char* medicine_name = "";
+  int container_id = 0;
+  int dosage = 1;
+  const char* schedule_type = "reminder";
+  const char* notes = "";
+  const char* reminder_time = "";
+  const char* source = "mqtt";
+  const char* operation_mode = "online";
+  int alert_count = 0;
+  uint32_t timestamp = 0;
+};
+
+struct GroupedReminderAlertMsg {
+  static const MsgType TYPE = MSG_GROUPED_REMINDER_ALERT;
+  static const size_t MAX_JSON_LEN = 0;  // unbounded
+  const char* reminder_time = "";
+  int alert_count = 0;
+  MsgList<AlertRec> alerts;
+  uint32_t timestamp = 0;
+};
+
+struct DispensingStatusMsg {
+  static const MsgType TYPE = MSG_DISPENSING_STATUS;
+  static const size_t MAX_JSON_LEN = 0;  // unbounded
+  const char* status = "";
+  const char* medicine_name = "";
+  int container_number = 0;
+  int dosage = 0;
+  int pills_remaining = 0;
+  uint32_t timestamp = 0;
+};
+
+struct AllDispensingCompletedMsg {
+  static const MsgType TYPE = MSG_ALL_DISPENSING_COMPLETED;
+  static const size_t MAX_JSON_LEN = 35;
+};
+
+struct StockAlertMsg {
+  static const MsgType TYPE = MSG_STOCK_ALERT;
+  static const size_t MAX_JSON_LEN = 0;  // unbounded
+  const char* medicine_name = "";
+  int container_number = 0;
+  int current_stock = 0;
+  int minimum_stock = 0;
+  const char* alert_level = "";
+  const char* recommendation = "";
+  uint32_t timestamp = 0;
+};
+
+struct JamAlertMsg {
+  static const MsgType TYPE = MSG_JAM_ALERT;
+  static const size_t MAX_JSON_LEN = 0;  // unbounded
+  int container_number = 0;
+  const char* medicine_name = "";
+  int pills_remaining = 0;
+};
+
+struct WifiErrorAlertMsg {
+  static const MsgType TYPE = MSG_WIFI_ERROR_ALERT;
+  static const size_t MAX_JSON_LEN = 0;  // unbounded
+  const char* message = "";
+  const char* instruction = "";
+};
+
+struct CurrentTimeMsg {
+  static const MsgType TYPE = MSG_CURRENT_TIME;
+  static const size_t MAX_JSON_LEN = 0;  // unbounded
+  const char* time = "00:00";
+};
+
+struct ErrorMsg {
+  static const MsgType TYPE = MSG_ERROR;
+  static const size_t MAX_JSON_LEN = 0;  // unbounded
+  const char* message = "";
+};
+
+struct ControlQueueCompleteMsg {
+  static const MsgType TYPE = MSG_CONTROL_QUEUE_COMPLETE;
+  static const size_t MAX_JSON_LEN = 0;  // unbounded
+  int queue_id = 0;
+  bool success = false;
+  const char* message = "";
+};
+
+struct ApModeStartedMsg {
+  static const MsgType TYPE = MSG_AP_MODE_STARTED;
+  static const size_t MAX_JSON_LEN = 0;  // unbounded
+  const char* message = "";
+};
+
+struct HelloAckMsg {
+  static const MsgType TYPE = MSG_HELLO_ACK;
+  static const size_t MAX_JSON_LEN = 137;
+  uint32_t proto_version = 0;
+  uint32_t max_frame = 1023;
+  uint32_t encodings = 1;
+  uint32_t features = 0;
+  uint32_t max_baud = 9600;
+};
+
+struct ScheduleItemStatusMsg {
+  static const MsgType TYPE = MSG_SCHEDULE_ITEM_STATUS;
+  static const size_t MAX_JSON_LEN = 0;  // unbounded
+  int reminder_id = 0;
+  const char* time = "";
+  const char* status = "";
+};
+
+struct OutboxAckMsg {
+  static const MsgType TYPE = MSG_OUTBOX_ACK;
+  static const size_t MAX_JSON_LEN = 38;
+  uint32_t seq = 0;
+};
+
+struct ConfirmationResponseMsg {
+  static const MsgType TYPE = MSG_CONFIRMATION_RESPONSE;
+  static const size_t MAX_JSON_LEN = 185;
+  bool confirmed = false;
+  bool timeout = false;
+  int confirmation_type = 0;
+  int control_id = 0;
+  uint32_t seq = 0;
+  const char* queued_at = "";
+};
+
+struct QuantityConfirmedMsg {
+  static const MsgType TYPE = MSG_QUANTITY_CONFIRMED;
+  static const size_t MAX_JSON_LEN = 109;
+  bool confirmed = false;
+  uint32_t seq = 0;
+  const char* queued_at = "";
+};
+
+struct DispensingRequestMsg {
+  static const MsgType TYPE = MSG_DISPENSING_REQUEST;
+  static const size_t MAX_JSON_LEN = 288;
+  int container_id = 0;
+  int dosage = 0;
+  const char* medicine_name = "";
+};
+
+struct JamClearedMsg {
+  static const MsgType TYPE = MSG_JAM_CLEARED;
+  static const size_t MAX_JSON_LEN = 115;
+  int container_number = 0;
+  uint32_t seq = 0;
+  const char* queued_at = "";
+};
+
+struct HelloMsg {
+  static const MsgType TYPE = MSG_HELLO;
+  static const size_t MAX_JSON_LEN = 133;
+  uint32_t proto_version = 0;
+  uint32_t max_frame = 1023;
+  uint32_t encodings = 1;
+  uint32_t features = 0;
+  uint32_t max_baud = 9600;
+};
+
+struct OfflineReminderMsg {
+  static const MsgType TYPE = MSG_OFFLINE_REMINDER;
+  static const size_t MAX_JSON_LEN = 120;
+  int reminder_id = 0;
+  const char* reminder_time = "";
+  bool dismissed = false;
+};
+
+bool decodeMsg(JsonObjectConst src, StatusMsg& dst);
+bool decodeMsg(BinReader& src, StatusMsg& dst);
+void encodeMsg(const StatusMsg& src, JsonObject dst);
+void encodeMsg(const StatusMsg& src, BinWriter& dst);
+void writeJson(const StatusMsg& src, JsonWriter& out);
+void hashMsg(const StatusMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, SyncAllDataMsg& dst);
+bool decodeMsg(BinReader& src, SyncAllDataMsg& dst);
+void encodeMsg(const SyncAllDataMsg& src, JsonObject dst);
+void encodeMsg(const SyncAllDataMsg& src, BinWriter& dst);
+void writeJson(const SyncAllDataMsg& src, JsonWriter& out);
+void hashMsg(const SyncAllDataMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, ContainersInfoMsg& dst);
+bool decodeMsg(BinReader& src, ContainersInfoMsg& dst);
+void encodeMsg(const ContainersInfoMsg& src, JsonObject dst);
+void encodeMsg(const ContainersInfoMsg& src, BinWriter& dst);
+void writeJson(const ContainersInfoMsg& src, JsonWriter& out);
+void hashMsg(const ContainersInfoMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, RemindersInfoMsg& dst);
+bool decodeMsg(BinReader& src, RemindersInfoMsg& dst);
+void encodeMsg(const RemindersInfoMsg& src, JsonObject dst);
+void encodeMsg(const RemindersInfoMsg& src, BinWriter& dst);
+void writeJson(const RemindersInfoMsg& src, JsonWriter& out);
+void hashMsg(const RemindersInfoMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, DailyScheduleMsg& dst);
+bool decodeMsg(BinReader& src, DailyScheduleMsg& dst);
+void encodeMsg(const DailyScheduleMsg& src, JsonObject dst);
+void encodeMsg(const DailyScheduleMsg& src, BinWriter& dst);
+void writeJson(const DailyScheduleMsg& src, JsonWriter& out);
+void hashMsg(const DailyScheduleMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, SensorDataMsg& dst);
+bool decodeMsg(BinReader& src, SensorDataMsg& dst);
+void encodeMsg(const SensorDataMsg& src, JsonObject dst);
+void encodeMsg(const SensorDataMsg& src, BinWriter& dst);
+void writeJson(const SensorDataMsg& src, JsonWriter& out);
+void hashMsg(const SensorDataMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, SystemStatusMsg& dst);
+bool decodeMsg(BinReader& src, SystemStatusMsg& dst);
+void encodeMsg(const SystemStatusMsg& src, JsonObject dst);
+void encodeMsg(const SystemStatusMsg& src, BinWriter& dst);
+void writeJson(const SystemStatusMsg& src, JsonWriter& out);
+void hashMsg(const SystemStatusMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, DeviceInfoMsg& dst);
+bool decodeMsg(BinReader& src, DeviceInfoMsg& dst);
+void encodeMsg(const DeviceInfoMsg& src, JsonObject dst);
+void encodeMsg(const DeviceInfoMsg& src, BinWriter& dst);
+void writeJson(const DeviceInfoMsg& src, JsonWriter& out);
+void hashMsg(const DeviceInfoMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, AlarmStatusMsg& dst);
+bool decodeMsg(BinReader& src, AlarmStatusMsg& dst);
+void encodeMsg(const AlarmStatusMsg& src, JsonObject dst);
+void encodeMsg(const AlarmStatusMsg& src, BinWriter& dst);
+void writeJson(const AlarmStatusMsg& src, JsonWriter& out);
+void hashMsg(const AlarmStatusMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, ConfirmationRequestMsg& dst);
+bool decodeMsg(BinReader& src, ConfirmationRequestMsg& dst);
+void encodeMsg(const ConfirmationRequestMsg& src, JsonObject dst);
+void encodeMsg(const ConfirmationRequestMsg& src, BinWriter& dst);
+void writeJson(const ConfirmationRequestMsg& src, JsonWriter& out);
+void hashMsg(const ConfirmationRequestMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, ReminderAlertMsg& dst);
+bool decodeMsg(BinReader& src, ReminderAlertMsg& dst);
+void encodeMsg(const ReminderAlertMsg& src, JsonObject dst);
+void encodeMsg(const ReminderAlertMsg& src, BinWriter& dst);
+void writeJson(const ReminderAlertMsg& src, JsonWriter& out);
+void hashMsg(const ReminderAlertMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, GroupedReminderAlertMsg& dst);
+bool decodeMsg(BinReader& src, GroupedReminderAlertMsg& dst);
+void encodeMsg(const GroupedReminderAlertMsg& src, JsonObject dst);
+void encodeMsg(const GroupedReminderAlertMsg& src, BinWriter& dst);
+void writeJson(const GroupedReminderAlertMsg& src, JsonWriter& out);
+void hashMsg(const GroupedReminderAlertMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, DispensingStatusMsg& dst);
+bool decodeMsg(BinReader& src, DispensingStatusMsg& dst);
+void encodeMsg(const DispensingStatusMsg& src, JsonObject dst);
+void encodeMsg(const DispensingStatusMsg& src, BinWriter& dst);
+void writeJson(const DispensingStatusMsg& src, JsonWriter& out);
+void hashMsg(const DispensingStatusMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, AllDispensingCompletedMsg& dst);
+bool decodeMsg(BinReader& src, AllDispensingCompletedMsg& dst);
+void encodeMsg(const AllDispensingCompletedMsg& src, JsonObject dst);
+void encodeMsg(const AllDispensingCompletedMsg& src, BinWriter& dst);
+void writeJson(const AllDispensingCompletedMsg& src, JsonWriter& out);
+void hashMsg(const AllDispensingCompletedMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, StockAlertMsg& dst);
+bool decodeMsg(BinReader& src, StockAlertMsg& dst);
+void encodeMsg(const StockAlertMsg& src, JsonObject dst);
+void encodeMsg(const StockAlertMsg& src, BinWriter& dst);
+void writeJson(const StockAlertMsg& src, JsonWriter& out);
+void hashMsg(const StockAlertMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, JamAlertMsg& dst);
+bool decodeMsg(BinReader& src, JamAlertMsg& dst);
+void encodeMsg(const JamAlertMsg& src, JsonObject dst);
+void encodeMsg(const JamAlertMsg& src, BinWriter& dst);
+void writeJson(const JamAlertMsg& src, JsonWriter& out);
+void hashMsg(const JamAlertMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, WifiErrorAlertMsg& dst);
+bool decodeMsg(BinReader& src, WifiErrorAlertMsg& dst);
+void encodeMsg(const WifiErrorAlertMsg& src, JsonObject dst);
+void encodeMsg(const WifiErrorAlertMsg& src, BinWriter& dst);
+void writeJson(const WifiErrorAlertMsg& src, JsonWriter& out);
+void hashMsg(const WifiErrorAlertMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, CurrentTimeMsg& dst);
+bool decodeMsg(BinReader& src, CurrentTimeMsg& dst);
+void encodeMsg(const CurrentTimeMsg& src, JsonObject dst);
+void encodeMsg(const CurrentTimeMsg& src, BinWriter& dst);
+void writeJson(const CurrentTimeMsg& src, JsonWriter& out);
+void hashMsg(const CurrentTimeMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, ErrorMsg& dst);
+bool decodeMsg(BinReader& src, ErrorMsg& dst);
+void encodeMsg(const ErrorMsg& src, JsonObject dst);
+void encodeMsg(const ErrorMsg& src, BinWriter& dst);
+void writeJson(const ErrorMsg& src, JsonWriter& out);
+void hashMsg(const ErrorMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, ControlQueueCompleteMsg& dst);
+bool decodeMsg(BinReader& src, ControlQueueCompleteMsg& dst);
+void encodeMsg(const ControlQueueCompleteMsg& src, JsonObject dst);
+void encodeMsg(const ControlQueueCompleteMsg& src, BinWriter& dst);
+void writeJson(const ControlQueueCompleteMsg& src, JsonWriter& out);
+void hashMsg(const ControlQueueCompleteMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, ApModeStartedMsg& dst);
+bool decodeMsg(BinReader& src, ApModeStartedMsg& dst);
+void encodeMsg(const ApModeStartedMsg& src, JsonObject dst);
+void encodeMsg(const ApModeStartedMsg& src, BinWriter& dst);
+void writeJson(const ApModeStartedMsg& src, JsonWriter& out);
+void hashMsg(const ApModeStartedMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, HelloAckMsg& dst);
+bool decodeMsg(BinReader& src, HelloAckMsg& dst);
+void encodeMsg(const HelloAckMsg& src, JsonObject dst);
+void encodeMsg(const HelloAckMsg& src, BinWriter& dst);
+void writeJson(const HelloAckMsg& src, JsonWriter& out);
+void hashMsg(const HelloAckMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, ScheduleItemStatusMsg& dst);
+bool decodeMsg(BinReader& src, ScheduleItemStatusMsg& dst);
+void encodeMsg(const ScheduleItemStatusMsg& src, JsonObject dst);
+void encodeMsg(const ScheduleItemStatusMsg& src, BinWriter& dst);
+void writeJson(const ScheduleItemStatusMsg& src, JsonWriter& out);
+void hashMsg(const ScheduleItemStatusMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, OutboxAckMsg& dst);
+bool decodeMsg(BinReader& src, OutboxAckMsg& dst);
+void encodeMsg(const OutboxAckMsg& src, JsonObject dst);
+void encodeMsg(const OutboxAckMsg& src, BinWriter& dst);
+void writeJson(const OutboxAckMsg& src, JsonWriter& out);
+void hashMsg(const OutboxAckMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, ConfirmationResponseMsg& dst);
+bool decodeMsg(BinReader& src, ConfirmationResponseMsg& dst);
+void encodeMsg(const ConfirmationResponseMsg& src, JsonObject dst);
+void encodeMsg(const ConfirmationResponseMsg& src, BinWriter& dst);
+void writeJson(const ConfirmationResponseMsg& src, JsonWriter& out);
+void hashMsg(const ConfirmationResponseMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, QuantityConfirmedMsg& dst);
+bool decodeMsg(BinReader& src, QuantityConfirmedMsg& dst);
+void encodeMsg(const QuantityConfirmedMsg& src, JsonObject dst);
+void encodeMsg(const QuantityConfirmedMsg& src, BinWriter& dst);
+void writeJson(const QuantityConfirmedMsg& src, JsonWriter& out);
+void hashMsg(const QuantityConfirmedMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, DispensingRequestMsg& dst);
+bool decodeMsg(BinReader& src, DispensingRequestMsg& dst);
+void encodeMsg(const DispensingRequestMsg& src, JsonObject dst);
+void encodeMsg(const DispensingRequestMsg& src, BinWriter& dst);
+void writeJson(const DispensingRequestMsg& src, JsonWriter& out);
+void hashMsg(const DispensingRequestMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, JamClearedMsg& dst);
+bool decodeMsg(BinReader& src, JamClearedMsg& dst);
+void encodeMsg(const JamClearedMsg& src, JsonObject dst);
+void encodeMsg(const JamClearedMsg& src, BinWriter& dst);
+void writeJson(const JamClearedMsg& src, JsonWriter& out);
+void hashMsg(const JamClearedMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, HelloMsg& dst);
+bool decodeMsg(BinReader& src, HelloMsg& dst);
+void encodeMsg(const HelloMsg& src, JsonObject dst);
+void encodeMsg(const HelloMsg& src, BinWriter& dst);
+void writeJson(const HelloMsg& src, JsonWriter& out);
+void hashMsg(const HelloMsg& src, MsgHash& h);
+
+bool decodeMsg(JsonObjectConst src, OfflineReminderMsg& dst);
+bool decodeMsg(BinReader& src, OfflineReminderMsg& dst);
+void encodeMsg(const OfflineReminderMsg& src, JsonObject dst);
+void encodeMsg(const OfflineReminderMsg& src, BinWriter& dst);
+void writeJson(const OfflineReminderMsg& src, JsonWriter& out);
+void hashMsg(const OfflineReminderMsg& src, MsgHash& h);
+
+// Handlers for messages sent to the display, implemented by that firmware
+void handleMessage(const StatusMsg& msg);
+void handleMessage(const SyncAllDataMsg& msg);
+void handleMessage(const ContainersInfoMsg& msg);
+void handleMessage(const RemindersInfoMsg& msg);
+void handleMessage(const DailyScheduleMsg& msg);
+void handleMessage(const SensorDataMsg& msg);
+void handleMessage(const SystemStatusMsg& msg);
+void handleMessage(const DeviceInfoMsg& msg);
+void handleMessage(const AlarmStatusMsg& msg);
+void handleMessage(const ConfirmationRequestMsg& msg);
+void handleMessage(const ReminderAlertMsg& msg);
+void handleMessage(const GroupedReminderAlertMsg& msg);
+void handleMessage(const DispensingStatusMsg& msg);
+void handleMessage(const AllDispensingCompletedMsg& msg);
+void handleMessage(const StockAlertMsg& msg);
+void handleMessage(const JamAlertMsg& msg);
+void handleMessage(const WifiErrorAlertMsg& msg);
+void handleMessage(const CurrentTimeMsg& msg);
+void handleMessage(const ErrorMsg& msg);
+void handleMessage(const ControlQueueCompleteMsg& msg);
+void handleMessage(const ApModeStartedMsg& msg);
+void handleMessage(const HelloAckMsg& msg);
+void handleMessage(const ScheduleItemStatusMsg& msg);
+void handleMessage(const OutboxAckMsg& msg);
+
+// Handlers for messages sent to the minder, implemented by that firmware
+void handleMessage(const ConfirmationResponseMsg& msg);
+void handleMessage(const QuantityConfirmedMsg& msg);
+void handleMessage(const DispensingRequestMsg& msg);
+void handleMessage(const JamClearedMsg& msg);
+void handleMessage(const HelloMsg& msg);
+void handleMessage(const OfflineReminderMsg& msg);
+
+// Decode one message from a JSON object or a BinReader and call handleMessage()
+template <typename Source>
+bool dispatchDisplayMessage(MsgType type, Source& src) {
+  switch (type) {
+    case MSG_STATUS: {
+      StatusMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_SYNC_ALL_DATA: {
+      SyncAllDataMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_CONTAINERS_INFO: {
+      ContainersInfoMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_REMINDERS_INFO: {
+      RemindersInfoMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_DAILY_SCHEDULE: {
+      DailyScheduleMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_SENSOR_DATA: {
+      SensorDataMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_SYSTEM_STATUS: {
+      SystemStatusMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_DEVICE_INFO: {
+      DeviceInfoMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_ALARM_STATUS: {
+      AlarmStatusMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_CONFIRMATION_REQUEST: {
+      ConfirmationRequestMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_REMINDER_ALERT: {
+      ReminderAlertMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_GROUPED_REMINDER_ALERT: {
+      GroupedReminderAlertMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_DISPENSING_STATUS: {
+      DispensingStatusMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_ALL_DISPENSING_COMPLETED: {
+      AllDispensingCompletedMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_STOCK_ALERT: {
+      StockAlertMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_JAM_ALERT: {
+      JamAlertMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_WIFI_ERROR_ALERT: {
+      WifiErrorAlertMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_CURRENT_TIME: {
+      CurrentTimeMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_ERROR: {
+      ErrorMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_CONTROL_QUEUE_COMPLETE: {
+      ControlQueueCompleteMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_AP_MODE_STARTED: {
+      ApModeStartedMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_HELLO_ACK: {
+      HelloAckMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_SCHEDULE_ITEM_STATUS: {
+      ScheduleItemStatusMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_OUTBOX_ACK: {
+      OutboxAckMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+template <typename Source>
+bool dispatchMinderMessage(MsgType type, Source& src) {
+  switch (type) {
+    case MSG_CONFIRMATION_RESPONSE: {
+      ConfirmationResponseMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_QUANTITY_CONFIRMED: {
+      QuantityConfirmedMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_DISPENSING_REQUEST: {
+      DispensingRequestMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_JAM_CLEARED: {
+      JamClearedMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_HELLO: {
+      HelloMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    case MSG_OFFLINE_REMINDER: {
+      OfflineReminderMsg msg;
+      if (!decodeMsg(src, msg)) return false;
+      handleMessage(msg);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+// Decode only, to check a message before anything is applied
+template <typename Source>
+bool validateDisplayMessage(MsgType type, Source& src) {
+  switch (type) {
+    case MSG_STATUS: {
+      StatusMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_SYNC_ALL_DATA: {
+      SyncAllDataMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_CONTAINERS_INFO: {
+      ContainersInfoMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_REMINDERS_INFO: {
+      RemindersInfoMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_DAILY_SCHEDULE: {
+      DailyScheduleMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_SENSOR_DATA: {
+      SensorDataMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_SYSTEM_STATUS: {
+      SystemStatusMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_DEVICE_INFO: {
+      DeviceInfoMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_ALARM_STATUS: {
+      AlarmStatusMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_CONFIRMATION_REQUEST: {
+      ConfirmationRequestMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_REMINDER_ALERT: {
+      ReminderAlertMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_GROUPED_REMINDER_ALERT: {
+      GroupedReminderAlertMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_DISPENSING_STATUS: {
+      DispensingStatusMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_ALL_DISPENSING_COMPLETED: {
+      AllDispensingCompletedMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_STOCK_ALERT: {
+      StockAlertMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_JAM_ALERT: {
+      JamAlertMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_WIFI_ERROR_ALERT: {
+      WifiErrorAlertMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_CURRENT_TIME: {
+      CurrentTimeMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_ERROR: {
+      ErrorMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_CONTROL_QUEUE_COMPLETE: {
+      ControlQueueCompleteMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_AP_MODE_STARTED: {
+      ApModeStartedMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_HELLO_ACK: {
+      HelloAckMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_SCHEDULE_ITEM_STATUS: {
+      ScheduleItemStatusMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_OUTBOX_ACK: {
+      OutboxAckMsg msg;
+      return decodeMsg(src, msg);
+    }
+    default:
+      return false;
+  }
+}
+
+template <typename Source>
+bool validateMinderMessage(MsgType type, Source& src) {
+  switch (type) {
+    case MSG_CONFIRMATION_RESPONSE: {
+      ConfirmationResponseMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_QUANTITY_CONFIRMED: {
+      QuantityConfirmedMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_DISPENSING_REQUEST: {
+      DispensingRequestMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_JAM_CLEARED: {
+      JamClearedMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_HELLO: {
+      HelloMsg msg;
+      return decodeMsg(src, msg);
+    }
+    case MSG_OFFLINE_REMINDER: {
+      OfflineReminderMsg msg;
+      return decodeMsg(src, msg);
+    }
+    default:
+      return false;
+  }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+// One preallocated block shared by the growable model collections, so their
+// sizes are limited by a total budget (MODEL_ARENA_SIZE) instead of a fixed
+// count each. Every collection owns one segment; segments sit back to back
+// and growing one slides the segments after it with memmove.
+//
+// Segments move, so don't hold element pointers across a resize() of a
+// segment that comes earlier in ArenaSegment order.
+
+#include <Arduino.h>
+#include <type_traits>
+
+#ifndef MODEL_ARENA_SIZE
+#define MODEL_ARENA_SIZE 8192  // bytes
+#endif
+
+enum ArenaSegment : uint8_t {
+  SEG_CONTAINERS,
+  SEG_REMINDERS,
+  SEG_SCHEDULE,
+  SEG_CONFIRMATION,
+  SEG_REMINDER_TIMES,  // grows one reminder at a time during a sync
+  SEG_TIMERS,          // reminder timer wheel nodes (timer_wheel.h)
+  SEG_COUNT
+};
+
+void* arenaData(uint8_t segment);
+size_t arenaSize(uint8_t segment);
+// Resizes a segment, keeping its leading bytes and zeroing new ones; false
+// (and unchanged) if the budget cannot hold it
+bool arenaResize(uint8_t segment, size_t bytes);
+size_t arenaUsed();
+size_t arenaFree();
+
+// Write / restore every segment through the open snapshot (snapshot.h)
+void arenaSave();
+bool arenaLoad();
+
+// Array of trivially copyable records in an arena segment
+template <typename T>
+class ArenaList {
+  static_assert(std::is_trivially_copyable<T>::value, "ArenaList records are moved with memmove");
+
+ public:
+  explicit ArenaList(uint8_t segment) : segment_(segment) {}
+
+  // Sizes the list to count items, or as many as the budget allows; returns
+  // the new size. Existing items up to the new size are kept.
+  size_t resize(size_t count) {
+    size_t fit = ((arenaSize(segment_) + 3) / 4 * 4 + arenaFree()) / sizeof(T);
+    if (count > fit) count = fit;
+    arenaResize(segment_, count * sizeof(T));
+    return size();
+  }
+
+  void clear() { resize(0); }
+
+  size_t size() const { return arenaSize(segment_) / sizeof(T); }
+  bool empty() const { return size() == 0; }
+
+  T& operator[](size_t i) { return data()[i]; }
+  const T& operator[](size_t i) const { return data()[i]; }
+  T* begin() { return data(); }
+  T* end() { return data() + size(); }
+
+ private:
+  T* data() const { return (T*)arenaData(segment_); }
+
+  uint8_t segment_;
+};
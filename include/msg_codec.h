@@ -0,0 +1,405 @@
+#pragma once
+
+// Runtime support for the generated message codecs (messages.h).
+// Binary payloads start with MSG_BINARY_MAGIC followed by the message id; fields
+// follow in schema order: varints for ints, 4-byte floats, NUL-terminated
+// length-prefixed strings (decoded in place), u16 count + u16 length for lists.
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+#define MSG_BINARY_MAGIC 0xB5
+
+class BinWriter {
+ public:
+  BinWriter(uint8_t* buf, size_t capacity) : buf_(buf), cap_(capacity), len_(0), overflow_(false) {}
+
+  void putByte(uint8_t b) {
+    if (len_ < cap_) {
+      buf_[len_++] = b;
+    } else {
+      overflow_ = true;
+    }
+  }
+
+  void putVarint(uint32_t v) {
+    while (v >= 0x80) {
+      putByte((uint8_t)(v | 0x80));
+      v >>= 7;
+    }
+    putByte((uint8_t)v);
+  }
+
+  void putInt(int32_t v) { putVarint(((uint32_t)v << 1) ^ (uint32_t)(v >> 31)); }
+  void putBool(bool v) { putByte(v ? 1 : 0); }
+
+  void putFloat(float v) {
+    uint8_t raw[4];
+    memcpy(raw, &v, sizeof(raw));
+    for (int i = 0; i < 4; i++) putByte(raw[i]);
+  }
+
+  void putString(const char* s) {
+    size_t n = s ? strlen(s) : 0;
+    putVarint(n);
+    for (size_t i = 0; i < n; i++) putByte((uint8_t)s[i]);
+    putByte(0);
+  }
+
+  // Lists are written as u16 count + u16 byte length, patched once the items are out
+  size_t beginList() {
+    size_t mark = len_;
+    for (int i = 0; i < 4; i++) putByte(0);
+    return mark;
+  }
+
+  void endList(size_t mark, uint16_t count) {
+    if (overflow_) return;
+    size_t bytes = len_ - mark - 4;
+    if (bytes > 0xFFFF) {
+      overflow_ = true;
+      return;
+    }
+    buf_[mark] = count >> 8;
+    buf_[mark + 1] = count & 0xFF;
+    buf_[mark + 2] = bytes >> 8;
+    buf_[mark + 3] = bytes & 0xFF;
+  }
+
+  size_t length() const { return len_; }
+  bool ok() const { return !overflow_; }
+
+ private:
+  uint8_t* buf_;
+  size_t cap_;
+  size_t len_;
+  bool overflow_;
+};
+
+// Writes JSON text straight into a caller-owned buffer; used by the generated
+// writeJson() functions so outbound messages need no JsonDocument or String.
+class JsonWriter {
+ public:
+  JsonWriter(char* buf, size_t capacity) : buf_(buf), cap_(capacity), len_(0), overflow_(false) {}
+
+  void raw(const char* s) {
+    while (*s) put(*s++);
+  }
+
+  void value(bool v) { raw(v ? "true" : "false"); }
+
+  void value(uint32_t v) {
+    char digits[10];
+    int n = 0;
+    do {
+      digits[n++] = '0' + v % 10;
+      v /= 10;
+    } while (v);
+    while (n) put(digits[--n]);
+  }
+
+  void value(int v) {
+    if (v < 0) {
+      put('-');
+      value((uint32_t)(-(int64_t)v));
+    } else {
+      value((uint32_t)v);
+    }
+  }
+
+  // Fixed three decimals; avoids printf, which may allocate for floats.
+  // NaN and infinity are written as null, huge values are clamped.
+  void value(float v) {
+    if (!isfinite(v)) {
+      raw("null");
+      return;
+    }
+    if (v < 0) {
+      put('-');
+      v = -v;
+    }
+    if (v > UINT32_MAX / 1000) v = UINT32_MAX / 1000;
+    uint32_t milli = (uint32_t)(v * 1000.0f + 0.5f);
+    value(milli / 1000);
+    put('.');
+    put('0' + (milli / 100) % 10);
+    put('0' + (milli / 10) % 10);
+    put('0' + milli % 10);
+  }
+
+  // Quoted and escaped; at most maxLen source characters are written
+  void value(const char* s, size_t maxLen = (size_t)-1) {
+    put('"');
+    for (size_t i = 0; s && s[i] && i < maxLen; i++) {
+      char c = s[i];
+      if (c == '"' || c == '\\') {
+        put('\\');
+        put(c);
+      } else if ((uint8_t)c < 0x20) {
+        static const char hex[] = "0123456789abcdef";
+        raw("\\u00");
+        put(hex[(c >> 4) & 0xF]);
+        put(hex[c & 0xF]);
+      } else {
+        put(c);
+      }
+    }
+    put('"');
+  }
+
+  size_t length() const { return len_; }
+  bool ok() const { return !overflow_; }
+
+ private:
+  void put(char c) {
+    if (len_ < cap_) {
+      buf_[len_++] = c;
+    } else {
+      overflow_ = true;
+    }
+  }
+
+  char* buf_;
+  size_t cap_;
+  size_t len_;
+  bool overflow_;
+};
+
+// FNV-1a over decoded field values. The generated hashMsg() feeds it every
+// field in schema order, so two updates with the same content hash the same
+// whether they arrived as JSON or binary.
+class MsgHash {
+ public:
+  MsgHash() : h_(2166136261u) {}
+
+  void add(bool v) { byte(v ? 1 : 0); }
+  void add(int v) { word((uint32_t)v); }
+  void add(uint32_t v) { word(v); }
+
+  void add(float v) {
+    uint32_t w;
+    memcpy(&w, &v, sizeof(w));
+    word(w);
+  }
+
+  void add(const char* s) {
+    if (s) {
+      while (*s) byte((uint8_t)*s++);
+    }
+    byte(0);
+  }
+
+  uint32_t value() const { return h_; }
+
+ private:
+  void byte(uint8_t b) {
+    h_ ^= b;
+    h_ *= 16777619u;
+  }
+
+  void word(uint32_t w) {
+    for (int i = 0; i < 4; i++) byte((uint8_t)(w >> (8 * i)));
+  }
+
+  uint32_t h_;
+};
+
+template <typename T> class MsgList;
+
+class BinReader {
+ public:
+  BinReader(const uint8_t* data, size_t len) : p_(data), end_(data + len), fail_(false) {}
+
+  uint8_t getByte() {
+    if (p_ >= end_) {
+      fail_ = true;
+      return 0;
+    }
+    return *p_++;
+  }
+
+  uint32_t getVarint() {
+    uint32_t v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+      uint8_t b = getByte();
+      v |= (uint32_t)(b & 0x7F) << shift;
+      if (!(b & 0x80)) return v;
+    }
+    fail_ = true;
+    return 0;
+  }
+
+  int32_t getInt() {
+    uint32_t v = getVarint();
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+  }
+
+  bool getBool() { return getByte() != 0; }
+
+  float getFloat() {
+    uint8_t raw[4];
+    for (int i = 0; i < 4; i++) raw[i] = getByte();
+    float v;
+    memcpy(&v, raw, sizeof(v));
+    return v;
+  }
+
+  // Strings point straight into the frame buffer, so the frame must outlive the message
+  const char* getString() {
+    uint32_t n = getVarint();
+    if (fail_ || (size_t)(end_ - p_) < n + 1 || p_[n] != 0) {
+      fail_ = true;
+      return "";
+    }
+    const char* s = (const char*)p_;
+    p_ += n + 1;
+    return s;
+  }
+
+  template <typename T>
+  void getList(MsgList<T>& list) {
+    uint16_t count = (getByte() << 8) | getByte();
+    uint16_t bytes = (getByte() << 8) | getByte();
+    if (fail_ || (size_t)(end_ - p_) < bytes) {
+      fail_ = true;
+      list = MsgList<T>();
+      return;
+    }
+    list = MsgList<T>::fromBinary(p_, bytes, count);
+    p_ += bytes;
+  }
+
+  // Raw bytes, e.g. a nested message; nullptr if fewer than n are left
+  const uint8_t* getBytes(size_t n) {
+    if (fail_ || (size_t)(end_ - p_) < n) {
+      fail_ = true;
+      return nullptr;
+    }
+    const uint8_t* bytes = p_;
+    p_ += n;
+    return bytes;
+  }
+
+  size_t remaining() const { return end_ - p_; }
+  bool ok() const { return !fail_; }
+
+ private:
+  const uint8_t* p_;
+  const uint8_t* end_;
+  bool fail_;
+};
+
+// Read-only view over a repeated field. Items are decoded one at a time while
+// iterating, whether they come from a JSON array, a binary frame or a plain array.
+template <typename T>
+class MsgList {
+ public:
+  MsgList() : kind_(LIST_EMPTY), items_(nullptr), bin_(nullptr), binLen_(0), count_(0) {}
+
+  static MsgList fromArray(const T* items, size_t count) {
+    MsgList list;
+    list.kind_ = LIST_ARRAY;
+    list.items_ = items;
+    list.count_ = count;
+    return list;
+  }
+
+  static MsgList fromJson(JsonArrayConst arr) {
+    MsgList list;
+    if (arr.isNull()) return list;
+    list.kind_ = LIST_JSON;
+    list.json_ = arr;
+    list.count_ = arr.size();
+    return list;
+  }
+
+  static MsgList fromBinary(const uint8_t* data, size_t len, size_t count) {
+    MsgList list;
+    list.kind_ = LIST_BINARY;
+    list.bin_ = data;
+    list.binLen_ = len;
+    list.count_ = count;
+    return list;
+  }
+
+  size_t size() const { return count_; }
+  bool empty() const { return count_ == 0; }
+  bool isPresent() const { return kind_ != LIST_EMPTY; }
+
+  class iterator {
+   public:
+    const T& operator*() const { return current_; }
+    const T* operator->() const { return &current_; }
+    bool operator!=(const iterator& other) const { return index_ != other.index_; }
+
+    iterator& operator++() {
+      index_++;
+      load();
+      return *this;
+    }
+
+   private:
+    friend class MsgList;
+
+    iterator(const MsgList* list, size_t index)
+        : list_(list), index_(index), json_(list->json_.begin()),
+          reader_(list->bin_, list->binLen_) {
+      load();
+    }
+
+    void load() {
+      if (index_ >= list_->count_) return;
+      switch (list_->kind_) {
+        case LIST_ARRAY:
+          current_ = list_->items_[index_];
+          break;
+        case LIST_JSON:
+          if (index_ > 0) ++json_;
+          decodeMsg((*json_).template as<JsonObjectConst>(), current_);
+          break;
+        case LIST_BINARY:
+          if (!decodeMsg(reader_, current_)) index_ = list_->count_;
+          break;
+        default:
+          break;
+      }
+    }
+
+    const MsgList* list_;
+    size_t index_;
+    JsonArrayConst::iterator json_;
+    BinReader reader_;
+    T current_;
+  };
+
+  iterator begin() const { return iterator(this, 0); }
+  iterator end() const { return iterator(this, count_); }
+
+ private:
+  enum Kind { LIST_EMPTY, LIST_ARRAY, LIST_JSON, LIST_BINARY };
+
+  Kind kind_;
+  const T* items_;
+  JsonArrayConst json_;
+  const uint8_t* bin_;
+  size_t binLen_;
+  size_t count_;
+};
+
+// Content hash of a record, message or list (see MsgHash)
+template <typename T>
+uint32_t msgHash(const T& value) {
+  MsgHash h;
+  hashMsg(value, h);
+  return h.value();
+}
+
+template <typename T>
+uint32_t msgHash(const MsgList<T>& list) {
+  MsgHash h;
+  h.add((uint32_t)list.size());
+  for (const T& item : list) {
+    hashMsg(item, h);
+  }
+  return h.value();
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+// Interned medicine names. Model records hold a 1-byte NameId instead of the
+// text, so each distinct name is stored once and comparing names is comparing
+// ids. Ids stay valid while any record refers to them.
+//
+// When the table runs out of ids or text space it asks the firmware which ids
+// are still in use (markLiveNames(), below), frees the rest and repacks the
+// text pool.
+
+#include <Arduino.h>
+
+typedef uint8_t NameId;
+
+#define NAME_NONE       0     // empty name
+#define NAME_TABLE_SIZE 64    // ids 1..63
+#define NAME_POOL_SIZE  1024  // bytes of name text, including terminators
+#define NAME_MAX_LEN    32    // longer names are truncated
+
+NameId internName(const char* name);  // NAME_NONE for empty names or when full
+const char* nameText(NameId id);      // "" for NAME_NONE
+void compactNames();                  // free unreferenced names now
+uint8_t nameCount();                  // names currently held
+
+// Write / restore the table through the open snapshot (snapshot.h)
+void nameTableSave();
+bool nameTableLoad();
+
+// Implemented by the firmware: call nameMark() for every NameId in the model
+void markLiveNames();
+void nameMark(NameId id);
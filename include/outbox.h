@@ -0,0 +1,48 @@
+#pragma once
+
+// Persistent outbox for user responses to the minder (confirmation_response,
+// quantity_confirmed, jam_cleared). Each one gets a sequence number and the
+// clock time it was made, is kept on LittleFS in its binary form, and is sent
+// oldest first whenever the link is up.
+//
+// With LINK_FEAT_OUTBOX_ACK agreed the head stays until the minder returns
+// outbox_ack with its seq, and is resent every OUTBOX_RETRY_MS until then; the
+// minder drops seqs it has already applied. Without it each entry is sent once
+// the link is up and then removed.
+//
+// File: "OBX1" [next seq u32][count u8] then count entries.
+
+#include <Arduino.h>
+#include "messages.h"
+#include "day_time.h"
+
+#define OUTBOX_FILE      "/outbox.bin"
+#define OUTBOX_TEMP_FILE "/outbox.tmp"
+#define OUTBOX_SLOTS     16
+#define OUTBOX_PAYLOAD   27    // binary message, seq and queued_at included
+#define OUTBOX_RETRY_MS  5000
+
+void outboxBegin();
+
+// Stores an already-encoded message under seq; false if it did not fit
+bool outboxAdd(uint32_t seq, const uint8_t* payload, size_t len);
+uint32_t outboxTakeSeq();
+
+// Stamps msg with the next seq and the time, then queues it
+template <typename T>
+bool outboxSend(T msg, DayMinute minute) {
+  char queuedAt[6] = "";
+  if (minute != MINUTE_NONE) formatDayMinute(minute, queuedAt);
+  msg.seq = outboxTakeSeq();
+  msg.queued_at = queuedAt;
+
+  uint8_t payload[OUTBOX_PAYLOAD];
+  BinWriter out(payload, sizeof(payload));
+  encodeMsg(msg, out);
+  return out.ok() && outboxAdd(msg.seq, payload, out.length());
+}
+
+// Sends what is due; call every loop with whether the minder is reachable
+void outboxPoll(bool linkUp);
+void outboxAck(uint32_t seq);
+int outboxDepth();
@@ -0,0 +1,58 @@
+#pragma once
+
+// Temperature and humidity history in three fixed rings: one sample per minute
+// for 6 hours, per hour for 7 days and per day for 90 days. Every reading is
+// folded into the open sample of each tier (average, low, high), so a short
+// excursion still shows in the day tier's extremes.
+//
+// Sample i of a tier covers minute / hour / day i since boot; minutes without
+// readings are stored as gaps. Values are kept in tenths (23.5 C -> 235).
+//
+// sensorHistoryDownsample() reduces a window to one point per bucket with
+// Largest-Triangle-Three-Buckets. Buckets are fixed ranges of samples, so a
+// new reading only moves the last two points and charts can be redrawn from
+// there.
+
+#include <Arduino.h>
+
+#define SENSOR_GAP INT16_MIN  // avg of a sample with no readings
+
+enum SensorTier : uint8_t {
+  TIER_MINUTE,
+  TIER_HOUR,
+  TIER_DAY,
+  TIER_COUNT
+};
+
+struct SensorStat {
+  int16_t avg;
+  int16_t lo;
+  int16_t hi;
+};
+
+struct SensorSample {
+  SensorStat temperature;
+  SensorStat humidity;
+};
+
+struct ChartPoint {
+  uint16_t offset;  // samples after the window's first
+  uint8_t bucket;
+  int16_t value;    // the chosen sample's average
+  int16_t lo;       // extremes of the whole bucket
+  int16_t hi;
+};
+
+void sensorHistoryAdd(float temperature, float humidity, unsigned long nowMs);
+
+uint16_t sensorHistoryCapacity(SensorTier tier);
+uint32_t sensorHistoryEnd(SensorTier tier);  // one past the open sample, 0 if empty
+uint32_t sensorHistoryVersion();             // bumped by every reading
+
+// False for gaps and for samples already overwritten
+bool sensorHistoryGet(SensorTier tier, uint32_t index, SensorSample& sample);
+
+// Samples first..first+span-1 of one series into at most `buckets` points,
+// oldest first; empty buckets give no point
+int sensorHistoryDownsample(SensorTier tier, bool humidity, uint32_t first, uint16_t span,
+                            int buckets, ChartPoint* out);
@@ -0,0 +1,32 @@
+#pragma once
+
+// Binary snapshot of the synced model on LittleFS, loaded at boot so the
+// screens have data before the minder re-sends anything.
+//
+// File: "SNP1" [version u16][layout u32] body... [body length u32][crc32 u32]
+// The body is whatever the savers put, in order; readers get it back in the
+// same order. A file with another version or layout key, or a bad CRC, is
+// ignored. Saving writes a temp file and renames it over the old one, so a
+// reset mid-write keeps the previous snapshot.
+
+#include <Arduino.h>
+
+#define SNAPSHOT_FILE        "/model.snap"
+#define SNAPSHOT_TEMP_FILE   "/model.tmp"
+#define SNAPSHOT_VERSION     1
+#define SNAPSHOT_QUIET_MS    2000   // save once updates stop for this long
+#define SNAPSHOT_MAX_WAIT_MS 10000  // ...or this long after the first change
+
+// Writing: begin, put the sections, end
+bool snapshotBegin(uint32_t layout);
+void snapshotPut(const void* data, size_t len);
+bool snapshotEnd();
+
+// Reading: open validates the whole file first; get fails past the end
+bool snapshotOpen(uint32_t layout);
+bool snapshotGet(void* data, size_t len);
+void snapshotClose();
+
+// Debounced saving: mark after every model change, save when due
+void snapshotMarkDirty();
+bool snapshotDue();
@@ -0,0 +1,25 @@
+#pragma once
+
+// Daily timers on a two-level wheel: 60 minute slots for the current hour and
+// 24 hour slots for the rest of the day. Each tick fires one minute slot, and
+// once an hour the next hour's slot is spread over the minute slots, so the
+// cost per tick does not depend on how many timers exist. Timers repeat every
+// day; after firing they go back to their hour slot for tomorrow.
+//
+// Timer nodes live in the model arena (SEG_TIMERS). Time is a DayMinute from
+// the display's clock.
+
+#include <Arduino.h>
+#include "day_time.h"
+
+#define TIMER_MAX_CATCHUP 5  // minutes replayed after a stall; bigger jumps don't fire
+
+typedef void (*TimerFire)(uint16_t tag, DayMinute minute);
+
+void timerWheelClear();                          // drop every timer
+bool timerAdd(DayMinute minute, uint16_t tag);   // false if the budget is full
+size_t timerCount();
+
+// Moves the wheel to now, firing what came due since the last call. The first
+// call, and any clock jump over TIMER_MAX_CATCHUP, only sets the position.
+void timerWheelAdvance(DayMinute now, TimerFire fire);
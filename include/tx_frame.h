@@ -0,0 +1,45 @@
+#pragma once
+
+// Outbound path to the minder. Messages are serialized straight into one static
+// TX frame - no JsonDocument, no String. Until the handshake (link.h) agrees on
+// binary, messages go out as JSON lines; after that as binary payloads in the
+// same 0x7E 0x7E framing the minder uses towards the display.
+
+#include <Arduino.h>
+#include "messages.h"
+#include "link.h"
+#include "log.h"
+
+#define TX_FRAME_SIZE 320
+#define TX_FRAME_HEADER 4   // 0x7E 0x7E length hi/lo
+#define TX_FRAME_TRAILER 2  // checksum, 0x00
+
+extern HardwareSerial SerialPort;
+extern char txFrame[TX_FRAME_SIZE];
+
+// Adds framing around the payload already in txFrame + TX_FRAME_HEADER and sends it
+void sendTxFrame(size_t payloadLen);
+
+// Send a typed message (see schema/messages.json) to the minder
+template <typename T>
+void sendToMinder(const T& msg) {
+  static_assert(T::MAX_JSON_LEN > 0, "outbound messages need a size bound (max_len on strings, no lists)");
+  static_assert(T::MAX_JSON_LEN + 2 <= TX_FRAME_SIZE, "TX_FRAME_SIZE too small for this message");
+
+  if (linkCaps.encodings & LINK_ENC_BINARY) {
+    // Strings are not cut to max_len in binary, so a long one can overflow
+    // the frame; the message then goes out as JSON, which does cut them
+    BinWriter out((uint8_t*)txFrame + TX_FRAME_HEADER, sizeof(txFrame) - TX_FRAME_HEADER - TX_FRAME_TRAILER);
+    encodeMsg(msg, out);
+    if (out.ok() && out.length() <= linkCaps.maxFrame) {
+      sendTxFrame(out.length());
+      return;
+    }
+    LOG_WARN("TX: message %d does not fit a binary frame, sent as JSON", (int)T::TYPE);
+  }
+
+  JsonWriter out(txFrame, sizeof(txFrame));
+  writeJson(msg, out);
+  out.raw("\r\n");
+  SerialPort.write((const uint8_t*)txFrame, out.length());
+}
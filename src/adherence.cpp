@@ -0,0 +1,217 @@
+#include "adherence.h"
+#include "snapshot.h"
+#include "log.h"
+
+#define SLOTS (ADHERENCE_MEDICINES + 1)
+
+// Per-day counts of one medicine slot
+struct DayCounts {
+  uint8_t taken;
+  uint8_t late;
+  uint8_t missed;
+};
+
+// A dose seen today, for replacing its outcome
+struct TodayDose {
+  uint32_t key;  // doseKey(), 0 for a free entry
+  uint8_t slot;
+  uint8_t outcome;
+};
+
+// Everything is one block so it is saved and restored in one piece
+struct AdherenceState {
+  uint32_t day;  // days counted since the first start
+  DayMinute lastMinute;
+  NameId medicines[ADHERENCE_MEDICINES];
+  DayCounts days[ADHERENCE_DAYS][SLOTS];  // ring by day % ADHERENCE_DAYS
+  AdherenceCounts dayTotal[ADHERENCE_DAYS];
+  AdherenceCounts week[SLOTS];
+  AdherenceCounts month[SLOTS];
+  AdherenceCounts weekTotal;
+  AdherenceCounts monthTotal;
+  TodayDose today[ADHERENCE_TODAY_MAX];  // open addressing on key
+};
+
+static AdherenceState state;
+static uint32_t version = 0;
+
+static void add(AdherenceCounts& counts, DoseOutcome outcome, int delta) {
+  if (outcome == DOSE_TAKEN) counts.taken += delta;
+  if (outcome == DOSE_LATE) counts.late += delta;
+  if (outcome == DOSE_MISSED) counts.missed += delta;
+}
+
+static void add(DayCounts& counts, DoseOutcome outcome, int delta) {
+  if (outcome == DOSE_TAKEN) counts.taken += delta;
+  if (outcome == DOSE_LATE) counts.late += delta;
+  if (outcome == DOSE_MISSED) counts.missed += delta;
+}
+
+// One outcome in or out of today's bucket and every window holding today
+static void count(uint8_t slot, DoseOutcome outcome, int delta) {
+  add(state.days[state.day % ADHERENCE_DAYS][slot], outcome, delta);
+  add(state.dayTotal[state.day % ADHERENCE_DAYS], outcome, delta);
+  add(state.week[slot], outcome, delta);
+  add(state.month[slot], outcome, delta);
+  add(state.weekTotal, outcome, delta);
+  add(state.monthTotal, outcome, delta);
+}
+
+static bool empty(const AdherenceCounts& counts) {
+  return counts.taken == 0 && counts.late == 0 && counts.missed == 0;
+}
+
+// The medicine's slot; a new medicine takes a slot idle for 30 days
+static uint8_t slotFor(NameId medicine) {
+  if (medicine == NAME_NONE) return ADHERENCE_OTHER;
+  for (uint8_t i = 0; i < ADHERENCE_MEDICINES; i++) {
+    if (state.medicines[i] == medicine) return i;
+  }
+  for (uint8_t i = 0; i < ADHERENCE_MEDICINES; i++) {
+    if (state.medicines[i] == NAME_NONE || empty(state.month[i])) {
+      state.medicines[i] = medicine;
+      return i;
+    }
+  }
+  return ADHERENCE_OTHER;
+}
+
+// Never 0, so an all-zero state is valid and empty
+static uint32_t doseKey(int reminderId, DayMinute time) {
+  return (uint32_t)(reminderId & 0xFFFF) << 16 | (time + 1);
+}
+
+static TodayDose* findToday(uint32_t key, bool insert) {
+  uint32_t start = (key * 2654435761u) % ADHERENCE_TODAY_MAX;
+  for (uint32_t n = 0; n < ADHERENCE_TODAY_MAX; n++) {
+    TodayDose& dose = state.today[(start + n) % ADHERENCE_TODAY_MAX];
+    if (dose.key == key) return &dose;
+    if (dose.key == 0) {
+      if (!insert) return nullptr;
+      dose.key = key;
+      dose.outcome = DOSE_NONE;
+      return &dose;
+    }
+  }
+  return nullptr;
+}
+
+void adherenceReset() {
+  memset(&state, 0, sizeof(state));
+  state.lastMinute = MINUTE_NONE;
+  version++;
+}
+
+void adherenceRecord(int reminderId, DayMinute time, NameId medicine, DoseOutcome outcome) {
+  TodayDose* dose = findToday(doseKey(reminderId, time), true);
+  if (!dose) {
+    LOG_WARN("Adherence: more than %d doses today, reminder %d not counted", ADHERENCE_TODAY_MAX, reminderId);
+    return;
+  }
+
+  // Taken stays taken: a repeated "completed" must not turn into late later
+  DoseOutcome old = (DoseOutcome)dose->outcome;
+  if (old == outcome || (old != DOSE_MISSED && old != DOSE_NONE && outcome != DOSE_MISSED)) return;
+
+  if (old == DOSE_NONE) {
+    dose->slot = slotFor(medicine);
+  } else {
+    count(dose->slot, old, -1);
+  }
+  dose->outcome = outcome;
+  count(dose->slot, outcome, 1);
+  version++;
+}
+
+DoseOutcome adherenceOutcome(int reminderId, DayMinute time) {
+  TodayDose* dose = findToday(doseKey(reminderId, time), false);
+  return dose ? (DoseOutcome)dose->outcome : DOSE_NONE;
+}
+
+bool adherenceDayEnded(DayMinute now) {
+  if (now == MINUTE_NONE) return false;
+  DayMinute last = state.lastMinute;
+  if (last == MINUTE_NONE || now >= last || last - now <= MINUTES_PER_DAY / 2) {
+    state.lastMinute = now;
+    return false;
+  }
+  return true;
+}
+
+void adherenceRollDay() {
+  state.day++;
+  uint32_t entering = state.day % ADHERENCE_DAYS;        // also the day leaving the month
+  uint32_t leavingWeek = (state.day + ADHERENCE_DAYS - ADHERENCE_WEEK) % ADHERENCE_DAYS;
+
+  for (int slot = 0; slot < SLOTS; slot++) {
+    const DayCounts& old = state.days[entering][slot];
+    state.month[slot].taken -= old.taken;
+    state.month[slot].late -= old.late;
+    state.month[slot].missed -= old.missed;
+    const DayCounts& week = state.days[leavingWeek][slot];
+    state.week[slot].taken -= week.taken;
+    state.week[slot].late -= week.late;
+    state.week[slot].missed -= week.missed;
+  }
+  const AdherenceCounts& oldTotal = state.dayTotal[entering];
+  state.monthTotal.taken -= oldTotal.taken;
+  state.monthTotal.late -= oldTotal.late;
+  state.monthTotal.missed -= oldTotal.missed;
+  const AdherenceCounts& weekTotal = state.dayTotal[leavingWeek];
+  state.weekTotal.taken -= weekTotal.taken;
+  state.weekTotal.late -= weekTotal.late;
+  state.weekTotal.missed -= weekTotal.missed;
+
+  memset(state.days[entering], 0, sizeof(state.days[entering]));
+  memset(&state.dayTotal[entering], 0, sizeof(state.dayTotal[entering]));
+  memset(state.today, 0, sizeof(state.today));
+  state.lastMinute = MINUTE_NONE;
+  version++;
+}
+
+const AdherenceCounts& adherenceTotal(bool month) {
+  return month ? state.monthTotal : state.weekTotal;
+}
+
+NameId adherenceMedicine(int slot) {
+  return slot < ADHERENCE_MEDICINES ? state.medicines[slot] : NAME_NONE;
+}
+
+const AdherenceCounts& adherenceForMedicine(int slot, bool month) {
+  return month ? state.month[slot] : state.week[slot];
+}
+
+const AdherenceCounts& adherenceDay(int daysAgo) {
+  return state.dayTotal[(state.day + ADHERENCE_DAYS - daysAgo) % ADHERENCE_DAYS];
+}
+
+int adherencePercent(const AdherenceCounts& counts) {
+  int doses = counts.taken + counts.late + counts.missed;
+  if (doses == 0) return -1;
+  return (counts.taken + counts.late) * 100 / doses;
+}
+
+uint32_t adherenceVersion() {
+  return version;
+}
+
+void adherenceSave() {
+  snapshotPut(&state, sizeof(state));
+}
+
+bool adherenceLoad() {
+  if (!snapshotGet(&state, sizeof(state))) {
+    adherenceReset();
+    return false;
+  }
+  version++;
+  return true;
+}
+
+size_t adherenceStateSize() {
+  return sizeof(AdherenceState);
+}
+
+void adherenceMarkNames() {
+  for (int i = 0; i < ADHERENCE_MEDICINES; i++) nameMark(state.medicines[i]);
+}
@@ -0,0 +1,59 @@
+#include "alloc_count.h"
+
+#ifdef ALLOC_COUNT
+
+static volatile uint32_t allocations = 0;
+static TaskHandle_t countedTask = nullptr;  // Other tasks (log drain, WiFi) are ignored
+
+static inline void countAllocation() {
+  if (countedTask && xTaskGetCurrentTaskHandle() == countedTask) allocations++;
+}
+
+// new, String and ArduinoJson all end up in these
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+
+void* __wrap_malloc(size_t size) {
+  countAllocation();
+  return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+  countAllocation();
+  return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+  countAllocation();
+  return __real_realloc(ptr, size);
+}
+}
+
+void allocCountBegin() {
+  countedTask = xTaskGetCurrentTaskHandle();
+}
+
+uint32_t allocCount() {
+  return allocations;
+}
+
+bool allocCountEnabled() {
+  return true;
+}
+
+#else
+
+void allocCountBegin() {
+}
+
+uint32_t allocCount() {
+  return 0;
+}
+
+bool allocCountEnabled() {
+  return false;
+}
+
+#endif
@@ -0,0 +1,351 @@
+#include "band_compositor.h"
+#include "log.h"
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+
+// A sprite that takes 565 colours at 4 bits: drawing calls get the nearest
+// palette index. Only the outermost call maps, since the sprite's own
+// drawing calls back into these with the index.
+class BandSprite : public TFT_eSprite {
+ public:
+  explicit BandSprite(TFT_eSPI* tft) : TFT_eSprite(tft) {}
+  using TFT_eSprite::drawChar;
+
+  bool palettized = false;
+
+  void drawPixel(int32_t x, int32_t y, uint32_t color) override {
+    uint32_t c = ink(color);
+    depth++;
+    TFT_eSprite::drawPixel(x, y, c);
+    depth--;
+  }
+
+  void drawChar(int32_t x, int32_t y, uint16_t ch, uint32_t color, uint32_t bg, uint8_t size) override {
+    uint32_t c = ink(color);
+    uint32_t b = ink(bg);
+    depth++;
+    TFT_eSprite::drawChar(x, y, ch, c, b, size);
+    depth--;
+  }
+
+  void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) override {
+    uint32_t c = ink(color);
+    depth++;
+    TFT_eSprite::drawLine(x0, y0, x1, y1, c);
+    depth--;
+  }
+
+  void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) override {
+    uint32_t c = ink(color);
+    depth++;
+    TFT_eSprite::drawFastVLine(x, y, h, c);
+    depth--;
+  }
+
+  void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) override {
+    uint32_t c = ink(color);
+    depth++;
+    TFT_eSprite::drawFastHLine(x, y, w, c);
+    depth--;
+  }
+
+  void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) override {
+    uint32_t c = ink(color);
+    depth++;
+    TFT_eSprite::fillRect(x, y, w, h, c);
+    depth--;
+  }
+
+  // A run of a static layer, already a palette index
+  void drawRun(int32_t x, int32_t y, int32_t w, uint8_t index);
+
+ private:
+  int depth = 0;
+
+  uint32_t ink(uint32_t color);
+};
+
+#define BAND_BUFFERS 2
+
+static BandSprite* bands[BAND_BUFFERS];
+static int bandCount = 0;
+static int nextBand = 0;
+static int bandRows = 0;
+static uint8_t bandBits = 0;
+static int screenWidth = 0;
+static int screenHeight = 0;
+static uint16_t palette[16];
+static uint8_t paletteSize = 0;
+
+// Last lookup, as a screen draws runs of the same colour
+static uint32_t lastColor = 0xFFFFFFFF;
+static uint8_t lastIndex = 0;
+
+static uint8_t paletteIndex(uint32_t color) {
+  if (color == lastColor) return lastIndex;
+
+  // Nearest by RGB distance, green has 6 bits so red and blue count double
+  int r = (color >> 11) & 0x1F;
+  int g = (color >> 5) & 0x3F;
+  int b = color & 0x1F;
+  uint8_t best = 0;
+  int32_t bestDistance = INT32_MAX;
+  for (uint8_t i = 0; i < paletteSize; i++) {
+    int dr = (r - ((palette[i] >> 11) & 0x1F)) * 2;
+    int dg = g - ((palette[i] >> 5) & 0x3F);
+    int db = (b - (palette[i] & 0x1F)) * 2;
+    int32_t distance = dr * dr + dg * dg + db * db;
+    if (distance < bestDistance) {
+      bestDistance = distance;
+      best = i;
+      if (distance == 0) break;
+    }
+  }
+  lastColor = color;
+  lastIndex = best;
+  return best;
+}
+
+uint32_t BandSprite::ink(uint32_t color) {
+  return palettized && depth == 0 ? paletteIndex(color) : color;
+}
+
+void BandSprite::drawRun(int32_t x, int32_t y, int32_t w, uint8_t index) {
+  depth++;
+  TFT_eSprite::drawFastHLine(x, y, w, palettized ? index : palette[index]);
+  depth--;
+}
+
+// ==================== STATIC LAYERS ====================
+// A layer is a row table (screenHeight + 1 offsets into its runs) followed
+// by the runs, each palette index << 12 | (length - 1).
+
+#define RUN_MAX 4096
+
+struct LayerSlot {
+  uint32_t start;  // in pool
+  bool cached;
+  bool tooBig;     // does not fit even in an empty pool
+};
+
+static uint16_t pool[BAND_LAYER_POOL / 2];
+static uint32_t poolUsed = 0;
+static LayerSlot layers[BAND_LAYERS];
+
+void bandDropLayers() {
+  memset(layers, 0, sizeof(layers));
+  poolUsed = 0;
+}
+
+size_t bandLayerBytes() {
+  return poolUsed * sizeof(uint16_t);
+}
+
+// Paints the chrome band by band and stores it as runs; false if it does
+// not fit in what is left of the pool
+static bool encodeLayer(uint8_t layer, uint16_t background, BandPaint chrome) {
+  uint32_t start = poolUsed;
+  uint32_t end = start + screenHeight + 1;
+  if (end > sizeof(pool) / sizeof(pool[0])) return false;
+  uint16_t* rowStart = pool + start;
+  uint32_t runs = 0;
+
+  BandSprite* band = bands[0];
+  for (int top = 0; top < screenHeight; top += bandRows) {
+    int rows = min(bandRows, screenHeight - top);
+    band->setViewport(0, -top, screenWidth, screenHeight, true);
+    band->fillRect(0, top, screenWidth, rows, background);
+    chrome(*band);
+    band->resetViewport();
+
+    for (int r = 0; r < rows; r++) {
+      rowStart[top + r] = runs;
+      int x = 0;
+      while (x < screenWidth) {
+        uint16_t color = band->readPixel(x, r);
+        int len = 1;
+        while (x + len < screenWidth && len < RUN_MAX && band->readPixel(x + len, r) == color) len++;
+        if (end + runs >= sizeof(pool) / sizeof(pool[0]) || runs == 0xFFFF) return false;
+        pool[end + runs++] = (uint16_t)paletteIndex(color) << 12 | (len - 1);
+        x += len;
+      }
+    }
+  }
+  rowStart[screenHeight] = runs;
+  layers[layer].start = start;
+  layers[layer].cached = true;
+  poolUsed = end + runs;
+  return true;
+}
+
+static bool buildLayer(uint8_t layer, uint16_t background, BandPaint chrome) {
+  if (layers[layer].tooBig) return false;
+  bandWait();  // the build uses a band itself
+  if (encodeLayer(layer, background, chrome)) return true;
+
+  // Full: start over with only this layer
+  bool hadOthers = poolUsed > 0;
+  bandDropLayers();
+  if (hadOthers && encodeLayer(layer, background, chrome)) {
+    LOG_DEBUG("Band: layer pool full, dropped the other layers");
+    return true;
+  }
+  LOG_WARN("Band: static layer %d does not fit in %u bytes, painting it every time",
+           layer, (unsigned)sizeof(pool));
+  layers[layer].tooBig = true;
+  return false;
+}
+
+// Copies the layer's rows top.. into the band, columns x..x+w only
+static void drawLayer(BandSprite* band, uint8_t layer, int x, int w, int top, int rows) {
+  const uint16_t* rowStart = pool + layers[layer].start;
+  const uint16_t* runs = rowStart + screenHeight + 1;
+  for (int row = top; row < top + rows; row++) {
+    int col = 0;
+    for (uint16_t i = rowStart[row]; i < rowStart[row + 1] && col < x + w; i++) {
+      int len = (runs[i] & 0x0FFF) + 1;
+      int from = max(col, x);
+      int to = min(col + len, x + w);
+      if (to > from) band->drawRun(from, row, to - from, runs[i] >> 12);
+      col += len;
+    }
+  }
+}
+
+// A finished band for the push task
+struct BandPush {
+  BandSprite* sprite;
+  int16_t x;
+  int16_t y;
+  int16_t w;
+  int16_t rows;
+};
+
+static QueueHandle_t pushQueue = nullptr;
+static SemaphoreHandle_t freeBands = nullptr;  // bands not queued or being pushed
+
+static void bandPushTask(void*) {
+  BandPush push;
+  for (;;) {
+    if (xQueueReceive(pushQueue, &push, portMAX_DELAY) != pdTRUE) continue;
+    push.sprite->pushSprite(push.x, push.y, push.x, 0, push.w, push.rows);
+    xSemaphoreGive(freeBands);
+  }
+}
+
+static void startPushTask() {
+  if (pushQueue) return;
+  pushQueue = xQueueCreate(1, sizeof(BandPush));
+  freeBands = xSemaphoreCreateCounting(BAND_BUFFERS, BAND_BUFFERS);
+  // Above the log drain and journal on the core not running loop(): the
+  // loop may be waiting for a band
+  xTaskCreatePinnedToCore(bandPushTask, "band", 3072, nullptr, tskIDLE_PRIORITY + 2, nullptr, 0);
+}
+
+bool bandBegin(TFT_eSPI& tft, int height, uint8_t bits, const uint16_t* colors, uint8_t count,
+               bool pingPong) {
+  bandEnd();
+  if (bits != 4 && bits != 8) bits = 8;
+  if (height < 1) height = 1;
+  if (height > tft.height()) height = tft.height();
+
+  int wanted = pingPong ? BAND_BUFFERS : 1;
+  size_t bytes = (size_t)tft.width() * height * bits / 8 * wanted;
+  if (bytes > BAND_MAX_BYTES) {
+    LOG_WARN("Band: %d x %d rows at %d bits need %u bytes (max %u), drawing directly",
+             wanted, height, bits, (unsigned)bytes, (unsigned)BAND_MAX_BYTES);
+    return false;
+  }
+
+  // Static layers are kept in palette colours at either depth
+  if (!colors) count = 0;
+  paletteSize = count > 16 ? 16 : count;
+  memcpy(palette, colors, paletteSize * sizeof(uint16_t));
+  lastColor = 0xFFFFFFFF;
+  bandDropLayers();
+  for (bandCount = 0; bandCount < wanted; bandCount++) {
+    BandSprite* band = new BandSprite(&tft);
+    band->setColorDepth(bits);
+    if (!band->createSprite(tft.width(), height)) {
+      LOG_WARN("Band: no memory for %u bytes, drawing directly", (unsigned)bytes);
+      delete band;
+      bandEnd();
+      return false;
+    }
+    if (bits == 4) {
+      band->createPalette(palette, paletteSize);
+      band->palettized = true;
+    }
+    bands[bandCount] = band;
+  }
+  if (bandCount > 1) startPushTask();
+  nextBand = 0;
+  bandRows = height;
+  bandBits = bits;
+  screenWidth = tft.width();
+  screenHeight = tft.height();
+  return true;
+}
+
+void bandEnd() {
+  bandWait();
+  for (int i = 0; i < bandCount; i++) {
+    bands[i]->deleteSprite();
+    delete bands[i];
+  }
+  bandCount = 0;
+  bandRows = 0;
+}
+
+bool bandActive() {
+  return bandCount > 0;
+}
+
+size_t bandBytes() {
+  return (size_t)screenWidth * bandRows * bandBits / 8 * bandCount;
+}
+
+bool bandBusy() {
+  return bandCount > 1 && uxSemaphoreGetCount(freeBands) < BAND_BUFFERS;
+}
+
+void bandWait() {
+  if (bandCount < 2) return;
+  // Holding every band means every push has finished
+  for (int i = 0; i < BAND_BUFFERS; i++) xSemaphoreTake(freeBands, portMAX_DELAY);
+  for (int i = 0; i < BAND_BUFFERS; i++) xSemaphoreGive(freeBands);
+}
+
+void bandCompose(int x, int y, int w, int h, uint16_t background, BandPaint chrome, BandPaint fields,
+                 uint8_t layer) {
+  if (!bandCount) return;
+  bool layered = chrome && layer < BAND_LAYERS && paletteSize > 0 &&
+                 (layers[layer].cached || buildLayer(layer, background, chrome));
+  for (int top = y; top < y + h; top += bandRows) {
+    int rows = min(bandRows, y + h - top);
+
+    // Pushes finish in order, so a free band is the one used two bands ago
+    if (bandCount > 1) xSemaphoreTake(freeBands, portMAX_DELAY);
+    BandSprite* band = bands[nextBand];
+    nextBand = (nextBand + 1) % bandCount;
+
+    // The band shows screen rows top.. in screen coordinates; drawing
+    // outside it is clipped
+    band->setViewport(0, -top, screenWidth, screenHeight, true);
+    if (layered) {
+      drawLayer(band, layer, x, w, top, rows);
+    } else {
+      band->fillRect(x, top, w, rows, background);
+      if (chrome) chrome(*band);
+    }
+    if (fields) fields(*band);
+    band->resetViewport();
+
+    if (bandCount > 1) {
+      BandPush push = {band, (int16_t)x, (int16_t)top, (int16_t)w, (int16_t)rows};
+      xQueueSend(pushQueue, &push, portMAX_DELAY);
+    } else {
+      band->pushSprite(x, top, x, 0, w, rows);
+    }
+  }
+}
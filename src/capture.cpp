@@ -0,0 +1,159 @@
+#include "capture.h"
+#include <LittleFS.h>
+#include "log.h"
+
+static CaptureMode captureMode = CAPTURE_OFF;
+static File captureFile;
+static uint32_t captureBytes = 0;
+static bool replaying = false;
+
+struct FrameTiming {
+  uint32_t frames;
+  uint32_t bytes;
+  uint64_t parseTotal;
+  uint64_t renderTotal;
+  uint32_t parseMax;
+  uint32_t renderMax;
+};
+
+static FrameTiming timing;
+
+bool captureBegin(CaptureMode mode) {
+  captureEnd();
+  if (mode == CAPTURE_FLASH) {
+    if (!LittleFS.begin(true)) {
+      LOG_ERROR("Capture: LittleFS mount failed");
+      return false;
+    }
+    captureFile = LittleFS.open(CAPTURE_FILE, "w");
+    if (!captureFile) {
+      LOG_ERROR("Capture: cannot create %s", CAPTURE_FILE);
+      return false;
+    }
+    captureFile.write((const uint8_t*)"CAP1", 4);
+    captureBytes = 4;
+  }
+  captureMode = mode;
+  LOG_INFO("Capture started (%s)", mode == CAPTURE_FLASH ? CAPTURE_FILE : "serial");
+  return true;
+}
+
+void captureEnd() {
+  if (captureMode == CAPTURE_FLASH) {
+    captureFile.close();
+    LOG_INFO("Capture stopped, %lu bytes", (unsigned long)captureBytes);
+  }
+  captureMode = CAPTURE_OFF;
+}
+
+void captureFrame(const char* data, size_t len) {
+  uint32_t now = millis();
+
+  if (captureMode == CAPTURE_SERIAL) {
+    // One write per line so log output cannot land in the middle of it
+    static char line[2 * FRAME_MAX_DATA + 24];
+    static const char hex[] = "0123456789abcdef";
+    int n = snprintf(line, sizeof(line), "CAP %lu ", (unsigned long)now);
+    for (size_t i = 0; i < len; i++) {
+      line[n++] = hex[(uint8_t)data[i] >> 4];
+      line[n++] = hex[data[i] & 0x0F];
+    }
+    line[n++] = '\n';
+    Serial.write((const uint8_t*)line, n);
+  } else if (captureMode == CAPTURE_FLASH) {
+    if (captureBytes + 6 + len > CAPTURE_MAX_BYTES) {
+      LOG_WARN("Capture: size limit reached");
+      captureEnd();
+      return;
+    }
+    uint8_t hdr[6] = {
+      (uint8_t)now, (uint8_t)(now >> 8), (uint8_t)(now >> 16), (uint8_t)(now >> 24),
+      (uint8_t)len, (uint8_t)(len >> 8)
+    };
+    captureFile.write(hdr, sizeof(hdr));
+    captureFile.write((const uint8_t*)data, len);
+    captureFile.flush();
+    captureBytes += sizeof(hdr) + len;
+  }
+}
+
+bool frameTimingActive() {
+  return captureMode != CAPTURE_OFF || replaying;
+}
+
+void frameTimingAdd(size_t len, uint32_t parseUs, uint32_t renderUs) {
+  timing.frames++;
+  timing.bytes += len;
+  timing.parseTotal += parseUs;
+  timing.renderTotal += renderUs;
+  if (parseUs > timing.parseMax) timing.parseMax = parseUs;
+  if (renderUs > timing.renderMax) timing.renderMax = renderUs;
+  LOG_DEBUG("Frame %u bytes: parse %lu us, render %lu us", (unsigned)len,
+            (unsigned long)parseUs, (unsigned long)renderUs);
+}
+
+void frameTimingReset() {
+  memset(&timing, 0, sizeof(timing));
+}
+
+void frameTimingReport() {
+  if (timing.frames == 0) {
+    LOG_INFO("Frame timing: no frames");
+    return;
+  }
+  LOG_INFO("Frame timing: %lu frames, %lu bytes", (unsigned long)timing.frames, (unsigned long)timing.bytes);
+  LOG_INFO("  parse  avg %lu us, max %lu us", (unsigned long)(timing.parseTotal / timing.frames),
+           (unsigned long)timing.parseMax);
+  LOG_INFO("  render avg %lu us, max %lu us", (unsigned long)(timing.renderTotal / timing.frames),
+           (unsigned long)timing.renderMax);
+}
+
+bool replayCapture(FrameDecoder& decoder, float speed) {
+  if (!LittleFS.begin(false)) {
+    LOG_ERROR("Replay: LittleFS mount failed");
+    return false;
+  }
+  File f = LittleFS.open(CAPTURE_FILE, "r");
+  char magic[4];
+  if (!f || f.read((uint8_t*)magic, 4) != 4 || memcmp(magic, "CAP1", 4) != 0) {
+    LOG_ERROR("Replay: no capture in %s", CAPTURE_FILE);
+    return false;
+  }
+
+  // Replayed frames must not be captured again
+  CaptureMode savedMode = captureMode;
+  captureMode = CAPTURE_OFF;
+  frameTimingReset();
+  replaying = true;
+
+  static char frame[FRAME_MAX_DATA];
+  uint8_t hdr[6];
+  uint32_t firstMs = 0;
+  unsigned long start = millis();
+  bool first = true;
+
+  while (f.read(hdr, sizeof(hdr)) == sizeof(hdr)) {
+    uint32_t ms = hdr[0] | (hdr[1] << 8) | ((uint32_t)hdr[2] << 16) | ((uint32_t)hdr[3] << 24);
+    size_t len = hdr[4] | (hdr[5] << 8);
+    if (len == 0 || len > FRAME_MAX_DATA || f.read((uint8_t*)frame, len) != len) {
+      LOG_WARN("Replay: truncated capture");
+      break;
+    }
+    if (first) {
+      firstMs = ms;
+      first = false;
+    }
+    if (speed > 0) {
+      long wait = (long)(start + (unsigned long)((ms - firstMs) / speed)) - (long)millis();
+      if (wait > 0) delay(wait);
+    }
+    decoder.feedFrame(frame, len);
+  }
+  f.close();
+
+  replaying = false;
+  captureMode = savedMode;
+  LOG_INFO("Replay done in %lu ms", (unsigned long)(millis() - start));
+  frameTimingReport();
+  return true;
+}
@@ -0,0 +1,33 @@
+#include "day_time.h"
+
+// Reads 1-2 digits; -1 if there are none
+static int readNumber(const char*& p) {
+  if (!isdigit((unsigned char)*p)) return -1;
+  int value = *p++ - '0';
+  if (isdigit((unsigned char)*p)) value = value * 10 + (*p++ - '0');
+  return value;
+}
+
+DayMinute parseDayMinute(const char* text) {
+  if (!text) return MINUTE_NONE;
+  const char* p = text;
+  int hours = readNumber(p);
+  if (hours < 0 || hours > 23 || *p++ != ':') return MINUTE_NONE;
+  int minutes = readNumber(p);
+  if (minutes < 0 || minutes > 59) return MINUTE_NONE;
+  if (*p != '\0' && *p != ':') return MINUTE_NONE;  // seconds are ignored
+  return hours * 60 + minutes;
+}
+
+void formatDayMinute(DayMinute minute, char* out) {
+  if (minute >= MINUTES_PER_DAY) {
+    strcpy(out, "--:--");
+    return;
+  }
+  out[0] = '0' + minute / 600;
+  out[1] = '0' + minute / 60 % 10;
+  out[2] = ':';
+  out[3] = '0' + minute % 60 / 10;
+  out[4] = '0' + minute % 10;
+  out[5] = '\0';
+}
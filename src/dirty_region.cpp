@@ -0,0 +1,121 @@
+#include "dirty_region.h"
+
+struct DirtyRect {
+  int16_t x;
+  int16_t y;
+  int16_t w;
+  int16_t h;
+};
+
+static DirtyRect rects[DIRTY_MAX_RECTS];
+static int rectCount = 0;
+static int screenWidth = 0;
+static int screenHeight = 0;
+static uint32_t pixelsPainted = 0;
+
+static int32_t area(const DirtyRect& r) {
+  return (int32_t)r.w * r.h;
+}
+
+// Overlapping or sharing an edge
+static bool touches(const DirtyRect& a, const DirtyRect& b) {
+  return a.x <= b.x + b.w && b.x <= a.x + a.w && a.y <= b.y + b.h && b.y <= a.y + a.h;
+}
+
+static DirtyRect unite(const DirtyRect& a, const DirtyRect& b) {
+  DirtyRect r;
+  r.x = min(a.x, b.x);
+  r.y = min(a.y, b.y);
+  r.w = max(a.x + a.w, b.x + b.w) - r.x;
+  r.h = max(a.y + a.h, b.y + b.h) - r.y;
+  return r;
+}
+
+void dirtyBegin(int width, int height) {
+  screenWidth = width;
+  screenHeight = height;
+  rectCount = 0;
+}
+
+static void add(DirtyRect r) {
+  // Absorb everything it touches; the union may touch more, so start over
+  for (int i = 0; i < rectCount;) {
+    if (touches(rects[i], r)) {
+      r = unite(rects[i], r);
+      rects[i] = rects[--rectCount];
+      i = 0;
+    } else {
+      i++;
+    }
+  }
+
+  if (rectCount == DIRTY_MAX_RECTS) {
+    // Full: merge with the rectangle that adds the least undirty area
+    int best = 0;
+    int32_t bestGrowth = INT32_MAX;
+    for (int i = 0; i < rectCount; i++) {
+      int32_t growth = area(unite(rects[i], r)) - area(rects[i]) - area(r);
+      if (growth < bestGrowth) {
+        bestGrowth = growth;
+        best = i;
+      }
+    }
+    r = unite(rects[best], r);
+    rects[best] = rects[--rectCount];
+    add(r);
+    return;
+  }
+  rects[rectCount++] = r;
+}
+
+void dirtyInvalidate(int x, int y, int w, int h) {
+  // Clip to the screen
+  if (x < 0) {
+    w += x;
+    x = 0;
+  }
+  if (y < 0) {
+    h += y;
+    y = 0;
+  }
+  if (x + w > screenWidth) w = screenWidth - x;
+  if (y + h > screenHeight) h = screenHeight - y;
+  if (w <= 0 || h <= 0) return;
+
+  DirtyRect r = {(int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h};
+  add(r);
+}
+
+void dirtyInvalidateAll() {
+  rectCount = 0;
+  dirtyInvalidate(0, 0, screenWidth, screenHeight);
+}
+
+int dirtyRectCount() {
+  return rectCount;
+}
+
+int dirtyRepaint(TFT_eSPI& tft, uint16_t background, RegionPaint chrome, RegionPaint fields, uint8_t layer) {
+  int painted = rectCount;
+  for (int i = 0; i < rectCount; i++) {
+    const DirtyRect& r = rects[i];
+    if (bandActive()) {
+      bandCompose(r.x, r.y, r.w, r.h, background, chrome, fields, layer);
+    } else {
+      // Screen coordinates stay as they are (vpDatum false), drawing is clipped
+      tft.setViewport(r.x, r.y, r.w, r.h, false);
+      tft.fillRect(r.x, r.y, r.w, r.h, background);
+      if (chrome) chrome(tft);
+      if (fields) fields(tft);
+      tft.resetViewport();
+    }
+    pixelsPainted += area(r);
+  }
+  bandWait();
+  rectCount = 0;
+  return painted;
+}
+
+uint32_t dirtyPixelsPainted() {
+  return pixelsPainted;
+}
@@ -0,0 +1,79 @@
+#include "frame.h"
+#include "log.h"
+
+FrameDecoder::FrameDecoder(FrameHandler onFrame)
+    : onFrame_(onFrame), state_(SYNC1), length_(0), count_(0), checksum_(0), checksumErrors_(0) {}
+
+void FrameDecoder::feed(uint8_t b) {
+  switch (state_) {
+    case SYNC1:
+      if (b == FRAME_SYNC) {
+        state_ = SYNC2;
+      }
+      break;
+
+    case SYNC2:
+      if (b == FRAME_SYNC) {
+        state_ = LENGTH_HIGH;
+      } else {
+        state_ = SYNC1;
+      }
+      break;
+
+    case LENGTH_HIGH:
+      length_ = b << 8;
+      state_ = LENGTH_LOW;
+      break;
+
+    case LENGTH_LOW:
+      length_ |= b;
+      if (length_ > 0 && length_ <= FRAME_MAX_DATA) {
+        count_ = 0;
+        checksum_ = 0;
+        state_ = DATA;
+      } else {
+        state_ = SYNC1;
+      }
+      break;
+
+    case DATA:
+      buffer_[count_++] = b;
+      checksum_ ^= b;
+      if (count_ >= length_) {
+        state_ = CHECKSUM;
+      }
+      break;
+
+    case CHECKSUM:
+      if (b == checksum_) {
+        state_ = END;
+      } else {
+        checksumErrors_++;
+        LOG_WARN("Checksum error");
+        state_ = SYNC1;
+      }
+      break;
+
+    case END:
+      if (b == 0x00) {
+        buffer_[count_] = '\0';
+        onFrame_(buffer_, count_);
+      }
+      state_ = SYNC1;
+      break;
+  }
+}
+
+void FrameDecoder::feedFrame(const char* data, size_t len) {
+  uint8_t checksum = 0;
+  feed(FRAME_SYNC);
+  feed(FRAME_SYNC);
+  feed(len >> 8);
+  feed(len & 0xFF);
+  for (size_t i = 0; i < len; i++) {
+    feed((uint8_t)data[i]);
+    checksum ^= (uint8_t)data[i];
+  }
+  feed(checksum);
+  feed(0x00);
+}
@@ -0,0 +1,250 @@
+#include "journal.h"
+#include <esp_partition.h>
+#include "log.h"
+
+#define JOURNAL_SECTOR 4096
+#define JOURNAL_HEADER 16
+#define JOURNAL_SLOTS  ((JOURNAL_SECTOR - JOURNAL_HEADER) / sizeof(JournalEvent))
+#define JOURNAL_MAGIC  0x314C4E4A  // "JNL1"
+#define EPOCH_NONE     0xFFFFFFFF
+
+static const esp_partition_t* journalPart = nullptr;
+static uint32_t sectorCount = 0;
+
+// Records flushedEnd..appendEnd are queued in RAM, older ones are in flash.
+// Both indexes only grow; the queue slot of record i is i % JOURNAL_QUEUE.
+static JournalEvent queue[JOURNAL_QUEUE];
+static uint32_t appendEnd = 0;
+static uint32_t flushedEnd = 0;
+static unsigned long oldestQueuedAt = 0;
+static uint32_t dropped = 0;
+static portMUX_TYPE journalMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Only touched by the flush task
+static uint32_t startedEpoch = EPOCH_NONE;  // sector header written
+static uint32_t erasedEpoch = EPOCH_NONE;   // erased ahead, header not yet written
+
+static uint8_t crc8(const uint8_t* data, size_t len) {
+  uint8_t crc = 0;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+  }
+  return crc;
+}
+
+static bool validEvent(const JournalEvent& event) {
+  return event.type >= JOURNAL_DISPENSE && event.type <= JOURNAL_LOCAL_ALERT &&
+         event.crc == crc8((const uint8_t*)&event, sizeof(event) - 1);
+}
+
+static bool erasedEvent(const JournalEvent& event) {
+  const uint8_t* p = (const uint8_t*)&event;
+  for (size_t i = 0; i < sizeof(event); i++) {
+    if (p[i] != 0xFF) return false;
+  }
+  return true;
+}
+
+static uint32_t sectorOffset(uint32_t epoch) {
+  return (epoch % sectorCount) * JOURNAL_SECTOR;
+}
+
+static uint32_t recordOffset(uint32_t index) {
+  return sectorOffset(index / JOURNAL_SLOTS) + JOURNAL_HEADER + (index % JOURNAL_SLOTS) * sizeof(JournalEvent);
+}
+
+static bool readHeader(uint32_t sector, uint32_t& epoch) {
+  uint32_t header[2];
+  if (esp_partition_read(journalPart, sector * JOURNAL_SECTOR, header, sizeof(header)) != ESP_OK) return false;
+  epoch = header[1];
+  return header[0] == JOURNAL_MAGIC && epoch != EPOCH_NONE;
+}
+
+bool journalBegin() {
+  appendEnd = flushedEnd = 0;
+  startedEpoch = erasedEpoch = EPOCH_NONE;
+  journalPart = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, JOURNAL_PARTITION);
+  if (!journalPart || journalPart->size / JOURNAL_SECTOR < 3) {
+    LOG_WARN("Journal: no \"%s\" partition, events are not kept", JOURNAL_PARTITION);
+    journalPart = nullptr;
+    return false;
+  }
+  sectorCount = journalPart->size / JOURNAL_SECTOR;
+
+  // Newest sector = highest epoch that sits where it belongs
+  bool found = false;
+  uint32_t newest = 0;
+  for (uint32_t sector = 0; sector < sectorCount; sector++) {
+    uint32_t epoch;
+    if (readHeader(sector, epoch) && epoch % sectorCount == sector && (!found || epoch > newest)) {
+      newest = epoch;
+      found = true;
+    }
+  }
+  if (!found) {
+    LOG_INFO("Journal: empty, %u sectors", (unsigned)sectorCount);
+    return true;
+  }
+
+  // Records are written in slot order, so the erased slots are a suffix;
+  // a torn record is not erased and keeps its slot
+  uint32_t lo = 0;
+  uint32_t hi = JOURNAL_SLOTS;
+  while (lo < hi) {
+    uint32_t mid = (lo + hi) / 2;
+    JournalEvent event;
+    esp_partition_read(journalPart, recordOffset(newest * JOURNAL_SLOTS + mid), &event, sizeof(event));
+    if (erasedEvent(event)) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  appendEnd = flushedEnd = newest * JOURNAL_SLOTS + lo;
+  startedEpoch = newest;
+  LOG_INFO("Journal: %u sectors, next record #%u", (unsigned)sectorCount, (unsigned)appendEnd);
+  return true;
+}
+
+static void journalTask(void*) {
+  for (;;) {
+    if (!journalService()) vTaskDelay(pdMS_TO_TICKS(100));
+  }
+}
+
+void journalStartTask() {
+  if (!journalPart) return;
+  // Same core and priority as the log drain: flash work only uses idle time
+  xTaskCreatePinnedToCore(journalTask, "journal", 3072, nullptr, tskIDLE_PRIORITY + 1, nullptr, 0);
+}
+
+void journalAppend(JournalType type, uint8_t container, int16_t value, DayMinute minute) {
+  if (!journalPart) return;
+
+  JournalEvent event;
+  event.minute = minute;
+  event.type = type;
+  event.container = container;
+  event.value = value;
+  event.reserved = 0xFF;
+  event.crc = crc8((const uint8_t*)&event, sizeof(event) - 1);
+  unsigned long now = millis();
+
+  portENTER_CRITICAL(&journalMux);
+  if (appendEnd - flushedEnd >= JOURNAL_QUEUE) {
+    dropped++;
+  } else {
+    if (appendEnd == flushedEnd) oldestQueuedAt = now;
+    queue[appendEnd % JOURNAL_QUEUE] = event;
+    appendEnd++;
+  }
+  portEXIT_CRITICAL(&journalMux);
+}
+
+uint32_t journalDropped() {
+  return dropped;
+}
+
+// Erases the epoch's sector unless that was done ahead, then writes its header
+static void startSector(uint32_t epoch) {
+  if (erasedEpoch != epoch) {
+    esp_partition_erase_range(journalPart, sectorOffset(epoch), JOURNAL_SECTOR);
+  }
+  uint32_t header[2] = {JOURNAL_MAGIC, epoch};
+  esp_partition_write(journalPart, sectorOffset(epoch), header, sizeof(header));
+  startedEpoch = epoch;
+  erasedEpoch = EPOCH_NONE;
+}
+
+bool journalService() {
+  if (!journalPart) return false;
+
+  unsigned long now = millis();
+  portENTER_CRITICAL(&journalMux);
+  uint32_t first = flushedEnd;
+  uint32_t pending = appendEnd - flushedEnd;
+  unsigned long age = now - oldestQueuedAt;
+  portEXIT_CRITICAL(&journalMux);
+
+  // Batch: wait for half a queue or for the oldest record to age
+  if (pending < JOURNAL_QUEUE / 2 && (pending == 0 || age < JOURNAL_FLUSH_MS)) {
+    // Meanwhile erase the next sector, so rolling over is only a header write
+    if (startedEpoch != EPOCH_NONE && erasedEpoch != startedEpoch + 1) {
+      esp_partition_erase_range(journalPart, sectorOffset(startedEpoch + 1), JOURNAL_SECTOR);
+      erasedEpoch = startedEpoch + 1;
+      return true;
+    }
+    return false;
+  }
+
+  uint32_t epoch = first / JOURNAL_SLOTS;
+  if (epoch != startedEpoch) {
+    startSector(epoch);
+    return true;
+  }
+
+  // One write for the batch, up to the end of the sector
+  uint32_t count = pending;
+  if (count > JOURNAL_SLOTS - first % JOURNAL_SLOTS) count = JOURNAL_SLOTS - first % JOURNAL_SLOTS;
+  JournalEvent batch[JOURNAL_QUEUE];
+  portENTER_CRITICAL(&journalMux);
+  for (uint32_t i = 0; i < count; i++) batch[i] = queue[(first + i) % JOURNAL_QUEUE];
+  portEXIT_CRITICAL(&journalMux);
+
+  if (esp_partition_write(journalPart, recordOffset(first), batch, count * sizeof(JournalEvent)) != ESP_OK) {
+    LOG_ERROR("Journal: flash write failed at #%u", (unsigned)first);
+  }
+  portENTER_CRITICAL(&journalMux);
+  flushedEnd += count;
+  oldestQueuedAt = now;
+  portEXIT_CRITICAL(&journalMux);
+  return true;
+}
+
+uint32_t journalEnd() {
+  portENTER_CRITICAL(&journalMux);
+  uint32_t end = appendEnd;
+  portEXIT_CRITICAL(&journalMux);
+  return end;
+}
+
+bool journalPrev(uint32_t& cursor, JournalEvent& event) {
+  if (!journalPart) return false;
+
+  while (cursor > 0) {
+    uint32_t index = --cursor;
+
+    bool queued = false;
+    portENTER_CRITICAL(&journalMux);
+    if (index >= flushedEnd && index < appendEnd) {
+      event = queue[index % JOURNAL_QUEUE];
+      queued = true;
+    }
+    portEXIT_CRITICAL(&journalMux);
+    if (queued) return true;
+
+    // The sector must still hold this epoch, otherwise older records are gone
+    uint32_t epoch;
+    if (!readHeader((index / JOURNAL_SLOTS) % sectorCount, epoch) || epoch != index / JOURNAL_SLOTS) {
+      cursor = 0;
+      return false;
+    }
+    esp_partition_read(journalPart, recordOffset(index), &event, sizeof(event));
+    if (validEvent(event)) return true;
+    // Torn record: skip it
+  }
+  return false;
+}
+
+const char* journalTypeName(uint8_t type) {
+  switch (type) {
+    case JOURNAL_DISPENSE: return "Dispensed";
+    case JOURNAL_CONFIRM: return "Confirmed";
+    case JOURNAL_CANCEL: return "Cancelled";
+    case JOURNAL_TIMEOUT: return "Timed out";
+    case JOURNAL_JAM: return "Jam";
+    case JOURNAL_LOCAL_ALERT: return "Local alert";
+    default: return "?";
+  }
+}
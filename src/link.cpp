@@ -0,0 +1,114 @@
+#include "link.h"
+#include "frame.h"
+#include "log.h"
+#include "tx_frame.h"
+
+static const LinkCaps LEGACY_CAPS = { 0, FRAME_MAX_DATA, LINK_ENC_JSON, 0, LINK_LEGACY_BAUD };
+static const LinkCaps LOCAL_CAPS = {
+  LINK_PROTO_VERSION, FRAME_MAX_DATA, LINK_ENC_JSON | LINK_ENC_BINARY,
+  LINK_FEAT_BATCH | LINK_FEAT_OFFLINE_REMINDERS | LINK_FEAT_OUTBOX_ACK, LINK_MAX_BAUD
+};
+
+LinkCaps linkCaps = LEGACY_CAPS;
+
+static bool helloPending = false;
+static bool helloSlow = false;  // fast retries used up, still legacy
+static int helloAttempts = 0;
+static unsigned long lastHelloTime = 0;
+
+static uint32_t windowErrors = 0;  // checksum errors when the window started
+static unsigned long windowStart = 0;
+
+static void sendHello() {
+  HelloMsg hello;
+  hello.proto_version = LOCAL_CAPS.version;
+  hello.max_frame = LOCAL_CAPS.maxFrame;
+  hello.encodings = LOCAL_CAPS.encodings;
+  hello.features = LOCAL_CAPS.features;
+  hello.max_baud = LOCAL_CAPS.baud;
+  sendToMinder(hello);
+
+  helloAttempts++;
+  lastHelloTime = millis();
+}
+
+static void setBaud(uint32_t baud) {
+  if (baud == linkCaps.baud) return;
+  SerialPort.flush();
+  SerialPort.updateBaudRate(baud);
+}
+
+void linkBegin() {
+  // Hello always goes out as a legacy JSON line so an old minder can ignore it
+  setBaud(LEGACY_CAPS.baud);
+  linkCaps = LEGACY_CAPS;
+  helloPending = true;
+  helloSlow = false;
+  helloAttempts = 0;
+  sendHello();
+}
+
+// True once the link needs a new handshake
+static bool linkLost(bool minderSilent, uint32_t checksumErrors) {
+  if (millis() - windowStart >= LINK_ERROR_WINDOW_MS) {
+    windowStart = millis();
+    windowErrors = checksumErrors;
+  }
+  if (linkCaps.version == 0) return false;
+
+  if (minderSilent) {
+    LOG_WARN("Link: minder silent, renegotiating at %u baud", (unsigned)LINK_LEGACY_BAUD);
+    return true;
+  }
+  if (checksumErrors - windowErrors >= LINK_RESYNC_ERRORS) {
+    LOG_WARN("Link: %u checksum errors, renegotiating at %u baud", (unsigned)(checksumErrors - windowErrors),
+             (unsigned)LINK_LEGACY_BAUD);
+    windowErrors = checksumErrors;
+    return true;
+  }
+  return false;
+}
+
+void linkPoll(bool minderSilent, uint32_t checksumErrors) {
+  if (linkLost(minderSilent, checksumErrors)) {
+    linkBegin();
+    return;
+  }
+  if (!helloPending) return;
+
+  unsigned long waited = millis() - lastHelloTime;
+  if (!helloSlow && helloAttempts >= LINK_HELLO_RETRIES && waited >= LINK_HELLO_INTERVAL_MS) {
+    helloSlow = true;
+    LOG_WARN("Link: no hello_ack from minder, legacy mode until it answers");
+  }
+  if (waited < (helloSlow ? LINK_HELLO_SLOW_MS : LINK_HELLO_INTERVAL_MS)) return;
+  sendHello();
+}
+
+void linkAccept(const HelloAckMsg& peer) {
+  helloPending = false;
+  if (peer.proto_version == 0) {
+    LOG_WARN("Link: minder sent hello_ack without a version, staying in legacy mode");
+    return;
+  }
+
+  LinkCaps common;
+  common.version = min(LOCAL_CAPS.version, peer.proto_version);
+  common.maxFrame = min(LOCAL_CAPS.maxFrame, peer.max_frame);
+  common.encodings = (LOCAL_CAPS.encodings & peer.encodings) | LINK_ENC_JSON;
+  common.features = LOCAL_CAPS.features & peer.features;
+  common.baud = max((uint32_t)LINK_LEGACY_BAUD, min(LOCAL_CAPS.baud, peer.max_baud));
+
+  // The minder switches baud right after sending hello_ack
+  setBaud(common.baud);
+  linkCaps = common;
+  windowStart = millis() - LINK_ERROR_WINDOW_MS;  // count errors from the new baud on
+
+  LOG_INFO("Link: v%u, frame %u, encodings 0x%02x, features 0x%02x, %u baud",
+           (unsigned)common.version, (unsigned)common.maxFrame, (unsigned)common.encodings,
+           (unsigned)common.features, (unsigned)common.baud);
+}
+
+bool linkSettled() {
+  return !helloPending || helloSlow;
+}
@@ -0,0 +1,189 @@
+#include "log.h"
+
+// Ring buffer records: [ms u32][fmt ptr][level u8][arg length u8][args...]
+// head/tail only ever grow; the mask maps them into the buffer.
+
+#define LOG_DRAIN_IDLE_MS 20
+#define LOG_LINE_SIZE     192
+
+static_assert((LOG_BUFFER_SIZE & (LOG_BUFFER_SIZE - 1)) == 0, "LOG_BUFFER_SIZE must be a power of two");
+
+struct LogHeader {
+  uint32_t ms;
+  const char* fmt;
+  uint8_t level;
+  uint8_t argLen;
+};
+
+static uint8_t logRing[LOG_BUFFER_SIZE];
+static uint32_t logHead = 0;  // next byte to write
+static uint32_t logTail = 0;  // next byte to read
+static uint32_t logDropped = 0;
+static uint32_t logDroppedReported = 0;
+static portMUX_TYPE logMux = portMUX_INITIALIZER_UNLOCKED;
+
+static void ringWrite(uint32_t pos, const void* src, size_t n) {
+  const uint8_t* p = (const uint8_t*)src;
+  for (size_t i = 0; i < n; i++) logRing[(pos + i) & (LOG_BUFFER_SIZE - 1)] = p[i];
+}
+
+static void ringRead(uint32_t pos, void* dst, size_t n) {
+  uint8_t* p = (uint8_t*)dst;
+  for (size_t i = 0; i < n; i++) p[i] = logRing[(pos + i) & (LOG_BUFFER_SIZE - 1)];
+}
+
+void logCommit(uint8_t level, const char* fmt, const LogArgs& args) {
+  LogHeader hdr;
+  hdr.ms = millis();
+  hdr.fmt = fmt;
+  hdr.level = level;
+  hdr.argLen = args.length();
+  size_t total = sizeof(hdr) + hdr.argLen;
+
+  portENTER_CRITICAL(&logMux);
+  if (LOG_BUFFER_SIZE - (logHead - logTail) < total) {
+    logDropped++;
+  } else {
+    ringWrite(logHead, &hdr, sizeof(hdr));
+    ringWrite(logHead + sizeof(hdr), args.data(), hdr.argLen);
+    logHead += total;
+  }
+  portEXIT_CRITICAL(&logMux);
+}
+
+uint32_t logDroppedCount() {
+  return logDropped;
+}
+
+// Format one conversion ("%-5.2f" etc.) with a recorded argument. Length
+// modifiers are dropped since every integer was stored as 32 bits.
+static int formatArg(char* out, size_t size, const char* spec, size_t specLen,
+                     uint8_t tag, const uint8_t* arg) {
+  char fmt[16];
+  size_t n = 0;
+  for (size_t i = 0; i < specLen && n < sizeof(fmt) - 1; i++) {
+    char c = spec[i];
+    if (c == 'l' || c == 'h' || c == 'z' || c == 'j' || c == 't' || c == 'L') continue;
+    fmt[n++] = c;
+  }
+  fmt[n] = '\0';
+  char conv = fmt[n - 1];
+
+  switch (tag) {
+    case LOG_ARG_INT:
+    case LOG_ARG_UINT: {
+      uint32_t v;
+      memcpy(&v, arg, sizeof(v));
+      if (conv == 's') return snprintf(out, size, tag == LOG_ARG_INT ? "%d" : "%u", (int)v);
+      if (strchr("fFeEgGaA", conv)) return snprintf(out, size, fmt, tag == LOG_ARG_INT ? (double)(int32_t)v : (double)v);
+      return snprintf(out, size, fmt, v);
+    }
+    case LOG_ARG_DOUBLE: {
+      double v;
+      memcpy(&v, arg, sizeof(v));
+      if (!strchr("fFeEgGaA", conv)) return snprintf(out, size, "%f", v);
+      return snprintf(out, size, fmt, v);
+    }
+    case LOG_ARG_STR: {
+      char s[LOG_MAX_STR + 1];
+      memcpy(s, arg + 1, arg[0]);
+      s[arg[0]] = '\0';
+      if (conv != 's') return snprintf(out, size, "%s", s);
+      return snprintf(out, size, fmt, s);
+    }
+  }
+  return 0;
+}
+
+static size_t argSize(uint8_t tag, const uint8_t* arg) {
+  switch (tag) {
+    case LOG_ARG_DOUBLE: return sizeof(double);
+    case LOG_ARG_STR: return 1 + arg[0];
+    default: return sizeof(uint32_t);
+  }
+}
+
+// Expand a record into line, following printf rules for the format string
+static size_t formatRecord(char* line, size_t size, const LogHeader& hdr, const uint8_t* args) {
+  static const char levelChar[] = "-EWID";
+  size_t len = snprintf(line, size, "[%lu.%03lu] %c ", (unsigned long)(hdr.ms / 1000),
+                        (unsigned long)(hdr.ms % 1000), levelChar[hdr.level < 5 ? hdr.level : 0]);
+  size_t pos = 0;
+
+  for (const char* f = hdr.fmt; *f && len < size - 1; f++) {
+    if (*f != '%') {
+      line[len++] = *f;
+      continue;
+    }
+    if (f[1] == '%') {
+      line[len++] = '%';
+      f++;
+      continue;
+    }
+    const char* spec = f;
+    while (f[1] && !strchr("diouxXcsfFeEgGaAp", f[1])) f++;
+    if (!f[1]) break;
+    f++;
+    if (pos >= hdr.argLen) {
+      // Dropped because the record was full
+      int n = snprintf(line + len, size - len, "<trunc>");
+      if (n > 0) len += (size_t)n < size - len ? n : size - len - 1;
+      continue;
+    }
+    uint8_t tag = args[pos];
+    int n = formatArg(line + len, size - len, spec, f - spec + 1, tag, args + pos + 1);
+    pos += 1 + argSize(tag, args + pos + 1);
+    if (n > 0) len += (size_t)n < size - len ? n : size - len - 1;
+  }
+
+  // Callers still pass the old println-style text, so end every record with one newline
+  while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r')) len--;
+  line[len++] = '\n';
+  return len;
+}
+
+// Pops one record and prints it; false when the ring is empty
+static bool drainOne() {
+  LogHeader hdr;
+  uint8_t args[LOG_MAX_ARGS];
+
+  portENTER_CRITICAL(&logMux);
+  bool empty = logHead == logTail;
+  if (!empty) {
+    ringRead(logTail, &hdr, sizeof(hdr));
+    ringRead(logTail + sizeof(hdr), args, hdr.argLen);
+    logTail += sizeof(hdr) + hdr.argLen;
+  }
+  uint32_t dropped = logDropped;
+  portEXIT_CRITICAL(&logMux);
+
+  char line[LOG_LINE_SIZE];
+  if (dropped != logDroppedReported) {
+    int n = snprintf(line, sizeof(line), "[log] %lu messages dropped\n",
+                     (unsigned long)(dropped - logDroppedReported));
+    Serial.write((const uint8_t*)line, n);
+    logDroppedReported = dropped;
+  }
+  if (empty) return false;
+
+  size_t len = formatRecord(line, sizeof(line) - 1, hdr, args);
+  Serial.write((const uint8_t*)line, len);
+  return true;
+}
+
+void logDrain() {
+  while (drainOne()) {
+  }
+}
+
+static void logDrainTask(void*) {
+  for (;;) {
+    if (!drainOne()) vTaskDelay(pdMS_TO_TICKS(LOG_DRAIN_IDLE_MS));
+  }
+}
+
+void logBegin() {
+  // Lowest application priority on the core not running loop(), so printing
+  // only ever uses idle time
+  xTaskCreatePinnedToCore(logDrainTask, "log", 3072, nullptr, tskIDLE_PRIORITY + 1, nullptr, 0);
+}
@@ -4,6 +4,26 @@
 #include <XPT2046_Touchscreen.h>
 #include <HardwareSerial.h>
 #include <ArduinoJson.h>
+#include "messages.h"
+#include "tx_frame.h"
+#include "log.h"
+#include "frame.h"
+#include "capture.h"
+#include "link.h"
+#include "fixed_string.h"
+#include "alloc_count.h"
+#include "name_table.h"
+#include "id_index.h"
+#include "model_arena.h"
+#include "snapshot.h"
+#include "day_time.h"
+#include "timer_wheel.h"
+#include "journal.h"
+#include "outbox.h"
+#include "sensor_history.h"
+#include "adherence.h"
+#include "dirty_region.h"
+#include "band_compositor.h"
 
 TFT_eSPI tft = TFT_eSPI();
 #define TOUCH_CS 15   // T_CS connected to GPIO 15
@@ -23,6 +43,8 @@ bool rtcTimeSet = false;
 
 // Serial communication with main ESP32
 HardwareSerial SerialPort(2); // Use UART2
+void handleFrame(const char* data, size_t len);
+FrameDecoder rxDecoder(handleFrame);
 
 // Display states
 enum DisplayState {
@@ -39,36 +61,47 @@ enum DisplayState {
   STATE_JAM_ALERT,
   STATE_WIFI_ERROR,
   STATE_CONTROL_QUEUE_LIST,
-  STATE_CONTROL_QUEUE_CONFIRMATION
+  STATE_CONTROL_QUEUE_CONFIRMATION,
+  STATE_HISTORY,
+  STATE_SENSOR_CHART,
+  STATE_ADHERENCE
 };
 
 DisplayState currentState = STATE_HOME;
 DisplayState previousState = STATE_HOME;
 
-// Data storage
+// Data storage - fixed-capacity strings so syncing never touches the heap;
+// longer values from the minder are truncated. Medicine names are interned
+// (name_table.h) and shared by every record that mentions them.
 struct Container {
   int id;
-  String medicine_name;
+  NameId medicine;
   int current_capacity;
   int max_capacity;
   bool low_stock;
+  bool dirty;  // changed by a point update, row not yet repainted
 };
 
 struct Reminder {
   int id;
-  String medicine_name;
+  NameId medicine;
   int container_id;
-  String schedule_type;
-  String times[5];  // Store up to 5 reminder times
-  int timeCount;    // Number of times for this reminder
+  FixedString<20> schedule_type;
+  uint16_t firstTime;  // index into reminderTimes
+  uint8_t timeCount;   // Number of times for this reminder
   bool active;
-  int dosage;
+};
+
+// One time of day a reminder fires, with the pills due then
+struct ReminderTime {
+  DayMinute time;
+  uint16_t dosage;
 };
 
 // Reminder item for confirmation
 struct ReminderItem {
   int id;
-  String medicine_name;
+  NameId medicine;
   int container_id;
   int dosage;
 };
@@ -76,17 +109,16 @@ struct ReminderItem {
 // Control action for confirmation
 struct ControlAction {
   int control_id;
-  String action;
-  String medicine_name;
+  FixedString<16> action;
+  NameId medicine;
   int container_id;
   int quantity;
-  String message;
+  FixedString<64> message;
 };
 
 // Pending confirmation state
 struct PendingConfirmation {
-  ReminderItem reminders[10];
-  int reminder_count;
+  ArenaList<ReminderItem> reminders{SEG_CONFIRMATION};
   ControlAction control;
   int type; // 0=medication, 1=device_control
   int timeout_seconds;
@@ -94,41 +126,53 @@ struct PendingConfirmation {
 };
 
 struct DailySchedule {
-  String time;
-  String medicine_name;
+  DayMinute time;
+  NameId medicine;
   int dosage;
-  String status;
+  int reminder_id;  // with time, identifies the row for schedule_item_status
+  FixedString<12> status;
 };
 
-// Data arrays
-Container containers[10];
-Reminder reminders[20];
-DailySchedule dailySchedule[24]; // 24 hours
+// Data arrays - sized at sync time out of one shared budget (model_arena.h)
+ArenaList<Container> containers(SEG_CONTAINERS);
+ArenaList<Reminder> reminders(SEG_REMINDERS);
+ArenaList<ReminderTime> reminderTimes(SEG_REMINDER_TIMES);
+ArenaList<DailySchedule> dailySchedule(SEG_SCHEDULE);  // sorted by time
 
 //Dummy data
 // containers[0] = {1, "Paracetamol", 50, 100, false};
 
-int containerCount = 0;
-int reminderCount = 0;
-int scheduleCount = 0;
+// id -> array slot, rebuilt on every sync. Alerts edit a container in place
+// and mark just its row for repainting. Past the index capacity, lookups
+// fall back to a scan.
+IdIndex<64> containerIndex;
+IdIndex<128> reminderIndex;
+bool containerIndexFull = false;
+bool reminderIndexFull = false;
+
+// List screens show one page at a time; reset when the screen changes
+int listPage = 0;
+#define LIST_TOP    60   // first row
+#define LIST_BOTTOM 50   // pager strip below the rows
 
 // Device status
 bool wifiConnected = false;
 bool mqttConnected = false;
 bool timeSynced = false;
 bool alarmActive = false;
-String alarmType = "";
-String alarmMessage = "";
-String alarmTime = "";
+FixedString<20> alarmType;
+FixedString<64> alarmMessage;
+FixedString<8> alarmTime;
 
 // Dispensing status
 bool isDispensing = false;
 int dispensingContainer = 0;
 int dispensingDosage = 0;
 bool dispensingComplete = false;
-String dispensingMedicineName = "";
+NameId dispensingMedicine = NAME_NONE;
 unsigned long dispensingStartTime = 0;
 const unsigned long DISPENSING_TIMEOUT = 30000; // 30 seconds
+int dispensingAnimStep = 0;  // loading animation, 0..3 blocks
 
 // Sensor data
 float currentTemperature = 0.0;
@@ -148,19 +192,21 @@ const unsigned long CONFIRMATION_TIMEOUT = 60000; // 60 seconds
 
 // Jam alert state
 int jamAlertContainer = 0;
-String jamAlertMedicine = "";
+NameId jamAlertMedicine = NAME_NONE;
 int jamAlertPillsRemaining = 0;
 
 // WiFi error state
-String wifiErrorMessage = "";
-String wifiErrorInstruction = "";
+FixedString<64> wifiErrorMessage;
+FixedString<96> wifiErrorInstruction;
 
 // AP Mode state
 bool isInAPMode = false;
-String apModeMessage = "";
+FixedString<80> apModeMessage;
 
 // Clock display
-String currentTimeString = "--:--";
+FixedString<8> currentTimeString = "--:--";
+DayMinute clockMinute = MINUTE_NONE;  // parsed current_time, advanced with millis()
+unsigned long clockSetAt = 0;
 
 // ⭐ NEW: Hybrid Architecture - Operation Mode Tracking
 char operationMode[10] = "offline";  // "online" or "offline" - default offline until confirmed
@@ -169,9 +215,126 @@ char lastOperationMode[10] = "offline"; // Track mode changes
 int lastPendingActions = 0;          // Track sync progress
 
 // ⭐ NEW: Alert source tracking
-char alertSource[20] = "mqtt";       // "mqtt", "dailylog", or "reminder"
+char alertSource[20] = "mqtt";       // "mqtt", "dailylog", "reminder" or "display"
 char alertOperationMode[10] = "offline"; // Mode when alert triggered - default offline
 
+// Local reminders: the timer wheel fires cached reminders on the display's
+// clock. While the minder is talking it gets LOCAL_ALERT_GRACE_MS to alert
+// first; when it is silent the display alerts on its own and reports the
+// alerts once the minder is back. The two clocks only agree to the minute, so
+// a minder alert can also come before the display's timer fires; it is
+// remembered for LOCAL_ALERT_COVER_MIN and such timers are not armed.
+#define MINDER_SILENT_MS     120000  // no frames for this long = minder offline
+#define LOCAL_ALERT_GRACE_MS 120000
+#define LOCAL_ALERT_MAX      8
+#define LOCAL_ALERT_COVER_MIN 1
+
+struct LocalAlert {
+  bool used;
+  int reminderId;
+  NameId medicine;
+  DayMinute minute;
+  int dosage;
+  unsigned long dueAt;    // millis() when it shows, if still waiting
+  bool shown;
+  bool dismissed;
+};
+
+LocalAlert localAlerts[LOCAL_ALERT_MAX];
+int shownLocalAlert = -1;  // slot of the alert on screen, if it is a local one
+
+// Medicines the minder alerted for recently, by the display's minute
+struct MinderAlert {
+  NameId medicine;  // NAME_NONE: everything due
+  DayMinute minute;
+  unsigned long at;
+};
+
+MinderAlert minderAlerts[LOCAL_ALERT_MAX];
+int minderAlertCount = 0;
+int minderAlertNext = 0;
+unsigned long lastMinderFrameAt = 0;
+
+// Counts derived from the model, kept current by the code that changes it so
+// screens never rescan the lists. Listeners hear about each change once.
+struct ModelStats {
+  int activeContainers;    // containers with pills left
+  int lowStockContainers;
+  int activeReminders;
+  int pendingDoses;        // schedule items not completed yet
+};
+
+enum ModelChange : uint8_t {
+  CHANGE_CONTAINERS = 0x01,  // container list replaced
+  CHANGE_STOCK      = 0x02,  // pill count of one container
+  CHANGE_REMINDERS  = 0x04,
+  CHANGE_SCHEDULE   = 0x08,  // schedule replaced
+  CHANGE_DOSE       = 0x10   // status of one dose
+};
+
+typedef void (*ModelListener)(uint8_t changes);
+
+#define MODEL_LISTENER_MAX 6
+
+struct ModelSubscription {
+  uint8_t changes;
+  ModelListener listener;
+};
+
+ModelStats modelStats = {};
+ModelSubscription modelListeners[MODEL_LISTENER_MAX];
+int modelListenerCount = 0;
+
+// Set by listeners, cleared when the screen has been repainted
+bool containersScreenStale = true;
+bool containersHeaderStale = true;
+bool remindersScreenStale = true;
+bool scheduleScreenStale = true;
+
+// History screen: recent journal events, newest first
+#define HISTORY_MAX_ROWS 60
+bool historyScreenStale = true;
+uint32_t historyDrawnEnd = 0;  // journalEnd() when last drawn
+int historyCount = 0;          // rows found on the last draw
+
+// Sensor chart screen: one tier of the sensor history against the safe range
+#define CHART_X       40
+#define CHART_Y       60
+#define CHART_W       270
+#define CHART_H       300
+#define CHART_BUCKETS 90   // a point every 3 px
+SensorTier chartTier = TIER_MINUTE;
+bool chartHumidity = false;
+bool chartScreenStale = true;
+uint32_t chartDrawnVersion = 0;  // sensorHistoryVersion() when last drawn
+uint32_t chartDrawnFirst = 0;    // first sample of the drawn window
+ChartPoint chartPoints[CHART_BUCKETS];
+int chartPointCount = 0;
+
+// Heap allocations in the last updateDisplay(), in ALLOC_COUNT builds
+uint32_t frameAllocations = 0;
+bool frameAllocWarned = false;
+
+// Adherence screen: drawn from the running totals in adherence.h
+bool adherenceScreenStale = true;
+uint32_t adherenceDrawnVersion = 0;
+
+// Change detection: content hash of the last update applied to each block
+// (msgHash(), see messages.h). The minder re-sends unchanged data constantly.
+uint32_t containersHash = 0;
+uint32_t remindersHash = 0;
+uint32_t scheduleHash = 0;
+uint32_t systemStatusHash = 0;
+uint32_t sensorHash = 0;
+uint32_t redrawsAvoided = 0;         // Unchanged updates dropped before model/display
+
+// Batch frames: redraws requested while applying one are deferred to the end
+bool applyingBatch = false;
+bool redrawPending = false;
+// Status bar text from the batch, drawn over the repaint at its end
+FixedString<64> pendingBar;
+bool pendingBarError = false;
+
 // Colors
 #define BACKGROUND_COLOR 0x18E3
 #define TEXT_COLOR TFT_WHITE
@@ -180,20 +343,45 @@ char alertOperationMode[10] = "offline"; // Mode when alert triggered - default
 #define ALARM_COLOR TFT_RED
 #define SUCCESS_COLOR TFT_GREEN
 
+// Every colour the screens use, the palette of 4-bit bands (band_compositor.h)
+const uint16_t uiPalette[16] = {
+  BACKGROUND_COLOR, TFT_WHITE, HIGHLIGHT_COLOR, TFT_YELLOW, TFT_RED, TFT_GREEN, TFT_ORANGE, TFT_DARKGREY,
+  TFT_CYAN, TFT_DARKGREEN, TFT_DARKCYAN, TFT_BLACK, TFT_MAGENTA, 0x2104, TFT_BLUE, TFT_LIGHTGREY
+};
+
+// Static layer slots of the modal screens' chrome (band_compositor.h)
+enum ScreenLayer : uint8_t {
+  LAYER_ALARM,
+  LAYER_DISPENSING,
+  LAYER_DISPENSED,
+  LAYER_TAKE_MEDICINE,
+  LAYER_QUANTITY,
+  LAYER_CONTAINER_SELECTION,
+  LAYER_JAM,
+  LAYER_WIFI,
+  LAYER_CONTROL
+};
+
 // Button positions for navigation
 const int buttonWidth = 70;
 const int buttonHeight = 30;
 const int buttonMargin = 10;
 
 void showStartupScreen();
-void showStatusMessage(String message);
-void showErrorMessage(String error);
-void showReminderAlert(String medicineName, int containerId, int dosage, String alertType, String message, String timeStr);
-void showControlQueueResult(int queueId, bool success, String message);
-void syncContainers(JsonArray containersArray);
-void syncReminders(JsonArray remindersArray);
-void syncDailySchedule(JsonArray scheduleArray);
-void processIncomingData(String jsonData);
+void showStatusMessage(const char* message);
+void showErrorMessage(const char* error);
+void showReminderAlert(const char* medicineName, int containerId, int dosage, const char* alertType, const char* message, const char* timeStr);
+void showControlQueueResult(int queueId, bool success, const char* message);
+void syncContainers(const MsgList<ContainerRec>& containersList);
+void syncReminders(const MsgList<ReminderRec>& remindersList);
+void syncDailySchedule(const MsgList<ScheduleRec>& scheduleList);
+void processIncomingData(const char* data, size_t len);
+void processIncomingData(const String& jsonData);
+void redrawDataScreen();
+bool walkBatch(BinReader reader, bool apply);
+bool walkBatch(JsonArrayConst messages, bool apply);
+bool blockChanged(uint32_t& lastHash, uint32_t hash, const char* block);
+uint32_t sensorBlockHash(float temperature, float humidity);
 void updateDisplay();
 void handleTouchInput();
 void drawHomeScreen();
@@ -209,13 +397,77 @@ void handleAlarmTouch(int x, int y);
 int getActiveContainerCount();
 void handleScheduleTouch(int x, int y);
 void handleDispensingTouch(int x, int y);
-void drawContainerItem(int x, int y, Container container);
-void drawReminderItem(int x, int y, Reminder reminder);
-void drawButton(int x, int y, int w, int h, String label, uint16_t color);
+void drawContainerItem(int x, int y, const Container& container);
+Container* findContainer(int id);
+int containerSlot(int id, size_t count);
+int reminderSlot(int id, size_t count);
+const Reminder* findReminder(int id);
+void markContainerDirty(Container* container);
+void setContainerStock(Container* container, int capacity, bool lowStock);
+void modelSubscribe(uint8_t changes, ModelListener listener);
+void modelNotify(uint8_t changes);
+void recountContainers();
+void recountReminders();
+void recountSchedule();
+void subscribeScreens();
+void repaintDirtyRows();
+int containerRowY(int slot);
+void drawReminderItem(int x, int y, const Reminder& reminder);
+int rowsPerPage(int rowHeight);
+int pageStart(int total, int perPage);
+void drawPager(int total, int perPage);
+bool handlePagerTouch(int x, int y, int total, int perPage);
+void warnModelFull(const char* block, size_t kept, size_t received);
+void drawButton(int x, int y, int w, int h, const char* label, uint16_t color);
 int getActiveReminderCount();
-void drawScheduleItem(int x, int y, DailySchedule schedule);
+void drawScheduleItem(int x, int y, const DailySchedule& schedule);
+void drawScheduleStatus(int x, int y, const DailySchedule& schedule);
+void repaintScheduleRow(int slot);
+size_t scheduleLowerBound(DayMinute time);
+int findScheduleItem(int reminderId, DayMinute time);
+void benchScheduleStatusUpdate();
+void benchBandHeights();
+void benchStaticLayers();
+void drawHistoryScreen();
+void drawHistoryItem(int x, int y, const JournalEvent& event);
+void handleHistoryTouch(int x, int y);
+void journalConfirmation(JournalType type);
+void drawSensorChartScreen();
+void drawSensorChartFrame();
+void drawChartGuides(int fromX);
+void handleSensorChartTouch(int x, int y);
+void checkSensorChart();
+DoseOutcome takenOutcome(DayMinute time);
+void recordDoseStatus(const DailySchedule& item);
+void recordConfirmation(bool taken);
+int findDueDose(int reminderId, DayMinute now);
+void closeAdherenceDay();
+void drawAdherenceScreen();
+void drawAdherenceWindow(int y, const char* label, const AdherenceCounts& counts);
+uint16_t adherenceColor(int percent);
+void handleAdherenceTouch(int x, int y);
+void checkAdherence();
+int allocCheckScreenCount();
+uint32_t screenAllocations(int index);
 void syncTimeWithNTP();
 void generateDummyData();
+void sendDummyBatch();
+uint32_t syncAllocations();
+bool syncedNamesShared();
+bool loadModelSnapshot();
+void saveModelSnapshot();
+void rebuildIdIndexes();
+void sortScheduleByTime();
+void rebuildReminderTimers();
+void onReminderDue(uint16_t slot, DayMinute minute);
+void cancelLocalAlerts(NameId medicine);
+bool minderAlerted(NameId medicine, DayMinute minute);
+void pollLocalAlerts();
+bool minderOnline();
+DayMinute nowMinute();
+int findNextDose(DayMinute now);
+void formatNextDose(char* out, size_t size);
+void checkModelCapacity();
 void sendDummyDeviceInfo();
 void sendDummySystemStatus();
 void sendDummySensorData();
@@ -228,6 +480,26 @@ void sendDummyAlarmStatus(bool active);
 void sendDummyDispensingStatus(const char* status);
 void sendDummyStockAlert();
 void drawTakeMedicineConfirmation();
+void paintTakeMedicineConfirmation(TFT_eSPI& gfx);
+void paintQuantityConfirmation(TFT_eSPI& gfx);
+void paintContainerSelectionScreen(TFT_eSPI& gfx);
+void paintJamAlert(TFT_eSPI& gfx);
+void paintWiFiError(TFT_eSPI& gfx);
+void paintControlConfirmation(TFT_eSPI& gfx);
+void paintAlarmScreen(TFT_eSPI& gfx);
+void paintDispensingScreen(TFT_eSPI& gfx);
+void paintAlarmChrome(TFT_eSPI& gfx);
+void paintDispensingChrome(TFT_eSPI& gfx);
+void paintDispensedChrome(TFT_eSPI& gfx);
+void paintTakeMedicineChrome(TFT_eSPI& gfx);
+void paintQuantityChrome(TFT_eSPI& gfx);
+void paintContainerSelectionChrome(TFT_eSPI& gfx);
+void paintJamChrome(TFT_eSPI& gfx);
+void paintWiFiErrorChrome(TFT_eSPI& gfx);
+void paintControlChrome(TFT_eSPI& gfx);
+bool usesDirtyRegions(DisplayState state);
+int confirmationRemaining();
+void checkModalRepaint();
 void drawQuantityConfirmation();
 void drawContainerSelectionScreen();
 void drawJamAlert();
@@ -247,15 +519,32 @@ void showToast(const char* message, uint16_t color, int duration = 2000);
 void onModeChangeToOffline();
 void onModeChangeToOnline(int actionsSynced);
 
+// Display and the off-screen buffers the screens draw through
+void displayBegin() {
+  tft.init();
+  tft.setRotation(2);
+  tft.fillScreen(BACKGROUND_COLOR);
+  dirtyBegin(tft.width(), tft.height());
+  // Modal screens are composed off screen, a band at a time
+  if (bandBegin(tft, BAND_HEIGHT, BAND_BITS, uiPalette, 16, BAND_PING_PONG)) {
+    LOG_INFO("Band: %d rows at %d bits%s (%u bytes)", BAND_HEIGHT, BAND_BITS,
+             BAND_PING_PONG ? ", ping-pong" : "", (unsigned)bandBytes());
+  }
+}
 
+// The unit tests (test/) bring their own setup() and loop()
+#ifndef PIO_UNIT_TESTING
 void setup() {
   Serial.begin(115200);
+  logBegin();
+  allocCountBegin();  // counts the loop task, see updateDisplay()
+  if (journalBegin()) {
+    journalStartTask();
+  }
   SerialPort.begin(9600, SERIAL_8N1, 16, 17); // RX=16, TX=17
 
   // Initialize TFT
-  tft.init();
-  tft.setRotation(2);
-  tft.fillScreen(BACKGROUND_COLOR);
+  displayBegin();
   
   // Initialize backlight
   pinMode(BACKLIGHT, OUTPUT);
@@ -265,10 +554,45 @@ void setup() {
   ts.begin();
   ts.setRotation(4);
   
-  // Show startup screen
+  // Screens follow model changes from here on, including the snapshot load
+  subscribeScreens();
+  
+  // Show startup screen while the last synced model loads from flash
   showStartupScreen();
+  unsigned long bootStart = millis();
+  if (loadModelSnapshot()) {
+    LOG_INFO("Model restored from snapshot in %lu ms", millis() - bootStart);
+  }
+  outboxBegin();
+  tft.fillScreen(BACKGROUND_COLOR);
   
-  Serial.println("TFT Display Ready");
+  LOG_INFO("TFT Display Ready");
+  
+  // Agree on protocol capabilities with the minder (falls back to legacy JSON)
+  linkBegin();
+
+  // Record incoming traffic (see capture.h)
+  // captureBegin(CAPTURE_SERIAL);
+  // captureBegin(CAPTURE_FLASH);
+
+  // Check that a large day fits the model budget
+  // checkModelCapacity();
+  // Compare a one-row status update against resending the whole schedule
+  // benchScheduleStatusUpdate();
+  // Time a full modal screen for several band heights and depths
+  // benchBandHeights();
+  // Time entering a modal screen with its static layer cold and cached
+  // benchStaticLayers();
+  // Check that the chart downsampling keeps a short temperature spike
+  // checkSensorChart();
+  // Check the rolling adherence windows against a recount (clears the counters)
+  // checkAdherence();
+  // Report how much of each modal screen is sent again while it stays up
+  // checkModalRepaint();
+
+  // Replay the last flash capture and report parse/render timings
+  // replayCapture(rxDecoder, 1.0f);
+  // replayCapture(rxDecoder, REPLAY_MAX_SPEED);
   // syncTimeWithNTP();
 
   // go to control queue confirmation for testing
@@ -281,71 +605,31 @@ void setup() {
 
 void loop() {
   // Frame protocol receiver
-  static enum { SYNC1, SYNC2, LENGTH_HIGH, LENGTH_LOW, DATA, CHECKSUM, END } rxState = SYNC1;
-  static uint16_t rxLength = 0;
-  static uint16_t rxCount = 0;
-  static uint8_t rxChecksum = 0;
-  static char rxBuffer[1024];
-  
   while (SerialPort.available()) {
-    uint8_t b = SerialPort.read();
-    
-    switch (rxState) {
-      case SYNC1:
-        if (b == 0x7E) {
-          rxState = SYNC2;
-        }
-        break;
-        
-      case SYNC2:
-        if (b == 0x7E) {
-          rxState = LENGTH_HIGH;
-        } else {
-          rxState = SYNC1;
-        }
-        break;
-        
-      case LENGTH_HIGH:
-        rxLength = b << 8;
-        rxState = LENGTH_LOW;
-        break;
-        
-      case LENGTH_LOW:
-        rxLength |= b;
-        if (rxLength > 0 && rxLength < sizeof(rxBuffer)) {
-          rxCount = 0;
-          rxChecksum = 0;
-          rxState = DATA;
-        } else {
-          rxState = SYNC1;
-        }
-        break;
-        
-      case DATA:
-        rxBuffer[rxCount++] = b;
-        rxChecksum ^= b;
-        if (rxCount >= rxLength) {
-          rxState = CHECKSUM;
-        }
-        break;
-        
-      case CHECKSUM:
-        if (b == rxChecksum) {
-          rxState = END;
-        } else {
-          Serial.println("Checksum error");
-          rxState = SYNC1;
-        }
-        break;
-        
-      case END:
-        if (b == 0x00) {
-          rxBuffer[rxCount] = '\0';
-          processIncomingData(String(rxBuffer));
-        }
-        rxState = SYNC1;
-        break;
-    }
+    rxDecoder.feed(SerialPort.read());
+  }
+  
+  // Retry the capability handshake until the minder answers, and again after it reboots
+  linkPoll(!minderOnline(), rxDecoder.checksumErrors());
+  
+  // Fire cached reminders on the local clock; report them when the minder is back
+  DayMinute now = nowMinute();
+  if (now != MINUTE_NONE) {
+    timerWheelAdvance(now, onReminderDue);
+  }
+  pollLocalAlerts();
+  
+  // Replay user responses kept while the minder was away
+  static int lastOutboxDepth = 0;
+  outboxPoll(minderOnline());
+  if (outboxDepth() != lastOutboxDepth) {
+    lastOutboxDepth = outboxDepth();
+    if (currentState == STATE_HOME) redrawDataScreen();
+  }
+  
+  // Persist the model once syncs have settled
+  if (snapshotDue()) {
+    saveModelSnapshot();
   }
   
   // Handle touch input
@@ -360,20 +644,23 @@ void loop() {
       currentState = STATE_HOME;
       
       // Send timeout response to minder
-      StaticJsonDocument<256> doc;
-      doc["type"] = "confirmation_response";
-      doc["confirmed"] = false;
-      doc["timeout"] = true;
-      doc["confirmation_type"] = pendingConfirmation.type;
+      ConfirmationResponseMsg response;
+      response.confirmed = false;
+      response.timeout = true;
+      response.confirmation_type = pendingConfirmation.type;
+      outboxSend(response, nowMinute());
+      journalConfirmation(JOURNAL_TIMEOUT);
+      recordConfirmation(false);
       
-      String jsonStr;
-      serializeJson(doc, jsonStr);
-      SerialPort.println(jsonStr);
-      
-      Serial.println("Confirmation timeout - auto cancelled");
+      LOG_INFO("Confirmation timeout - auto cancelled");
     }
   }
   
+  // Doses still open at midnight count as missed
+  if (adherenceDayEnded(nowMinute())) {
+    closeAdherenceDay();
+  }
+  
   // Update display based on current state
   updateDisplay();
   
@@ -383,6 +670,7 @@ void loop() {
     lastDummyTime = millis();
     // Uncomment one of the dummy data functions below for testing
     // generateDummyData(); // Sends all dummy data
+    // sendDummyBatch();    // Same data in one batch frame
     // sendDummyDeviceInfo();
     // sendDummySensorData();
     // sendDummySystemStatus();
@@ -393,395 +681,1093 @@ void loop() {
   
   delay(100);
 }
+#endif  // PIO_UNIT_TESTING
+
+// ==================== BATCH FRAMES ====================
+// A batch carries several messages (see PROTOCOL.md). All of them are decoded
+// first; only if every one is valid are they applied, followed by one repaint.
+
+// Binary body: u16 count, then per message u16 length + the message itself
+bool walkBatch(BinReader reader, bool apply) {
+  uint16_t count = (reader.getByte() << 8) | reader.getByte();
+  for (uint16_t i = 0; i < count; i++) {
+    uint16_t len = (reader.getByte() << 8) | reader.getByte();
+    const uint8_t* bytes = reader.getBytes(len);
+    if (!bytes) return false;
+    
+    BinReader item(bytes, len);
+    MsgType type;
+    if (!readMsgHeader(item, type) || type == MSG_BATCH) return false;
+    if (!(apply ? dispatchDisplayMessage(type, item) : validateDisplayMessage(type, item))) return false;
+  }
+  return reader.ok();
+}
+
+bool walkBatch(JsonArrayConst messages, bool apply) {
+  if (messages.isNull()) return false;
+  for (JsonObjectConst item : messages) {
+    MsgType type = msgTypeFromName(item["type"] | "unknown");
+    if (type == MSG_BATCH) return false;
+    if (!(apply ? dispatchDisplayMessage(type, item) : validateDisplayMessage(type, item))) return false;
+  }
+  return true;
+}
+
+template <typename Body>
+void processBatch(const Body& body) {
+  if (!walkBatch(body, false)) {
+    LOG_WARN("Batch rejected: contains an invalid message");
+    return;
+  }
+  
+  applyingBatch = true;
+  redrawPending = false;
+  pendingBar.clear();
+  walkBatch(body, true);
+  applyingBatch = false;
+  
+  if (redrawPending) {
+    redrawPending = false;
+    redrawDataScreen();
+  }
+  if (!pendingBar.isEmpty()) {
+    if (pendingBarError) {
+      showErrorMessage(pendingBar);
+    } else {
+      showStatusMessage(pendingBar);
+    }
+    pendingBar.clear();
+  }
+}
+
+// Called by rxDecoder for every valid frame, live or replayed
+void handleFrame(const char* data, size_t len) {
+  captureFrame(data, len);
+  lastMinderFrameAt = millis();
+  
+  if (!frameTimingActive()) {
+    // loop() redraws once the RX buffer is drained
+    processIncomingData(data, len);
+    return;
+  }
+  
+  // Render every frame to time it (replays do not go through loop())
+  unsigned long parseStart = micros();
+  processIncomingData(data, len);
+  unsigned long renderStart = micros();
+  updateDisplay();
+  frameTimingAdd(len, renderStart - parseStart, micros() - renderStart);
+}
 
-void processIncomingData(String jsonData) {
-  Serial.println("Received: " + jsonData);
+void processIncomingData(const char* data, size_t len) {
+  // Binary frames carry the message id right after the magic byte
+  if (len > 0 && (uint8_t)data[0] == MSG_BINARY_MAGIC) {
+    BinReader reader((const uint8_t*)data, len);
+    MsgType type;
+    if (!readMsgHeader(reader, type)) {
+      LOG_WARN("Binary frame: bad header");
+      return;
+    }
+    LOG_DEBUG("Received: %s (binary, %u bytes)", msgTypeName(type), (unsigned)len);
+    if (type == MSG_BATCH) {
+      processBatch(reader);
+    } else if (!dispatchDisplayMessage(type, reader)) {
+      LOG_WARN("Binary frame: failed to decode %s", msgTypeName(type));
+    }
+    return;
+  }
+  
+  LOG_DEBUG("Received: %s", data);
   
   JsonDocument doc;
-  DeserializationError error = deserializeJson(doc, jsonData);
+  DeserializationError error = deserializeJson(doc, data, len);
   
   if (error) {
-    Serial.print("JSON parse error: ");
-    Serial.println(error.c_str());
+    LOG_WARN("JSON parse error: %s", error.c_str());
     return;
   }
   
-  String type = doc["type"] | "unknown";
+  JsonObjectConst obj = doc.as<JsonObjectConst>();
+  const char* typeName = obj["type"] | "unknown";
+  MsgType type = msgTypeFromName(typeName);
+  if (type == MSG_BATCH) {
+    processBatch(obj["messages"].as<JsonArrayConst>());
+  } else if (!dispatchDisplayMessage(type, obj)) {
+    LOG_WARN("Unhandled message type: %s", typeName);
+  }
+}
+
+void processIncomingData(const String& jsonData) {
+  processIncomingData(jsonData.c_str(), jsonData.length());
+}
+
+// ==================== MESSAGE HANDLERS ====================
+// Called by dispatchDisplayMessage() (generated in messages.h) once a frame
+// has been decoded into its typed struct.
+
+void redrawDataScreen() {
+  // Inside a batch, repaint once after its last message instead
+  if (applyingBatch) {
+    redrawPending = true;
+    return;
+  }
   
-  if (type == "status") {
-    // General status update
-    String message = doc["message"] | "";
-    showStatusMessage(message);
+  // Force redraw current screen with updated data. The other screens track
+  // their own changes (stale flags, dirty regions) and repaint from
+  // updateDisplay(); clearing them here would leave them blank.
+  switch (currentState) {
+    case STATE_HOME: tft.fillScreen(BACKGROUND_COLOR); drawHomeScreen(); break;
+    case STATE_CONTAINERS: tft.fillScreen(BACKGROUND_COLOR); drawContainersScreen(); break;
+    case STATE_REMINDERS: tft.fillScreen(BACKGROUND_COLOR); drawRemindersScreen(); break;
+    case STATE_SCHEDULE: tft.fillScreen(BACKGROUND_COLOR); drawScheduleScreen(); break;
+    default: break;
+  }
+}
 
-    // Handle AP Mode detection
-    if (message == "AP Mode Active") {
-      isInAPMode = true;
-      apModeMessage = "WiFi Setup Mode\nConnect to: MinderAP\nConfigure WiFi settings";
-      currentState = STATE_HOME;  // Ensure we're on home screen to show the message
-      tft.fillScreen(BACKGROUND_COLOR);
-      drawHomeScreen();
-    }
-    
-    
-  } else if (type == "sync_all_data") {
-    // Full data sync
-    wifiConnected = doc["wifi_connected"] | false;
-    mqttConnected = doc["mqtt_connected"] | false;
-    timeSynced = doc["time_synced"] | false;
-    
-    // Sync containers if available
-    if (doc["containers"].is<JsonArray>()) {
-      syncContainers(doc["containers"]);
-    }
-    
-    // Sync reminders if available
-    if (doc["reminders"].is<JsonArray>()) {
-      syncReminders(doc["reminders"]);
-    }
-    
-    // Sync daily schedule if available
-    if (doc["daily_schedule"].is<JsonArray>()) {
-      syncDailySchedule(doc["daily_schedule"]);
-    }
-    
-    Serial.println("Full data sync completed");
-    
-    // Force redraw current screen with updated data
-    tft.fillScreen(BACKGROUND_COLOR);
-    switch (currentState) {
-      case STATE_HOME: drawHomeScreen(); break;
-      case STATE_CONTAINERS: drawContainersScreen(); break;
-      case STATE_REMINDERS: drawRemindersScreen(); break;
-      case STATE_SCHEDULE: drawScheduleScreen(); break;
-      default: updateDisplay(); break;
-    }
-    
-  } else if (type == "containers_info") {
-    // Container data update
-    if (doc["containers"].is<JsonArray>()) {
-      syncContainers(doc["containers"]);
-      // Redraw if we're on containers screen
-      if (currentState == STATE_CONTAINERS) {
-        tft.fillScreen(BACKGROUND_COLOR);
-        drawContainersScreen();
-      }
-    }
-    
-  } else if (type == "reminders_info") {
-    // Reminder data update
-    if (doc["reminders"].is<JsonArray>()) {
-      syncReminders(doc["reminders"]);
-      // Redraw if we're on reminders screen
-      if (currentState == STATE_REMINDERS) {
-        tft.fillScreen(BACKGROUND_COLOR);
-        drawRemindersScreen();
-      }
-    }
-    
-  } else if (type == "daily_schedule") {
-    // Daily schedule update
-    if (doc["schedule"].is<JsonArray>()) {
-      syncDailySchedule(doc["schedule"]);
-      // Redraw if we're on schedule screen
-      if (currentState == STATE_SCHEDULE) {
-        tft.fillScreen(BACKGROUND_COLOR);
-        drawScheduleScreen();
-      }
-    }
-    
-  } else if (type == "sensor_data") {
-    // Sensor data update
-    currentTemperature = doc["temperature"] | 0.0;
-    currentHumidity = doc["humidity"] | 0.0;
-    // Redraw home screen to show updated sensor data
-    if (currentState == STATE_HOME) {
-      tft.fillScreen(BACKGROUND_COLOR);
-      drawHomeScreen();
-    }
-    
-  } else if (type == "system_status") {
-    // System status update
-    String wifiStatus = doc["wifi_status"] | "disconnected";
-    String mqttStatus = doc["mqtt_status"] | "disconnected";
-    bool apMode = doc["ap_mode"] | false;
-    wifiConnected = (wifiStatus == "connected");
-    mqttConnected = (mqttStatus == "connected");
-    timeSynced = doc["rtc_time_set"] | false;
-    currentTemperature = doc["temperature"] | 0.0;
-    currentHumidity = doc["humidity"] | 0.0;
-    isInAPMode = apMode;
-    
-    // Hybrid Architecture: Parse operation mode and pending actions
-    const char* newMode = doc["operation_mode"] | "offline";
-    int newPending = doc["pending_actions"] | 0;
-    
-    // Detect mode changes and trigger callbacks
-    if (strcmp(lastOperationMode, newMode) != 0) {
-      if (strcmp(newMode, "offline") == 0) {
-        onModeChangeToOffline();
-      } else if (strcmp(newMode, "online") == 0) {
-        int syncedCount = lastPendingActions - newPending;
-        onModeChangeToOnline(syncedCount);
-      }
-      strcpy(lastOperationMode, newMode);
+// Records hash as the block's new content; false (and counted) if nothing changed
+bool blockChanged(uint32_t& lastHash, uint32_t hash, const char* block) {
+  if (hash == lastHash) {
+    redrawsAvoided++;
+    LOG_DEBUG("Unchanged %s skipped (%lu redraws avoided)", block, (unsigned long)redrawsAvoided);
+    return false;
+  }
+  lastHash = hash;
+  return true;
+}
+
+uint32_t sensorBlockHash(float temperature, float humidity) {
+  MsgHash h;
+  h.add(temperature);
+  h.add(humidity);
+  return h.value();
+}
+
+void handleMessage(const StatusMsg& msg) {
+  // General status update
+  showStatusMessage(msg.message);
+
+  // Handle AP Mode detection
+  if (strcmp(msg.message, "AP Mode Active") == 0) {
+    isInAPMode = true;
+    apModeMessage = "WiFi Setup Mode\nConnect to: MinderAP\nConfigure WiFi settings";
+    currentState = STATE_HOME;  // Ensure we're on home screen to show the message
+    redrawDataScreen();
+  }
+}
+
+void handleMessage(const SyncAllDataMsg& msg) {
+  // Full data sync
+  bool changed = wifiConnected != msg.wifi_connected ||
+                 mqttConnected != msg.mqtt_connected ||
+                 timeSynced != msg.time_synced;
+  wifiConnected = msg.wifi_connected;
+  mqttConnected = msg.mqtt_connected;
+  timeSynced = msg.time_synced;
+  
+  // Sync each collection only if the minder sent it and it differs from what we have
+  if (msg.containers.isPresent() && blockChanged(containersHash, msgHash(msg.containers), "containers")) {
+    syncContainers(msg.containers);
+    changed = true;
+  }
+  if (msg.reminders.isPresent() && blockChanged(remindersHash, msgHash(msg.reminders), "reminders")) {
+    syncReminders(msg.reminders);
+    changed = true;
+  }
+  if (msg.daily_schedule.isPresent() && blockChanged(scheduleHash, msgHash(msg.daily_schedule), "schedule")) {
+    syncDailySchedule(msg.daily_schedule);
+    changed = true;
+  }
+  
+  LOG_INFO("Full data sync completed");
+  if (changed) {
+    redrawDataScreen();
+  }
+}
+
+void handleMessage(const ContainersInfoMsg& msg) {
+  if (!msg.containers.isPresent()) return;
+  if (!blockChanged(containersHash, msgHash(msg.containers), "containers")) return;
+  syncContainers(msg.containers);
+  // Redraw if we're on containers screen
+  if (currentState == STATE_CONTAINERS) {
+    redrawDataScreen();
+  }
+}
+
+void handleMessage(const RemindersInfoMsg& msg) {
+  if (!msg.reminders.isPresent()) return;
+  if (!blockChanged(remindersHash, msgHash(msg.reminders), "reminders")) return;
+  syncReminders(msg.reminders);
+  // Redraw if we're on reminders screen
+  if (currentState == STATE_REMINDERS) {
+    redrawDataScreen();
+  }
+}
+
+void handleMessage(const DailyScheduleMsg& msg) {
+  if (!msg.schedule.isPresent()) return;
+  if (!blockChanged(scheduleHash, msgHash(msg.schedule), "schedule")) return;
+  syncDailySchedule(msg.schedule);
+  // Redraw if we're on schedule screen
+  if (currentState == STATE_SCHEDULE) {
+    redrawDataScreen();
+  }
+}
+
+// One dose changed status; only its row is touched
+void handleMessage(const ScheduleItemStatusMsg& msg) {
+  int slot = findScheduleItem(msg.reminder_id, parseDayMinute(msg.time));
+  if (slot < 0) {
+    LOG_WARN("No schedule item for reminder %d at %s", msg.reminder_id, msg.time);
+    return;
+  }
+  
+  DailySchedule& item = dailySchedule[slot];
+  if (item.status == msg.status) return;
+  bool wasPending = item.status != "completed";
+  item.status = msg.status;
+  modelStats.pendingDoses += (item.status != "completed") - wasPending;
+  recordDoseStatus(item);
+  
+  scheduleHash = 0;  // the stored schedule no longer matches the last full one
+  snapshotMarkDirty();
+  modelNotify(CHANGE_DOSE);
+  repaintScheduleRow(slot);
+}
+
+void handleMessage(const SensorDataMsg& msg) {
+  // Every reading is a sample, even when it repeats the last one
+  sensorHistoryAdd(msg.temperature, msg.humidity, millis());
+  if (!blockChanged(sensorHash, sensorBlockHash(msg.temperature, msg.humidity), "sensor_data")) return;
+  currentTemperature = msg.temperature;
+  currentHumidity = msg.humidity;
+  // Redraw home screen to show updated sensor data
+  if (currentState == STATE_HOME) {
+    redrawDataScreen();
+  }
+}
+
+void handleMessage(const SystemStatusMsg& msg) {
+  sensorHistoryAdd(msg.temperature, msg.humidity, millis());
+  // Temperature and humidity are left out of the status hash: sensor_data
+  // and device_info change them too, so they are compared as the sensor block
+  bool sensorChanged = blockChanged(sensorHash, sensorBlockHash(msg.temperature, msg.humidity), "sensor");
+  if (sensorChanged) {
+    currentTemperature = msg.temperature;
+    currentHumidity = msg.humidity;
+  }
+  if (!blockChanged(systemStatusHash, msgHash(msg), "system_status")) {
+    if (sensorChanged && currentState == STATE_HOME) {
+      redrawDataScreen();
     }
-    
-    // Store current state
-    strcpy(operationMode, newMode);
-    pendingActionsCount = newPending;
-    lastPendingActions = newPending;
-    
-    // Force redraw current screen to show updated status
-    tft.fillScreen(BACKGROUND_COLOR);
-    switch (currentState) {
-      case STATE_HOME: drawHomeScreen(); break;
-      case STATE_CONTAINERS: drawContainersScreen(); break;
-      case STATE_REMINDERS: drawRemindersScreen(); break;
-      case STATE_SCHEDULE: drawScheduleScreen(); break;
-      default: updateDisplay(); break;
-    }
-    
-  } else if (type == "device_info") {
-    // Device info
-    currentTemperature = doc["temperature"] | 0.0;
-    currentHumidity = doc["humidity"] | 0.0;
-    
-  } else if (type == "alarm_status") {
-    // Alarm status
-    alarmActive = doc["alarm_active"] | false;
-    alarmType = doc["alarm_type"] | "";
-    
-    if (alarmActive) {
-      currentState = STATE_ALARM;
-    } else if (currentState == STATE_ALARM) {
-      currentState = STATE_HOME;
+    return;
+  }
+  wifiConnected = (strcmp(msg.wifi_status, "connected") == 0);
+  mqttConnected = (strcmp(msg.mqtt_status, "connected") == 0);
+  timeSynced = msg.rtc_time_set;
+  isInAPMode = msg.ap_mode;
+  
+  // Hybrid Architecture: Detect mode changes and trigger callbacks
+  const char* newMode = msg.operation_mode;
+  int newPending = msg.pending_actions;
+  if (strcmp(lastOperationMode, newMode) != 0) {
+    if (strcmp(newMode, "offline") == 0) {
+      onModeChangeToOffline();
+    } else if (strcmp(newMode, "online") == 0) {
+      int syncedCount = lastPendingActions - newPending;
+      onModeChangeToOnline(syncedCount);
     }
-    
-  } else if (type == "confirmation_request") {
-    // Confirmation request from minder
-    hasPendingConfirmation = true;
-    confirmationStartTime = millis();
-    
-    // Read request_type (sent by minder) and convert to type number
-    String requestType = doc["request_type"] | "medication";
-    pendingConfirmation.type = (requestType == "device_control") ? 1 : 0; // 0=medication, 1=device_control
-    pendingConfirmation.timeout_seconds = doc["timeout_seconds"] | 60;
-    pendingConfirmation.sent_at = millis();
-    
-    if (pendingConfirmation.type == 0) {
-      // Medication confirmation
-      JsonArray remindersArray = doc["reminders"];
-      pendingConfirmation.reminder_count = 0;
-      
-      for (JsonObject reminderObj : remindersArray) {
-        if (pendingConfirmation.reminder_count < 10) {
-          ReminderItem& item = pendingConfirmation.reminders[pendingConfirmation.reminder_count];
-          item.id = reminderObj["id"] | 0;
-          item.medicine_name = reminderObj["medicine_name"] | "";
-          item.container_id = reminderObj["container_id"] | 0;
-          item.dosage = reminderObj["dosage"] | 1;
-          pendingConfirmation.reminder_count++;
-        }
-      }
-      
-      currentState = STATE_TAKE_MEDICINE;
-      
-    } else if (pendingConfirmation.type == 1) {
-      // Device control confirmation - read from root of JSON
-      pendingConfirmation.control.control_id = doc["control_id"] | 0;
-      pendingConfirmation.control.action = doc["action"] | "";
-      pendingConfirmation.control.medicine_name = doc["medicine_name"] | "";
-      pendingConfirmation.control.container_id = doc["container_id"] | 0;
-      pendingConfirmation.control.quantity = doc["quantity"] | 0;
-      pendingConfirmation.control.message = doc["message"] | "";
-      
-      currentState = STATE_CONTROL_QUEUE_CONFIRMATION;
+    strlcpy(lastOperationMode, newMode, sizeof(lastOperationMode));
+  }
+  
+  // Store current state
+  strlcpy(operationMode, newMode, sizeof(operationMode));
+  pendingActionsCount = newPending;
+  lastPendingActions = newPending;
+  
+  redrawDataScreen();
+}
+
+void handleMessage(const DeviceInfoMsg& msg) {
+  sensorHash = sensorBlockHash(msg.temperature, msg.humidity);
+  currentTemperature = msg.temperature;
+  currentHumidity = msg.humidity;
+}
+
+void handleMessage(const AlarmStatusMsg& msg) {
+  alarmActive = msg.alarm_active;
+  alarmType = msg.alarm_type;
+  
+  if (alarmActive) {
+    currentState = STATE_ALARM;
+  } else if (currentState == STATE_ALARM) {
+    currentState = STATE_HOME;
+  }
+}
+
+void handleMessage(const ConfirmationRequestMsg& msg) {
+  hasPendingConfirmation = true;
+  confirmationStartTime = millis();
+  
+  pendingConfirmation.type = (strcmp(msg.request_type, "device_control") == 0) ? 1 : 0; // 0=medication, 1=device_control
+  pendingConfirmation.timeout_seconds = msg.timeout_seconds;
+  pendingConfirmation.sent_at = millis();
+  dirtyInvalidateAll();
+  
+  if (pendingConfirmation.type == 0) {
+    // Medication confirmation
+    size_t capacity = pendingConfirmation.reminders.resize(msg.reminders.size());
+    size_t count = 0;
+    for (const ReminderItemRec& rec : msg.reminders) {
+      if (count >= capacity) break;
+      ReminderItem& item = pendingConfirmation.reminders[count++];
+      item.id = rec.id;
+      item.medicine = internName(rec.medicine_name);
+      item.container_id = rec.container_id;
+      item.dosage = rec.dosage;
+      cancelLocalAlerts(item.medicine);
     }
+    warnModelFull("confirmation items", capacity, msg.reminders.size());
     
-  } else if (type == "reminder_alert") {
-    // Single reminder alert
-    String medicineName = doc["medicine_name"] | "";
-    int containerId = doc["container_id"] | doc["container_number"] | 0;
-    int dosage = doc["dosage"] | 1;
-    String alertType = doc["schedule_type"] | "reminder";
-    String message = doc["notes"] | "";
-    String timeStr = doc["reminder_time"] | "";
-    
-    // Hybrid Architecture: Parse source and operation mode
-    const char* source = doc["source"] | "mqtt";
-    const char* mode = doc["operation_mode"] | "online";
-    strcpy(alertSource, source);
-    strcpy(alertOperationMode, mode);
+    currentState = STATE_TAKE_MEDICINE;
     
-    showReminderAlert(medicineName, containerId, dosage, alertType, message, timeStr);
+  } else {
+    // Device control confirmation - fields sit at the root of the message
+    pendingConfirmation.control.control_id = msg.control_id;
+    pendingConfirmation.control.action = msg.action;
+    pendingConfirmation.control.medicine = internName(msg.medicine_name);
+    pendingConfirmation.control.container_id = msg.container_id;
+    pendingConfirmation.control.quantity = msg.quantity;
+    pendingConfirmation.control.message = msg.message;
     
-  } else if (type == "grouped_reminder_alert") {
-    // Multiple reminders at same time
-    currentState = STATE_ALARM;
-    alarmActive = true;
-    alarmType = "grouped_alert";
-    
-  } else if (type == "dispensing_status") {
-    // Dispensing status update
-    String dispStatus = doc["status"] | "";
-    dispensingMedicineName = doc["medicine_name"] | "";
-    dispensingContainer = doc["container_number"] | 0;
-    dispensingDosage = doc["dosage"] | 0;
-    
-    if (dispStatus == "started" || dispStatus == "in_progress") {
-      if (!isDispensing) {
-        dispensingStartTime = millis(); // Record start time
-      }
-      isDispensing = true;
-      dispensingComplete = false;
-      if (currentState != STATE_DISPENSING) {
-        currentState = STATE_DISPENSING;
-      }
-    } else if (dispStatus == "completed") {
-      dispensingComplete = true;
+    currentState = STATE_CONTROL_QUEUE_CONFIRMATION;
+  }
+}
+
+void handleMessage(const ReminderAlertMsg& msg) {
+  // Hybrid Architecture: Remember source and operation mode
+  strlcpy(alertSource, msg.source, sizeof(alertSource));
+  strlcpy(alertOperationMode, msg.operation_mode, sizeof(alertOperationMode));
+  
+  cancelLocalAlerts(internName(msg.medicine_name));
+  shownLocalAlert = -1;
+  showReminderAlert(msg.medicine_name, msg.container_id, msg.dosage, msg.schedule_type, msg.notes, msg.reminder_time);
+}
+
+void handleMessage(const GroupedReminderAlertMsg& msg) {
+  // Multiple reminders at same time
+  cancelLocalAlerts(NAME_NONE);
+  shownLocalAlert = -1;
+  currentState = STATE_ALARM;
+  alarmActive = true;
+  alarmType = "grouped_alert";
+}
+
+void handleMessage(const DispensingStatusMsg& msg) {
+  dispensingMedicine = internName(msg.medicine_name);
+  dispensingContainer = msg.container_number;
+  dispensingDosage = msg.dosage;
+  dirtyInvalidateAll();
+  
+  if (strcmp(msg.status, "started") == 0 || strcmp(msg.status, "in_progress") == 0) {
+    if (!isDispensing) {
+      dispensingStartTime = millis(); // Record start time
     }
-    
-  } else if (type == "all_dispensing_completed") {
-    // All medicines dispensed, show quantity confirmation
-    isDispensing = false;
-    currentState = STATE_QUANTITY_CONFIRMATION;
-    
-  } else if (type == "stock_alert") {
-    // Stock alert
-    String medicineName = doc["medicine_name"] | "";
-    int current = doc["current_stock"] | 0;
-    int minimum = doc["minimum_stock"] | 0;
-    Serial.printf("Stock Alert: %s - Current: %d, Minimum: %d\n", medicineName.c_str(), current, minimum);
-    
-  } else if (type == "jam_alert") {
-    // Jam alert
-    jamAlertContainer = doc["container_number"] | 0;
-    jamAlertMedicine = doc["medicine_name"] | "";
-    jamAlertPillsRemaining = doc["pills_remaining"] | 0;
-    currentState = STATE_JAM_ALERT;
-    
-  } else if (type == "wifi_error_alert") {
-    // WiFi error alert
-    wifiErrorMessage = doc["message"] | "";
-    wifiErrorInstruction = doc["instruction"] | "";
-    currentState = STATE_WIFI_ERROR;
-    
-  } else if (type == "current_time") {
-    // Time update from minder
-    currentTimeString = doc["time"] | "00:00";
-    // Only redraw if on home screen
-    if (currentState == STATE_HOME) {
-      drawHomeScreen();
+    isDispensing = true;
+    dispensingComplete = false;
+    if (currentState != STATE_DISPENSING) {
+      currentState = STATE_DISPENSING;
     }
+  } else if (strcmp(msg.status, "completed") == 0) {
+    dispensingComplete = true;
+    journalAppend(JOURNAL_DISPENSE, msg.container_number, msg.dosage, nowMinute());
     
-  } else if (type == "system_status") {
-    // System status update
-    String wifiStatus = doc["wifi_status"] | "disconnected";
-    String mqttStatus = doc["mqtt_status"] | "disconnected";
-    wifiConnected = (wifiStatus == "connected");
-    mqttConnected = (mqttStatus == "connected");
-    timeSynced = doc["rtc_time_set"] | false;
-    currentTemperature = doc["temperature"] | 0.0;
-    currentHumidity = doc["humidity"] | 0.0;
-    
-    // Check AP mode status
-    isInAPMode = doc["ap_mode"] | false;
-    if (isInAPMode) {
-      apModeMessage = "WiFi Setup Mode\nConnect to: MinderAP\nConfigure WiFi settings";
+    // pills_remaining is left out when zero, so only a non-zero count is trusted
+    Container* container = findContainer(msg.container_number);
+    if (container && msg.pills_remaining > 0) {
+      setContainerStock(container, msg.pills_remaining, container->low_stock);
     }
+  }
+}
 
-    updateDisplay();
-    
-  } else if (type == "error") {
-    // Error message
-    String errorMsg = doc["message"] | "";
-    showErrorMessage(errorMsg);
-    
-  } else if (type == "control_queue_complete") {
-    // Control queue completion
-    int queueId = doc["queue_id"] | 0;
-    bool success = doc["success"] | false;
-    String message = doc["message"] | "";
-    
-    showControlQueueResult(queueId, success, message);
-  } else if (type == "ap_mode_started") {
-    String message = doc["message"] | "";
-
-    if (message == "WiFi Setup Mode Active")
-    {
-      isInAPMode = true;
-      apModeMessage = "WiFi Setup Mode\nConnect to: MinderAP\nConfigure WiFi settings";
-      currentState = STATE_HOME;  // Ensure we're on home screen to show the message
-      tft.fillScreen(BACKGROUND_COLOR);
-      drawHomeScreen();
-    }
-    
+void handleMessage(const AllDispensingCompletedMsg& msg) {
+  // All medicines dispensed, show quantity confirmation
+  isDispensing = false;
+  currentState = STATE_QUANTITY_CONFIRMATION;
+}
+
+void handleMessage(const StockAlertMsg& msg) {
+  LOG_INFO("Stock Alert: %s - Current: %d, Minimum: %d", msg.medicine_name, msg.current_stock, msg.minimum_stock);
+  
+  Container* container = findContainer(msg.container_number);
+  if (container) {
+    setContainerStock(container, msg.current_stock, msg.current_stock <= msg.minimum_stock);
+    repaintDirtyRows();
   }
 }
 
-void syncContainers(JsonArray containersArray) {
-  containerCount = 0;
-  for (JsonVariant containerVar : containersArray) {
-    if (containerCount >= 10) break;
-    
-    JsonObject container = containerVar.as<JsonObject>();
-    containers[containerCount].id = container["id"] | 0;
-    containers[containerCount].medicine_name = container["medicine_name"] | "Unknown";
-    containers[containerCount].current_capacity = container["current_capacity"] | 0;
-    containers[containerCount].max_capacity = container["max_capacity"] | 0;
-    containers[containerCount].low_stock = container["low_stock"] | false;
-    
-    containerCount++;
+void handleMessage(const JamAlertMsg& msg) {
+  jamAlertContainer = msg.container_number;
+  jamAlertMedicine = internName(msg.medicine_name);
+  jamAlertPillsRemaining = msg.pills_remaining;
+  currentState = STATE_JAM_ALERT;
+  dirtyInvalidateAll();
+  journalAppend(JOURNAL_JAM, msg.container_number, msg.pills_remaining, nowMinute());
+  
+  Container* container = findContainer(msg.container_number);
+  if (container) {
+    setContainerStock(container, msg.pills_remaining, container->low_stock);
   }
-  Serial.printf("Synced %d containers\n", containerCount);
 }
 
-void syncReminders(JsonArray remindersArray) {
-  reminderCount = 0;
-  for (JsonVariant reminderVar : remindersArray) {
-    if (reminderCount >= 20) break;
-    
-    JsonObject reminder = reminderVar.as<JsonObject>();
-    reminders[reminderCount].id = reminder["id"] | 0;
-    reminders[reminderCount].medicine_name = reminder["medicine_name"] | "Unknown";
-    reminders[reminderCount].container_id = reminder["container_id"] | 0;
-    reminders[reminderCount].schedule_type = reminder["schedule_type"] | "daily";
-    reminders[reminderCount].active = reminder["active"] | false;
-    
-    // Extract times from times array
-    reminders[reminderCount].timeCount = 0;
-    if (reminder["times"].is<JsonArray>()) {
-      JsonArray timesArray = reminder["times"];
-      for (JsonVariant timeVar : timesArray) {
-        if (reminders[reminderCount].timeCount >= 5) break;
-        JsonObject timeObj = timeVar.as<JsonObject>();
-        reminders[reminderCount].times[reminders[reminderCount].timeCount] = timeObj["time"] | "";
-        reminders[reminderCount].timeCount++;
-      }
+void handleMessage(const WifiErrorAlertMsg& msg) {
+  wifiErrorMessage = msg.message;
+  wifiErrorInstruction = msg.instruction;
+  currentState = STATE_WIFI_ERROR;
+  dirtyInvalidateAll();
+}
+
+void handleMessage(const CurrentTimeMsg& msg) {
+  currentTimeString = msg.time;
+  clockMinute = parseDayMinute(msg.time);
+  clockSetAt = millis();
+  // Only redraw if on home screen
+  if (currentState == STATE_HOME) {
+    if (applyingBatch) {
+      redrawPending = true;
+    } else {
+      drawHomeScreen();
     }
-    
-    reminderCount++;
   }
-  Serial.printf("Synced %d reminders\n", reminderCount);
 }
 
-void syncDailySchedule(JsonArray scheduleArray) {
-  scheduleCount = 0;
-  for (JsonVariant scheduleVar : scheduleArray) {
-    if (scheduleCount >= 24) break;
-    
-    JsonObject schedule = scheduleVar.as<JsonObject>();
-    dailySchedule[scheduleCount].time = schedule["time"] | "";
-    dailySchedule[scheduleCount].medicine_name = schedule["medicine_name"] | "";
-    dailySchedule[scheduleCount].dosage = schedule["dosage"] | 1;
-    dailySchedule[scheduleCount].status = schedule["status"] | "pending";
-    
-    scheduleCount++;
-  }
-  Serial.printf("Synced %d schedule items\n", scheduleCount);
+void handleMessage(const ErrorMsg& msg) {
+  showErrorMessage(msg.message);
 }
 
-void handleTouchInput() {
+void handleMessage(const ControlQueueCompleteMsg& msg) {
+  showControlQueueResult(msg.queue_id, msg.success, msg.message);
+}
+
+void handleMessage(const ApModeStartedMsg& msg) {
+  if (strcmp(msg.message, "WiFi Setup Mode Active") == 0) {
+    isInAPMode = true;
+    apModeMessage = "WiFi Setup Mode\nConnect to: MinderAP\nConfigure WiFi settings";
+    currentState = STATE_HOME;  // Ensure we're on home screen to show the message
+    redrawDataScreen();
+  }
+}
+
+void handleMessage(const HelloAckMsg& msg) {
+  linkAccept(msg);
+}
+
+void handleMessage(const OutboxAckMsg& msg) {
+  outboxAck(msg.seq);
+}
+
+// ==================== END MESSAGE HANDLERS ====================
+
+// Logs records dropped because the model budget (MODEL_ARENA_SIZE) is used up
+void warnModelFull(const char* block, size_t kept, size_t received) {
+  if (kept < received) {
+    LOG_WARN("Model budget full: kept %u of %u %s", (unsigned)kept, (unsigned)received, block);
+  }
+}
+
+void syncContainers(const MsgList<ContainerRec>& containersList) {
+  size_t capacity = containers.resize(containersList.size());
+  size_t count = 0;
+  containerIndex.clear();
+  containerIndexFull = false;
+  for (const ContainerRec& rec : containersList) {
+    // A repeated id updates its earlier row rather than adding another
+    int slot = containerSlot(rec.id, count);
+    if (slot < 0) {
+      if (count >= capacity) break;
+      slot = count++;
+      if (!containerIndex.put(rec.id, slot)) containerIndexFull = true;
+    }
+    
+    Container& container = containers[slot];
+    container.id = rec.id;
+    container.medicine = internName(rec.medicine_name);
+    container.current_capacity = rec.current_capacity;
+    container.max_capacity = rec.max_capacity;
+    container.low_stock = rec.low_stock;
+    container.dirty = false;
+  }
+  containers.resize(count);
+  warnModelFull("containers", capacity, containersList.size());
+  LOG_INFO("Synced %d containers", (int)containers.size());
+  recountContainers();
+  modelNotify(CHANGE_CONTAINERS);
+  snapshotMarkDirty();
+}
+
+void syncReminders(const MsgList<ReminderRec>& remindersList) {
+  size_t capacity = reminders.resize(remindersList.size());
+  size_t count = 0;
+  size_t timesDropped = 0;
+  reminderTimes.clear();
+  reminderIndex.clear();
+  reminderIndexFull = false;
+  for (const ReminderRec& rec : remindersList) {
+    int slot = reminderSlot(rec.id, count);
+    if (slot < 0) {
+      if (count >= capacity) break;
+      slot = count++;
+      if (!reminderIndex.put(rec.id, slot)) reminderIndexFull = true;
+    }
+    
+    // reminderTimes comes after reminders in the arena, so growing it
+    // leaves this reference valid
+    Reminder& reminder = reminders[slot];
+    reminder.id = rec.id;
+    reminder.medicine = internName(rec.medicine_name);
+    reminder.container_id = rec.container_id;
+    reminder.schedule_type = rec.schedule_type;
+    reminder.active = rec.active;
+    
+    // Times go to the shared reminderTimes list
+    size_t first = reminderTimes.size();
+    size_t last = reminderTimes.resize(first + rec.times.size());
+    timesDropped += first + rec.times.size() - last;
+    reminder.firstTime = first;
+    reminder.timeCount = 0;
+    for (const ReminderTimeRec& timeRec : rec.times) {
+      if (first + reminder.timeCount >= last) break;
+      ReminderTime& time = reminderTimes[first + reminder.timeCount];
+      time.time = parseDayMinute(timeRec.time);
+      time.dosage = timeRec.dosage > 0 ? timeRec.dosage : 1;
+      reminder.timeCount++;
+    }
+  }
+  reminders.resize(count);
+  warnModelFull("reminders", capacity, remindersList.size());
+  if (timesDropped) LOG_WARN("Model budget full: dropped %u reminder times", (unsigned)timesDropped);
+  LOG_INFO("Synced %d reminders", (int)reminders.size());
+  rebuildReminderTimers();
+  recountReminders();
+  modelNotify(CHANGE_REMINDERS);
+  snapshotMarkDirty();
+}
+
+void syncDailySchedule(const MsgList<ScheduleRec>& scheduleList) {
+  size_t capacity = dailySchedule.resize(scheduleList.size());
+  size_t count = 0;
+  for (const ScheduleRec& rec : scheduleList) {
+    if (count >= capacity) break;
+    
+    DailySchedule& item = dailySchedule[count];
+    item.time = parseDayMinute(rec.time);
+    item.medicine = internName(rec.medicine_name);
+    item.dosage = rec.dosage;
+    item.reminder_id = rec.reminder_id;
+    item.status = rec.status;
+    
+    count++;
+  }
+  // A list that stopped decoding partway leaves old rows past count
+  dailySchedule.resize(count);
+  sortScheduleByTime();
+  for (const DailySchedule& item : dailySchedule) recordDoseStatus(item);
+  warnModelFull("schedule items", capacity, scheduleList.size());
+  LOG_INFO("Synced %d schedule items", (int)dailySchedule.size());
+  recountSchedule();
+  modelNotify(CHANGE_SCHEDULE);
+  snapshotMarkDirty();
+}
+
+// ==================== ADHERENCE ====================
+// Dose outcomes into adherence.h: the minder's schedule statuses, the user's
+// answers to take-medicine confirmations, and at midnight the doses left open.
+
+// Taken, or late once ADHERENCE_LATE_MIN past the dose time
+DoseOutcome takenOutcome(DayMinute time) {
+  DayMinute now = nowMinute();
+  if (now == MINUTE_NONE || time == MINUTE_NONE || now < time) return DOSE_TAKEN;
+  return now - time > ADHERENCE_LATE_MIN ? DOSE_LATE : DOSE_TAKEN;
+}
+
+// "pending" and unknown statuses are not outcomes and change nothing. The
+// minder does not say when a dose was taken, so only a confirmation seen here
+// can count it late.
+void recordDoseStatus(const DailySchedule& item) {
+  if (item.status == "completed") {
+    adherenceRecord(item.reminder_id, item.time, item.medicine, DOSE_TAKEN);
+  } else if (item.status == "missed" || item.status == "skipped") {
+    adherenceRecord(item.reminder_id, item.time, item.medicine, DOSE_MISSED);
+  }
+}
+
+// Latest dose of the reminder due by now; alerts may come a little early
+int findDueDose(int reminderId, DayMinute now) {
+  if (now == MINUTE_NONE) return -1;
+  int found = -1;
+  for (size_t i = 0; i < dailySchedule.size() && dailySchedule[i].time <= now + 15; i++) {
+    if (dailySchedule[i].reminder_id == reminderId) found = i;
+  }
+  return found;
+}
+
+// Every medicine in the take-medicine confirmation that was just answered
+void recordConfirmation(bool taken) {
+  if (pendingConfirmation.type != 0) return;
+  DayMinute now = nowMinute();
+  for (const ReminderItem& item : pendingConfirmation.reminders) {
+    int slot = findDueDose(item.id, now);
+    DayMinute time = slot >= 0 ? dailySchedule[slot].time : now;
+    adherenceRecord(item.id, time, item.medicine, taken ? takenOutcome(time) : DOSE_MISSED);
+  }
+  snapshotMarkDirty();
+}
+
+void closeAdherenceDay() {
+  int missed = 0;
+  for (const DailySchedule& item : dailySchedule) {
+    if (item.status != "completed" && adherenceOutcome(item.reminder_id, item.time) == DOSE_NONE) {
+      adherenceRecord(item.reminder_id, item.time, item.medicine, DOSE_MISSED);
+      missed++;
+    }
+  }
+  adherenceRollDay();
+  snapshotMarkDirty();
+  LOG_INFO("Adherence: day closed, %d open doses counted missed", missed);
+}
+
+// ==================== DOSE TIMES ====================
+
+// Stable insertion sort; the minder usually sends the day in order already
+void sortScheduleByTime() {
+  for (size_t i = 1; i < dailySchedule.size(); i++) {
+    DailySchedule item = dailySchedule[i];
+    size_t j = i;
+    for (; j > 0 && dailySchedule[j - 1].time > item.time; j--) {
+      dailySchedule[j] = dailySchedule[j - 1];
+    }
+    dailySchedule[j] = item;
+  }
+}
+
+// Minute of the day from the last current_time, or MINUTE_NONE before one
+DayMinute nowMinute() {
+  if (clockMinute == MINUTE_NONE) return MINUTE_NONE;
+  return (clockMinute + (millis() - clockSetAt) / 60000) % MINUTES_PER_DAY;
+}
+
+// First schedule slot at or after time
+size_t scheduleLowerBound(DayMinute time) {
+  size_t lo = 0;
+  size_t hi = dailySchedule.size();
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    if (dailySchedule[mid].time < time) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+int findScheduleItem(int reminderId, DayMinute time) {
+  if (time == MINUTE_NONE) return -1;
+  for (size_t i = scheduleLowerBound(time); i < dailySchedule.size() && dailySchedule[i].time == time; i++) {
+    if (dailySchedule[i].reminder_id == reminderId) return i;
+  }
+  return -1;
+}
+
+// First dose at or after now that is not completed; -1 if none is left today
+int findNextDose(DayMinute now) {
+  for (size_t i = scheduleLowerBound(now); i < dailySchedule.size() && dailySchedule[i].time != MINUTE_NONE; i++) {
+    if (dailySchedule[i].status != "completed") return i;
+  }
+  return -1;
+}
+
+// "Next 14:00 Aspirin (2h 15m)" for the home screen; empty without a clock
+void formatNextDose(char* out, size_t size) {
+  DayMinute now = nowMinute();
+  if (now == MINUTE_NONE) {
+    out[0] = '\0';
+    return;
+  }
+  
+  int next = findNextDose(now);
+  if (next < 0) {
+    snprintf(out, size, "No more doses today");
+    return;
+  }
+  
+  char timeText[6];
+  formatDayMinute(dailySchedule[next].time, timeText);
+  int wait = dailySchedule[next].time - now;
+  if (wait >= 60) {
+    snprintf(out, size, "Next %s %s (%dh %02dm)", timeText, nameText(dailySchedule[next].medicine), wait / 60, wait % 60);
+  } else {
+    snprintf(out, size, "Next %s %s (%dm)", timeText, nameText(dailySchedule[next].medicine), wait);
+  }
+}
+
+// ==================== MODEL STATS ====================
+
+void modelSubscribe(uint8_t changes, ModelListener listener) {
+  if (modelListenerCount >= MODEL_LISTENER_MAX) {
+    LOG_ERROR("Too many model listeners");
+    return;
+  }
+  modelListeners[modelListenerCount].changes = changes;
+  modelListeners[modelListenerCount].listener = listener;
+  modelListenerCount++;
+}
+
+void modelNotify(uint8_t changes) {
+  for (int i = 0; i < modelListenerCount; i++) {
+    if (modelListeners[i].changes & changes) modelListeners[i].listener(changes);
+  }
+}
+
+// Adds (sign 1) or removes (sign -1) one container's share of the counts
+void countContainer(const Container& container, int sign) {
+  if (container.current_capacity > 0) modelStats.activeContainers += sign;
+  if (container.low_stock) modelStats.lowStockContainers += sign;
+}
+
+// Full recounts only run when a whole block is replaced
+void recountContainers() {
+  modelStats.activeContainers = 0;
+  modelStats.lowStockContainers = 0;
+  for (size_t i = 0; i < containers.size(); i++) countContainer(containers[i], 1);
+}
+
+void recountReminders() {
+  modelStats.activeReminders = 0;
+  for (size_t i = 0; i < reminders.size(); i++) {
+    if (reminders[i].active) modelStats.activeReminders++;
+  }
+}
+
+void recountSchedule() {
+  modelStats.pendingDoses = 0;
+  for (size_t i = 0; i < dailySchedule.size(); i++) {
+    if (dailySchedule[i].status != "completed") modelStats.pendingDoses++;
+  }
+}
+
+// Point update of one container's stock, keeping the counts in step
+void setContainerStock(Container* container, int capacity, bool lowStock) {
+  if (container->current_capacity == capacity && container->low_stock == lowStock) return;
+  
+  countContainer(*container, -1);
+  container->current_capacity = capacity;
+  container->low_stock = lowStock;
+  countContainer(*container, 1);
+  markContainerDirty(container);
+  modelNotify(CHANGE_STOCK);
+}
+
+void onContainersChanged(uint8_t changes) {
+  if (changes & CHANGE_CONTAINERS) containersScreenStale = true;
+  containersHeaderStale = true;
+}
+
+void onRemindersChanged(uint8_t changes) {
+  remindersScreenStale = true;
+}
+
+void onScheduleChanged(uint8_t changes) {
+  scheduleScreenStale = true;
+}
+
+void subscribeScreens() {
+  modelSubscribe(CHANGE_CONTAINERS | CHANGE_STOCK, onContainersChanged);
+  modelSubscribe(CHANGE_REMINDERS, onRemindersChanged);
+  modelSubscribe(CHANGE_SCHEDULE, onScheduleChanged);
+}
+
+// ==================== LOCAL REMINDERS ====================
+
+// One daily timer per active reminder time, tagged with the reminder's slot
+void rebuildReminderTimers() {
+  timerWheelClear();
+  for (size_t i = 0; i < reminders.size(); i++) {
+    const Reminder& reminder = reminders[i];
+    if (!reminder.active) continue;
+    for (int t = 0; t < reminder.timeCount; t++) {
+      if (!timerAdd(reminderTimes[reminder.firstTime + t].time, i)) {
+        LOG_WARN("No room for reminder timers, local alerts incomplete");
+        return;
+      }
+    }
+  }
+  LOG_DEBUG("Armed %u reminder timers", (unsigned)timerCount());
+}
+
+bool minderOnline() {
+  return lastMinderFrameAt != 0 && millis() - lastMinderFrameAt < MINDER_SILENT_MS;
+}
+
+// Pills due for reminder at minute, 1 if none of its times match
+int reminderDosage(const Reminder& reminder, DayMinute minute) {
+  for (int t = 0; t < reminder.timeCount; t++) {
+    const ReminderTime& time = reminderTimes[reminder.firstTime + t];
+    if (time.time == minute) return time.dosage;
+  }
+  return 1;
+}
+
+void onReminderDue(uint16_t slot, DayMinute minute) {
+  if (slot >= reminders.size()) return;
+  const Reminder& reminder = reminders[slot];
+  if (minderAlerted(reminder.medicine, minute)) {
+    LOG_DEBUG("Reminder %d due, minder already alerted", reminder.id);
+    return;
+  }
+  
+  int free = -1;
+  for (int i = 0; i < LOCAL_ALERT_MAX; i++) {
+    if (!localAlerts[i].used) {
+      free = i;
+      break;
+    }
+  }
+  if (free < 0) {
+    LOG_WARN("Local alert queue full, reminder %d not tracked", reminder.id);
+    return;
+  }
+  
+  // Show right away if the minder is silent, otherwise give it the grace period
+  LocalAlert& alert = localAlerts[free];
+  alert.used = true;
+  alert.reminderId = reminder.id;
+  alert.medicine = reminder.medicine;
+  alert.minute = minute;
+  alert.dosage = reminderDosage(reminder, minute);
+  alert.dueAt = millis() + (minderOnline() ? LOCAL_ALERT_GRACE_MS : 0);
+  alert.shown = false;
+  alert.dismissed = false;
+  LOG_INFO("Reminder %d due (%s)", reminder.id, nameText(reminder.medicine));
+}
+
+// The minder alerted for this medicine itself (NAME_NONE: for everything due).
+// Drops the local alerts waiting for it and remembers it for timers still to fire.
+void cancelLocalAlerts(NameId medicine) {
+  for (int i = 0; i < LOCAL_ALERT_MAX; i++) {
+    LocalAlert& alert = localAlerts[i];
+    if (alert.used && !alert.shown && (medicine == NAME_NONE || alert.medicine == medicine)) {
+      alert.used = false;
+    }
+  }
+  
+  DayMinute now = nowMinute();
+  if (now == MINUTE_NONE) return;
+  MinderAlert& covered = minderAlerts[minderAlertNext];
+  covered.medicine = medicine;
+  covered.minute = now;
+  covered.at = millis();
+  minderAlertNext = (minderAlertNext + 1) % LOCAL_ALERT_MAX;
+  if (minderAlertCount < LOCAL_ALERT_MAX) minderAlertCount++;
+}
+
+// The minder alerted for medicine in the last few minutes, at most
+// LOCAL_ALERT_COVER_MIN before minute
+bool minderAlerted(NameId medicine, DayMinute minute) {
+  for (int i = 0; i < minderAlertCount; i++) {
+    const MinderAlert& covered = minderAlerts[i];
+    if (millis() - covered.at > (LOCAL_ALERT_COVER_MIN + 1) * 60000UL) continue;
+    if (covered.medicine != NAME_NONE && covered.medicine != medicine) continue;
+    int ahead = (minute + MINUTES_PER_DAY - covered.minute) % MINUTES_PER_DAY;
+    if (ahead <= LOCAL_ALERT_COVER_MIN) return true;
+  }
+  return false;
+}
+
+void pollLocalAlerts() {
+  for (int i = 0; i < LOCAL_ALERT_MAX; i++) {
+    LocalAlert& alert = localAlerts[i];
+    if (!alert.used) continue;
+    
+    if (!alert.shown && (long)(millis() - alert.dueAt) >= 0 && !alarmActive) {
+      const Reminder* reminder = findReminder(alert.reminderId);
+      
+      char timeText[6];
+      formatDayMinute(alert.minute, timeText);
+      strlcpy(alertSource, "display", sizeof(alertSource));
+      strlcpy(alertOperationMode, "offline", sizeof(alertOperationMode));
+      showReminderAlert(nameText(alert.medicine), reminder ? reminder->container_id : 0,
+                        alert.dosage,
+                        "local", "Time to take your medicine", timeText);
+      alert.shown = true;
+      shownLocalAlert = i;
+      journalAppend(JOURNAL_LOCAL_ALERT, reminder ? reminder->container_id : 0, alert.reminderId, alert.minute);
+      LOG_INFO("Local alert for reminder %d at %s", alert.reminderId, timeText);
+    }
+    
+    // Tell a returning minder what was shown while it was away
+    if (alert.shown && shownLocalAlert != i && minderOnline()) {
+      if (linkHasFeature(LINK_FEAT_OFFLINE_REMINDERS)) {
+        OfflineReminderMsg report;
+        report.reminder_id = alert.reminderId;
+        char timeText[6];
+        formatDayMinute(alert.minute, timeText);
+        report.reminder_time = timeText;
+        report.dismissed = alert.dismissed;
+        sendToMinder(report);
+      }
+      alert.used = false;
+    }
+  }
+}
+
+// Slot of id among the first count rows; ids past the index capacity are
+// found by a scan
+int containerSlot(int id, size_t count) {
+  int slot = containerIndex.find(id);
+  if (slot < 0 && containerIndexFull) {
+    for (size_t i = 0; i < count; i++) {
+      if (containers[i].id == id) return i;
+    }
+  }
+  return slot;
+}
+
+int reminderSlot(int id, size_t count) {
+  int slot = reminderIndex.find(id);
+  if (slot < 0 && reminderIndexFull) {
+    for (size_t i = 0; i < count; i++) {
+      if (reminders[i].id == id) return i;
+    }
+  }
+  return slot;
+}
+
+Container* findContainer(int id) {
+  int slot = containerSlot(id, containers.size());
+  return slot >= 0 ? &containers[slot] : nullptr;
+}
+
+const Reminder* findReminder(int id) {
+  int slot = reminderSlot(id, reminders.size());
+  return slot >= 0 ? &reminders[slot] : nullptr;
+}
+
+// Point update from an alert: the row needs repainting, and the next
+// containers_info must be applied even if it matches the last one
+void markContainerDirty(Container* container) {
+  container->dirty = true;
+  containersHash = 0;
+  snapshotMarkDirty();
+}
+
+// Called by the name table when it needs room: every name the model still
+// refers to must be marked, the rest are freed
+void markLiveNames() {
+  for (const Container& item : containers) nameMark(item.medicine);
+  for (const Reminder& item : reminders) nameMark(item.medicine);
+  for (const DailySchedule& item : dailySchedule) nameMark(item.medicine);
+  for (const ReminderItem& item : pendingConfirmation.reminders) nameMark(item.medicine);
+  nameMark(pendingConfirmation.control.medicine);
+  nameMark(dispensingMedicine);
+  nameMark(jamAlertMedicine);
+  // Local alerts still waiting, and the minder alerts they are matched against
+  for (const LocalAlert& alert : localAlerts) {
+    if (alert.used) nameMark(alert.medicine);
+  }
+  for (int i = 0; i < minderAlertCount; i++) nameMark(minderAlerts[i].medicine);
+  adherenceMarkNames();
+}
+
+// ==================== MODEL SNAPSHOT ====================
+
+// Values kept next to the collections so a reboot does not redraw or
+// re-sync blocks the minder sends again unchanged
+struct SnapshotStatus {
+  uint32_t containersHash;
+  uint32_t remindersHash;
+  uint32_t scheduleHash;
+  uint32_t sensorHash;
+  float temperature;
+  float humidity;
+};
+
+// Changes whenever a saved record changes size, so an old snapshot is
+// ignored after a firmware update instead of misread
+uint32_t snapshotLayout() {
+  MsgHash h;
+  h.add((uint32_t)sizeof(Container));
+  h.add((uint32_t)sizeof(Reminder));
+  h.add((uint32_t)sizeof(DailySchedule));
+  h.add((uint32_t)sizeof(ReminderItem));
+  h.add((uint32_t)sizeof(ReminderTime));
+  h.add((uint32_t)sizeof(SnapshotStatus));
+  h.add((uint32_t)MODEL_ARENA_SIZE);
+  h.add((uint32_t)SEG_COUNT);
+  h.add((uint32_t)NAME_TABLE_SIZE);
+  h.add((uint32_t)NAME_POOL_SIZE);
+  h.add((uint32_t)adherenceStateSize());
+  return h.value();
+}
+
+void saveModelSnapshot() {
+  if (!snapshotBegin(snapshotLayout())) return;
+  
+  SnapshotStatus status = {containersHash, remindersHash, scheduleHash, sensorHash,
+                           currentTemperature, currentHumidity};
+  snapshotPut(&status, sizeof(status));
+  nameTableSave();
+  arenaSave();
+  adherenceSave();
+  snapshotEnd();
+}
+
+bool loadModelSnapshot() {
+  if (!snapshotOpen(snapshotLayout())) return false;
+  
+  SnapshotStatus status;
+  bool ok = snapshotGet(&status, sizeof(status)) && nameTableLoad() && arenaLoad() && adherenceLoad();
+  snapshotClose();
+  if (!ok) {
+    LOG_WARN("Snapshot: truncated, starting empty");
+    containers.clear();
+    reminders.clear();
+    reminderTimes.clear();
+    dailySchedule.clear();
+    adherenceReset();
+    return false;
+  }
+  
+  containersHash = status.containersHash;
+  remindersHash = status.remindersHash;
+  scheduleHash = status.scheduleHash;
+  sensorHash = status.sensorHash;
+  currentTemperature = status.temperature;
+  currentHumidity = status.humidity;
+  pendingConfirmation.reminders.clear();  // only meaningful while on screen
+  rebuildIdIndexes();
+  rebuildReminderTimers();
+  recountContainers();
+  recountReminders();
+  recountSchedule();
+  modelNotify(CHANGE_CONTAINERS | CHANGE_REMINDERS | CHANGE_SCHEDULE);
+  return true;
+}
+
+void rebuildIdIndexes() {
+  containerIndex.clear();
+  containerIndexFull = false;
+  for (size_t i = 0; i < containers.size(); i++) {
+    if (!containerIndex.put(containers[i].id, i)) containerIndexFull = true;
+  }
+  reminderIndex.clear();
+  reminderIndexFull = false;
+  for (size_t i = 0; i < reminders.size(); i++) {
+    if (!reminderIndex.put(reminders[i].id, i)) reminderIndexFull = true;
+  }
+}
+
+void handleTouchInput() {
   if (ts.touched()) {
     TS_Point p = ts.getPoint();
     
@@ -789,7 +1775,7 @@ void handleTouchInput() {
     int x = map(p.x, 200, 3700, 0, tft.width());
     int y = map(p.y, 240, 3800, 0, tft.height());
 
-    Serial.printf("Touch at (%d, %d)\n", x, y);
+    LOG_DEBUG("Touch at (%d, %d)", x, y);
     
     // Handle touch based on current state
     switch (currentState) {
@@ -805,6 +1791,15 @@ void handleTouchInput() {
       case STATE_SCHEDULE:
         handleScheduleTouch(x, y);
         break;
+      case STATE_HISTORY:
+        handleHistoryTouch(x, y);
+        break;
+      case STATE_SENSOR_CHART:
+        handleSensorChartTouch(x, y);
+        break;
+      case STATE_ADHERENCE:
+        handleAdherenceTouch(x, y);
+        break;
       case STATE_ALARM:
         handleAlarmTouch(x, y);
         break;
@@ -836,8 +1831,29 @@ void handleTouchInput() {
 }
 
 void handleHomeTouch(int x, int y) {
+  // History button (bottom right)
+  if (x >= tft.width() - 110 && x <= tft.width() - 10 && y >= tft.height() - 50 && y <= tft.height() - 20) {
+    historyScreenStale = true;
+    currentState = STATE_HISTORY;
+    return;
+  }
+  
+  // Adherence button (bottom left)
+  if (x >= 10 && x <= 130 && y >= tft.height() - 50 && y <= tft.height() - 20) {
+    adherenceScreenStale = true;
+    currentState = STATE_ADHERENCE;
+    return;
+  }
+  
   // View All Reminders button (pink box area)
   int reminderButtonY = 120; // Approximate Y for "View All Reminders" button
+  
+  // Temperature / humidity readout opens the chart
+  if (x < 240 && y >= 60 && y < reminderButtonY) {
+    chartScreenStale = true;
+    currentState = STATE_SENSOR_CHART;
+    return;
+  }
   if (x >= 10 && x <= tft.width() - 20 && y >= reminderButtonY && y <= reminderButtonY + 30) {
     currentState = STATE_REMINDERS;
   }
@@ -846,7 +1862,7 @@ void handleHomeTouch(int x, int y) {
   int queueButtonY = 430; // Approximate Y for "View All Queues" button
   if (x >= 10 && x <= tft.width() - 20 && y >= queueButtonY && y <= queueButtonY + 30) {
     // Handle view all queues
-    Serial.println("Clicked View All Queues");
+    LOG_DEBUG("Clicked View All Queues");
   }
 }
 
@@ -854,6 +1870,8 @@ void handleContainersTouch(int x, int y) {
   // Back button (top left)
   if (x >= buttonMargin && x <= buttonMargin + 60 && y >= buttonMargin && y <= buttonMargin + 30) {
     currentState = STATE_HOME;
+  } else if (handlePagerTouch(x, y, containers.size(), rowsPerPage(50))) {
+    redrawDataScreen();
   }
 }
 
@@ -861,6 +1879,46 @@ void handleRemindersTouch(int x, int y) {
   // Back button (top left)
   if (x >= buttonMargin && x <= buttonMargin + 60 && y >= buttonMargin && y <= buttonMargin + 30) {
     currentState = STATE_HOME;
+  } else if (handlePagerTouch(x, y, getActiveReminderCount(), rowsPerPage(45))) {
+    redrawDataScreen();
+  }
+}
+
+void handleHistoryTouch(int x, int y) {
+  // Back button (top left)
+  if (x >= buttonMargin && x <= buttonMargin + 60 && y >= buttonMargin && y <= buttonMargin + 30) {
+    currentState = STATE_HOME;
+  } else if (handlePagerTouch(x, y, historyCount, rowsPerPage(30))) {
+    historyScreenStale = true;
+  }
+}
+
+void handleAdherenceTouch(int x, int y) {
+  // Back button (top left)
+  if (x >= buttonMargin && x <= buttonMargin + 60 && y >= buttonMargin && y <= buttonMargin + 30) {
+    currentState = STATE_HOME;
+  }
+}
+
+// Tier buttons and the temperature / humidity toggle along the bottom
+void handleSensorChartTouch(int x, int y) {
+  // Back button (top left)
+  if (x >= buttonMargin && x <= buttonMargin + 60 && y >= buttonMargin && y <= buttonMargin + 30) {
+    currentState = STATE_HOME;
+    return;
+  }
+  
+  int buttonY = tft.height() - 60;
+  if (y < buttonY || y > buttonY + 40) return;
+  for (int t = 0; t < TIER_COUNT; t++) {
+    if (x >= 10 + t * 80 && x <= 80 + t * 80) {
+      chartTier = (SensorTier)t;
+      chartScreenStale = true;
+    }
+  }
+  if (x >= 250 && x <= 310) {
+    chartHumidity = !chartHumidity;
+    chartScreenStale = true;
   }
 }
 
@@ -868,6 +1926,8 @@ void handleScheduleTouch(int x, int y) {
   // Back button (top left)
   if (x >= buttonMargin && x <= buttonMargin + 60 && y >= buttonMargin && y <= buttonMargin + 30) {
     currentState = STATE_HOME;
+  } else if (handlePagerTouch(x, y, dailySchedule.size(), rowsPerPage(40))) {
+    redrawDataScreen();
   }
 }
 
@@ -878,6 +1938,10 @@ void handleAlarmTouch(int x, int y) {
   if (x >= buttonX && x <= buttonX + 100 && y >= buttonY && y <= buttonY + 40) {
     currentState = STATE_HOME;
     alarmActive = false;
+    if (shownLocalAlert >= 0) {
+      localAlerts[shownLocalAlert].dismissed = true;
+      shownLocalAlert = -1;
+    }
   }
 }
 
@@ -903,14 +1967,12 @@ void handleTakeMedicineTouch(int x, int y) {
   int confirmY = tft.height() - 70;
   if (x >= confirmX && x <= confirmX + 145 && y >= confirmY && y <= confirmY + 60) {
     // Send confirmation response
-    StaticJsonDocument<512> doc;
-    doc["type"] = "confirmation_response";
-    doc["confirmed"] = true;
-    doc["confirmation_type"] = pendingConfirmation.type;
-    
-    String jsonStr;
-    serializeJson(doc, jsonStr);
-    SerialPort.println(jsonStr);
+    ConfirmationResponseMsg response;
+    response.confirmed = true;
+    response.confirmation_type = pendingConfirmation.type;
+    outboxSend(response, nowMinute());
+    journalConfirmation(JOURNAL_CONFIRM);
+    recordConfirmation(true);
     
     hasPendingConfirmation = false;
     currentState = STATE_DISPENSING;
@@ -922,14 +1984,12 @@ void handleTakeMedicineTouch(int x, int y) {
   int cancelY = tft.height() - 70;
   if (x >= cancelX && x <= cancelX + 145 && y >= cancelY && y <= cancelY + 60) {
     // Send cancel response
-    StaticJsonDocument<512> doc;
-    doc["type"] = "confirmation_response";
-    doc["confirmed"] = false;
-    doc["confirmation_type"] = pendingConfirmation.type;
-    
-    String jsonStr;
-    serializeJson(doc, jsonStr);
-    SerialPort.println(jsonStr);
+    ConfirmationResponseMsg response;
+    response.confirmed = false;
+    response.confirmation_type = pendingConfirmation.type;
+    outboxSend(response, nowMinute());
+    journalConfirmation(JOURNAL_CANCEL);
+    recordConfirmation(false);
     
     hasPendingConfirmation = false;
     currentState = STATE_HOME;
@@ -943,13 +2003,9 @@ void handleQuantityConfirmationTouch(int x, int y) {
   int yesY = tft.height() - 60;
   if (x >= yesX && x <= yesX + 100 && y >= yesY && y <= yesY + 40) {
     // Send quantity confirmed
-    StaticJsonDocument<256> doc;
-    doc["type"] = "quantity_confirmed";
-    doc["confirmed"] = true;
-    
-    String jsonStr;
-    serializeJson(doc, jsonStr);
-    SerialPort.println(jsonStr);
+    QuantityConfirmedMsg confirmed;
+    confirmed.confirmed = true;
+    outboxSend(confirmed, nowMinute());
     
     currentState = STATE_HOME;
     return;
@@ -960,21 +2016,17 @@ void handleQuantityConfirmationTouch(int x, int y) {
   int oneMoreY = tft.height() - 60;
   if (x >= oneMoreX && x <= oneMoreX + 100 && y >= oneMoreY && y <= oneMoreY + 40) {
     // Check if multiple containers
-    if (hasPendingConfirmation && pendingConfirmation.reminder_count > 1) {
+    if (hasPendingConfirmation && pendingConfirmation.reminders.size() > 1) {
       // Multiple containers - show selection screen
       currentState = STATE_CONTAINER_SELECTION;
     } else {
       // Single container - dispense directly
-      if (hasPendingConfirmation && pendingConfirmation.reminder_count > 0) {
-        StaticJsonDocument<256> doc;
-        doc["type"] = "dispensing_request";
-        doc["container_id"] = pendingConfirmation.reminders[0].container_id;
-        doc["dosage"] = 1;
-        doc["medicine_name"] = pendingConfirmation.reminders[0].medicine_name;
-        
-        String jsonStr;
-        serializeJson(doc, jsonStr);
-        SerialPort.println(jsonStr);
+      if (hasPendingConfirmation && pendingConfirmation.reminders.size() > 0) {
+        DispensingRequestMsg request;
+        request.container_id = pendingConfirmation.reminders[0].container_id;
+        request.dosage = 1;
+        request.medicine_name = nameText(pendingConfirmation.reminders[0].medicine);
+        sendToMinder(request);
         
         currentState = STATE_DISPENSING;
       }
@@ -989,13 +2041,9 @@ void handleJamAlertTouch(int x, int y) {
   int continueY = tft.height() - 60;
   if (x >= continueX && x <= continueX + 120 && y >= continueY && y <= continueY + 40) {
     // Send jam cleared
-    StaticJsonDocument<256> doc;
-    doc["type"] = "jam_cleared";
-    doc["container_number"] = jamAlertContainer;
-    
-    String jsonStr;
-    serializeJson(doc, jsonStr);
-    SerialPort.println(jsonStr);
+    JamClearedMsg cleared;
+    cleared.container_number = jamAlertContainer;
+    outboxSend(cleared, nowMinute());
     
     currentState = STATE_DISPENSING;
     return;
@@ -1018,15 +2066,12 @@ void handleControlQueueConfirmationTouch(int x, int y) {
   int confirmY = tft.height() - 70;
   if (x >= confirmX && x <= confirmX + 145 && y >= confirmY && y <= confirmY + 60) {
     // Send confirmation response
-    StaticJsonDocument<512> doc;
-    doc["type"] = "confirmation_response";
-    doc["confirmed"] = true;
-    doc["confirmation_type"] = 1; // device_control
-    doc["control_id"] = pendingConfirmation.control.control_id;
-    
-    String jsonStr;
-    serializeJson(doc, jsonStr);
-    SerialPort.println(jsonStr);
+    ConfirmationResponseMsg response;
+    response.confirmed = true;
+    response.confirmation_type = 1; // device_control
+    response.control_id = pendingConfirmation.control.control_id;
+    outboxSend(response, nowMinute());
+    journalConfirmation(JOURNAL_CONFIRM);
     
     hasPendingConfirmation = false;
     currentState = STATE_HOME;
@@ -1038,15 +2083,12 @@ void handleControlQueueConfirmationTouch(int x, int y) {
   int cancelY = tft.height() - 70;
   if (x >= cancelX && x <= cancelX + 145 && y >= cancelY && y <= cancelY + 60) {
     // Send cancel response
-    StaticJsonDocument<512> doc;
-    doc["type"] = "confirmation_response";
-    doc["confirmed"] = false;
-    doc["confirmation_type"] = 1; // device_control
-    doc["control_id"] = pendingConfirmation.control.control_id;
-    
-    String jsonStr;
-    serializeJson(doc, jsonStr);
-    SerialPort.println(jsonStr);
+    ConfirmationResponseMsg response;
+    response.confirmed = false;
+    response.confirmation_type = 1; // device_control
+    response.control_id = pendingConfirmation.control.control_id;
+    outboxSend(response, nowMinute());
+    journalConfirmation(JOURNAL_CANCEL);
     
     hasPendingConfirmation = false;
     currentState = STATE_HOME;
@@ -1056,10 +2098,17 @@ void handleControlQueueConfirmationTouch(int x, int y) {
 
 void updateDisplay() {
   if (currentState != previousState) {
-    // Clear screen and redraw for new state
-    tft.fillScreen(BACKGROUND_COLOR);
+    // Clear screen and redraw for new state; modal screens paint over the old one
+    if (usesDirtyRegions(currentState)) {
+      dirtyInvalidateAll();
+    } else {
+      tft.fillScreen(BACKGROUND_COLOR);
+    }
     previousState = currentState;
+    listPage = 0;
+    frameAllocWarned = false;
   }
+  uint32_t allocationsBefore = allocCount();
   
   switch (currentState) {
     case STATE_HOME:
@@ -1074,6 +2123,15 @@ void updateDisplay() {
     case STATE_SCHEDULE:
       drawScheduleScreen();
       break;
+    case STATE_HISTORY:
+      drawHistoryScreen();
+      break;
+    case STATE_SENSOR_CHART:
+      drawSensorChartScreen();
+      break;
+    case STATE_ADHERENCE:
+      drawAdherenceScreen();
+      break;
     case STATE_ALARM:
       drawAlarmScreen();
       break;
@@ -1105,6 +2163,13 @@ void updateDisplay() {
       drawControlConfirmation();
       break;
   }
+  
+  // Drawing should never touch the heap; report the first frame per screen that does
+  frameAllocations = allocCount() - allocationsBefore;
+  if (frameAllocations > 0 && !frameAllocWarned) {
+    LOG_WARN("Render: screen %d made %lu heap allocations in one frame", currentState, (unsigned long)frameAllocations);
+    frameAllocWarned = true;
+  }
 }
 
 void showStartupScreen() {
@@ -1118,9 +2183,6 @@ void showStartupScreen() {
   tft.setTextSize(1);
   tft.setCursor(tft.width() / 2 - 40, tft.height() / 2 + 20);
   tft.print("Starting...");
-  
-  delay(2000);
-  tft.fillScreen(BACKGROUND_COLOR);
 }
 
 // ==================== HYBRID ARCHITECTURE UI FUNCTIONS ====================
@@ -1164,8 +2226,9 @@ void showStartupScreen() {
 // }
 
 void drawPendingActionsBadge() {
-  // Only show if there are pending actions
-  if (pendingActionsCount <= 0) return;
+  // Only show if there are pending actions, on the minder or in our outbox
+  int pending = pendingActionsCount + outboxDepth();
+  if (pending <= 0) return;
   
   int badgeWidth = 85;
   int badgeHeight = 18;
@@ -1180,7 +2243,7 @@ void drawPendingActionsBadge() {
   tft.setTextSize(1);
   
   char badgeText[20];
-  snprintf(badgeText, sizeof(badgeText), "%c %d pending", 0xE2, pendingActionsCount); // ⏳
+  snprintf(badgeText, sizeof(badgeText), "%c %d pending", 0xE2, pending); // ⏳
   
   int textX = badgeX + 5;
   int textY = badgeY + 5;
@@ -1217,13 +2280,13 @@ void showToast(const char* message, uint16_t color, int duration) {
 
 void onModeChangeToOffline() {
   // Called when system goes offline
-  Serial.println("MODE CHANGE: Online -> Offline");
+  LOG_INFO("MODE CHANGE: Online -> Offline");
   showToast("Server disconnected", TFT_ORANGE, 2000);
 }
 
 void onModeChangeToOnline(int actionsSynced) {
   // Called when system comes back online
-  Serial.printf("MODE CHANGE: Offline -> Online (%d actions synced)\n", actionsSynced);
+  LOG_INFO("MODE CHANGE: Offline -> Online (%d actions synced)", actionsSynced);
   showToast("Reconnected to server", TFT_GREEN, 2000);
   
   // If actions were synced, show additional toast
@@ -1238,19 +2301,20 @@ void onModeChangeToOnline(int actionsSynced) {
 // ==================== END HYBRID ARCHITECTURE UI FUNCTIONS ====================
 
 void drawHomeScreen() {
-  static String lastTimeString = "";
+  static FixedString<8> lastTimeString;
   static bool lastAPMode = false;
   static bool lastWifiConnected = false;
   static bool lastMqttConnected = false;
   static float lastTemp = -999;
   static float lastHum = -999;
+  static FixedString<47> lastNextDose;
   static DisplayState lastState = STATE_HOME;
   
   // Force redraw if we just switched to this state
   bool stateChanged = (lastState != currentState);
   if (stateChanged) {
     lastState = currentState;
-    lastTimeString = "";
+    lastTimeString.clear();
     lastTemp = -999;
     lastHum = -999;
   }
@@ -1304,6 +2368,18 @@ void drawHomeScreen() {
   tft.setTextColor(mqttColor);
   tft.print(mqttConnected ? "C" : "D");
   
+  // Next dose and countdown, from the sorted schedule
+  char nextDose[48];
+  formatNextDose(nextDose, sizeof(nextDose));
+  if (stateChanged || lastNextDose != nextDose) {
+    tft.fillRect(0, 130, tft.width(), 20, BACKGROUND_COLOR);
+    lastNextDose = nextDose;
+  }
+  tft.setTextColor(TEXT_COLOR);
+  tft.setTextSize(2);
+  tft.setCursor(10, 132);
+  tft.print(nextDose);
+  
   // Sensor data with color coding
   tft.setTextSize(3);
   
@@ -1352,15 +2428,17 @@ void drawHomeScreen() {
   // Hybrid Architecture: Draw mode badge and pending actions (if any)
   // drawModeBadge();
   drawPendingActionsBadge();
+  
+  drawButton(10, tft.height() - 50, 120, 30, "Adherence", HIGHLIGHT_COLOR);
+  drawButton(tft.width() - 110, tft.height() - 50, 100, 30, "History", HIGHLIGHT_COLOR);
 }
 
 void drawContainersScreen() {
-  static int lastContainerCount = -1;
-  
-  // Clear screen if container count changed
-  if (containerCount != lastContainerCount) {
+  // Clear screen if the container list was replaced
+  if (containersScreenStale) {
     tft.fillScreen(BACKGROUND_COLOR);
-    lastContainerCount = containerCount;
+    containersScreenStale = false;
+    containersHeaderStale = true;
   }
   
   // Header
@@ -1369,17 +2447,31 @@ void drawContainersScreen() {
   tft.setCursor(10, 10);
   tft.print("Containers");
   
+  // Low stock count, repainted only when a stock change was notified
+  if (containersHeaderStale) {
+    tft.fillRect(200, 10, tft.width() - 200, 30, BACKGROUND_COLOR);
+    if (modelStats.lowStockContainers > 0) {
+      tft.setTextColor(WARNING_COLOR);
+      tft.setTextSize(2);
+      tft.setCursor(220, 16);
+      tft.printf("%d low", modelStats.lowStockContainers);
+    }
+    containersHeaderStale = false;
+  }
+  
   // Back button
   drawButton(buttonMargin, buttonMargin, 60, 30, "Back", HIGHLIGHT_COLOR);
   
-  // Container list
-  int yPos = 60;
-  for (int i = 0; i < containerCount && yPos < tft.height() - 50; i++) {
-    drawContainerItem(10, yPos, containers[i]);
-    yPos += 50;
+  // Container list - current page only
+  int perPage = rowsPerPage(50);
+  int first = pageStart(containers.size(), perPage);
+  for (int i = first; i < (int)containers.size() && i < first + perPage; i++) {
+    drawContainerItem(10, containerRowY(i), containers[i]);
+    containers[i].dirty = false;
   }
+  drawPager(containers.size(), perPage);
   
-  if (containerCount == 0) {
+  if (containers.empty()) {
     tft.setTextColor(TEXT_COLOR);
     tft.setTextSize(2);
     tft.setCursor(10, 80);
@@ -1387,14 +2479,34 @@ void drawContainersScreen() {
   }
 }
 
+int containerRowY(int slot) {
+  return LIST_TOP + (slot - listPage * rowsPerPage(50)) * 50;
+}
+
+// Redraws only the visible container rows changed by point updates
+void repaintDirtyRows() {
+  if (currentState != STATE_CONTAINERS) return;
+  
+  int perPage = rowsPerPage(50);
+  int first = listPage * perPage;
+  for (int i = first; i < (int)containers.size() && i < first + perPage; i++) {
+    if (!containers[i].dirty) continue;
+    if (applyingBatch) {
+      redrawPending = true;
+      return;
+    }
+    tft.fillRect(10, containerRowY(i), tft.width() - 20, 45, BACKGROUND_COLOR);
+    drawContainerItem(10, containerRowY(i), containers[i]);
+    containers[i].dirty = false;
+  }
+}
+
 void drawRemindersScreen() {
-  static int lastReminderCount = -1;
-  
-  // Clear screen if reminder count changed
-  int activeCount = getActiveReminderCount();
-  if (activeCount != lastReminderCount) {
+  // Clear screen if the reminders changed
+  int activeCount = modelStats.activeReminders;
+  if (remindersScreenStale) {
     tft.fillScreen(BACKGROUND_COLOR);
-    lastReminderCount = activeCount;
+    remindersScreenStale = false;
   }
   
   // Header
@@ -1406,14 +2518,18 @@ void drawRemindersScreen() {
   // Back button
   drawButton(buttonMargin, buttonMargin, 60, 30, "Back", HIGHLIGHT_COLOR);
   
-  // Reminder list
-  int yPos = 60;
-  for (int i = 0; i < reminderCount && yPos < tft.height() - 50; i++) {
-    if (reminders[i].active) {
-      drawReminderItem(10, yPos, reminders[i]);
-      yPos += 45;
-    }
+  // Reminder list - active reminders on the current page only
+  int perPage = rowsPerPage(45);
+  int first = pageStart(activeCount, perPage);
+  int n = 0;
+  int yPos = LIST_TOP;
+  for (size_t i = 0; i < reminders.size() && n < first + perPage; i++) {
+    if (!reminders[i].active) continue;
+    if (n++ < first) continue;
+    drawReminderItem(10, yPos, reminders[i]);
+    yPos += 45;
   }
+  drawPager(activeCount, perPage);
   
   if (activeCount == 0) {
     tft.setTextColor(TEXT_COLOR);
@@ -1424,12 +2540,10 @@ void drawRemindersScreen() {
 }
 
 void drawScheduleScreen() {
-  static int lastScheduleCount = -1;
-  
-  // Clear screen if schedule count changed
-  if (scheduleCount != lastScheduleCount) {
+  // Clear screen if the schedule changed
+  if (scheduleScreenStale) {
     tft.fillScreen(BACKGROUND_COLOR);
-    lastScheduleCount = scheduleCount;
+    scheduleScreenStale = false;
   }
   
   // Header
@@ -1438,17 +2552,26 @@ void drawScheduleScreen() {
   tft.setCursor(10, 10);
   tft.print("Schedule");
   
+  // Doses still to take today
+  tft.setTextColor(WARNING_COLOR, BACKGROUND_COLOR);
+  tft.setTextSize(2);
+  tft.setCursor(220, 16);
+  tft.printf("%2d left", modelStats.pendingDoses);
+  
   // Back button
   drawButton(buttonMargin, buttonMargin, 60, 30, "Back", HIGHLIGHT_COLOR);
   
-  // Schedule list
-  int yPos = 60;
-  for (int i = 0; i < scheduleCount && yPos < tft.height() - 50; i++) {
+  // Schedule list - current page only
+  int perPage = rowsPerPage(40);
+  int first = pageStart(dailySchedule.size(), perPage);
+  int yPos = LIST_TOP;
+  for (int i = first; i < (int)dailySchedule.size() && i < first + perPage; i++) {
     drawScheduleItem(10, yPos, dailySchedule[i]);
     yPos += 40;
   }
+  drawPager(dailySchedule.size(), perPage);
   
-  if (scheduleCount == 0) {
+  if (dailySchedule.empty()) {
     tft.setTextColor(TEXT_COLOR);
     tft.setTextSize(2);
     tft.setCursor(10, 80);
@@ -1456,126 +2579,523 @@ void drawScheduleScreen() {
   }
 }
 
-void drawAlarmScreen() {
-  tft.fillScreen(ALARM_COLOR);
-  tft.setTextColor(TFT_WHITE);
-  tft.setTextSize(4);
-  
-  // Alarm title
-  tft.setCursor(tft.width() / 2 - 75, 40);
-  tft.print("ALERT!");
+// Redrawn only when opened, paged or when an event is added, since every row
+// is read back from flash
+void drawHistoryScreen() {
+  uint32_t end = journalEnd();
+  if (!historyScreenStale && end == historyDrawnEnd) return;
+  historyScreenStale = false;
+  historyDrawnEnd = end;
   
+  tft.fillScreen(BACKGROUND_COLOR);
+  tft.setTextColor(TEXT_COLOR);
   tft.setTextSize(3);
-  tft.setCursor(20, 100);
-  tft.print("Medicine");
-  tft.setCursor(20, 130);
-  tft.print("Time");
+  tft.setCursor(90, 10);
+  tft.print("History");
+  drawButton(buttonMargin, buttonMargin, 60, 30, "Back", HIGHLIGHT_COLOR);
   
-  // Medicine info
+  // Walk back from the newest event: count earlier pages, draw this one
+  int perPage = rowsPerPage(30);
+  int first = listPage * perPage;
+  int yPos = LIST_TOP;
+  int n = 0;
+  uint32_t cursor = end;
+  JournalEvent event;
+  while (n < HISTORY_MAX_ROWS && journalPrev(cursor, event)) {
+    if (n >= first && n < first + perPage) {
+      drawHistoryItem(10, yPos, event);
+      yPos += 30;
+    }
+    n++;
+  }
+  historyCount = n;
+  drawPager(historyCount, perPage);
+  
+  if (historyCount == 0) {
+    tft.setTextColor(TEXT_COLOR);
+    tft.setTextSize(2);
+    tft.setCursor(10, 80);
+    tft.print("No events yet");
+  }
+}
+
+// "08:05 Dispensed   C2 x1"
+void drawHistoryItem(int x, int y, const JournalEvent& event) {
+  char timeText[6];
+  formatDayMinute(event.minute, timeText);
+  uint16_t color = (event.type == JOURNAL_JAM || event.type == JOURNAL_TIMEOUT) ? WARNING_COLOR : TEXT_COLOR;
+  tft.setTextColor(color);
   tft.setTextSize(2);
-  tft.setCursor(20, 170);
-  if (!alarmMessage.isEmpty()) {
-    tft.print(alarmMessage);
+  tft.setCursor(x, y);
+  tft.printf("%s %-11s", timeText, journalTypeName(event.type));
+  if (event.container) tft.printf(" C%d", event.container);
+  if (event.type == JOURNAL_DISPENSE) tft.printf(" x%d", event.value);
+  if (event.type == JOURNAL_JAM) tft.printf(" %d left", event.value);
+}
+
+// Only reads the running totals, so redrawing after every dose is cheap
+void drawAdherenceScreen() {
+  uint32_t version = adherenceVersion();
+  if (!adherenceScreenStale && version == adherenceDrawnVersion) return;
+  adherenceScreenStale = false;
+  adherenceDrawnVersion = version;
+  
+  tft.fillScreen(BACKGROUND_COLOR);
+  tft.setTextColor(TEXT_COLOR);
+  tft.setTextSize(3);
+  tft.setCursor(90, 10);
+  tft.print("Adherence");
+  drawButton(buttonMargin, buttonMargin, 60, 30, "Back", HIGHLIGHT_COLOR);
+  
+  drawAdherenceWindow(56, "7 days: ", adherenceTotal(false));
+  drawAdherenceWindow(92, "30 days:", adherenceTotal(true));
+  
+  // Last 7 days, oldest first, bar height by percent taken
+  for (int i = 0; i < ADHERENCE_WEEK; i++) {
+    int daysAgo = ADHERENCE_WEEK - 1 - i;
+    int percent = adherencePercent(adherenceDay(daysAgo));
+    int x = 20 + i * 42;
+    if (percent < 0) {
+      tft.drawRect(x, 135, 34, 60, TFT_DARKGREY);
+    } else {
+      int h = max(percent * 60 / 100, 2);
+      tft.fillRect(x, 195 - h, 34, h, adherenceColor(percent));
+    }
+    tft.setTextColor(TEXT_COLOR);
+    tft.setTextSize(1);
+    tft.setCursor(x + 4, 200);
+    if (daysAgo == 0) {
+      tft.print("today");
+    } else {
+      tft.printf("-%dd", daysAgo);
+    }
+  }
+  
+  // Per medicine, those with doses in the last 30 days
+  tft.setTextSize(2);
+  tft.setTextColor(TEXT_COLOR);
+  tft.setCursor(10, 220);
+  tft.print("Medicine      7d   30d");
+  int yPos = 244;
+  for (int slot = 0; slot <= ADHERENCE_OTHER; slot++) {
+    int month = adherencePercent(adherenceForMedicine(slot, true));
+    if (month < 0) continue;
+    int week = adherencePercent(adherenceForMedicine(slot, false));
+    const char* name = slot == ADHERENCE_OTHER ? "Other" : nameText(adherenceMedicine(slot));
+    tft.setTextColor(TEXT_COLOR);
+    tft.setCursor(10, yPos);
+    tft.printf("%-12.12s", name);
+    tft.setTextColor(adherenceColor(week));
+    tft.setCursor(166, yPos);
+    if (week < 0) {
+      tft.print("  --");
+    } else {
+      tft.printf("%3d%%", week);
+    }
+    tft.setTextColor(adherenceColor(month));
+    tft.setCursor(226, yPos);
+    tft.printf("%3d%%", month);
+    yPos += 22;
+  }
+}
+
+// "7 days:  92%" and the counts under it
+void drawAdherenceWindow(int y, const char* label, const AdherenceCounts& counts) {
+  int percent = adherencePercent(counts);
+  tft.setTextSize(2);
+  tft.setTextColor(TEXT_COLOR);
+  tft.setCursor(10, y);
+  tft.print(label);
+  tft.setTextColor(adherenceColor(percent));
+  if (percent < 0) {
+    tft.print(" --");
+  } else {
+    tft.printf(" %d%%", percent);
+  }
+  tft.setTextColor(TEXT_COLOR);
+  tft.setTextSize(1);
+  tft.setCursor(10, y + 20);
+  tft.printf("%u on time, %u late, %u missed", counts.taken, counts.late, counts.missed);
+}
+
+uint16_t adherenceColor(int percent) {
+  if (percent < 0) return TFT_DARKGREY;
+  if (percent >= 90) return SUCCESS_COLOR;
+  if (percent >= 70) return WARNING_COLOR;
+  return ALARM_COLOR;
+}
+
+// ==================== SENSOR CHART ====================
+// One tier of the sensor history, downsampled to CHART_BUCKETS points. The
+// window is the tier's capacity and moves a quarter at a time, so new readings
+// only change the last points and the plot is repainted from the first point
+// that moved instead of cleared.
+
+static const char* chartSpanLabel[TIER_COUNT] = {"Last 6 hours", "Last 7 days", "Last 90 days"};
+static const char* chartTierLabel[TIER_COUNT] = {"6h", "7d", "90d"};
+
+// Chart range and safe range in tenths
+void chartRange(int16_t& bottom, int16_t& top, int16_t& safeMin, int16_t& safeMax) {
+  if (chartHumidity) {
+    bottom = 0;
+    top = 1000;
+    safeMin = HUMIDITY_MIN_SAFE * 10;
+    safeMax = HUMIDITY_MAX_SAFE * 10;
   } else {
-    tft.print("Check medication");
+    bottom = 0;
+    top = 450;
+    safeMin = TEMP_MIN_SAFE * 10;
+    safeMax = TEMP_MAX_SAFE * 10;
   }
+}
+
+int chartY(int16_t value) {
+  int16_t bottom, top, safeMin, safeMax;
+  chartRange(bottom, top, safeMin, safeMax);
+  value = constrain(value, bottom, top);
+  return CHART_Y + CHART_H - 1 - (int32_t)(value - bottom) * (CHART_H - 1) / (top - bottom);
+}
+
+int chartX(const ChartPoint& point) {
+  return CHART_X + (int32_t)point.offset * (CHART_W - 1) / (sensorHistoryCapacity(chartTier) - 1);
+}
+
+bool samePoint(const ChartPoint& a, const ChartPoint& b) {
+  return a.offset == b.offset && a.bucket == b.bucket && a.value == b.value && a.lo == b.lo && a.hi == b.hi;
+}
+
+// Title, buttons and labels; the plot itself is drawn by drawSensorChartScreen()
+void drawSensorChartFrame() {
+  tft.fillScreen(BACKGROUND_COLOR);
+  tft.setTextColor(TEXT_COLOR);
+  tft.setTextSize(3);
+  tft.setCursor(80, 10);
+  tft.print(chartHumidity ? "Humidity" : "Temperature");
+  drawButton(buttonMargin, buttonMargin, 60, 30, "Back", HIGHLIGHT_COLOR);
   
-  // Dismiss button (larger)
-  tft.fillRect(tft.width() / 2 - 60, tft.height() - 80, 120, 50, TFT_WHITE);
-  tft.setTextColor(ALARM_COLOR);
+  // Range labels at the top, the safe limits and the bottom
+  int16_t bottom, top, safeMin, safeMax;
+  chartRange(bottom, top, safeMin, safeMax);
+  int16_t labels[4] = {top, safeMax, safeMin, bottom};
+  tft.setTextSize(1);
+  for (int i = 0; i < 4; i++) {
+    tft.setTextColor(i == 1 || i == 2 ? WARNING_COLOR : TEXT_COLOR);
+    tft.setCursor(4, chartY(labels[i]) - 3);
+    tft.print(labels[i] / 10);
+  }
+  tft.drawFastVLine(CHART_X - 1, CHART_Y, CHART_H, TEXT_COLOR);
+  tft.drawFastHLine(CHART_X - 1, CHART_Y + CHART_H, CHART_W + 1, TEXT_COLOR);
+  drawChartGuides(CHART_X);
+  
+  tft.setTextColor(TEXT_COLOR);
+  tft.setTextSize(2);
+  tft.setCursor(CHART_X, CHART_Y + CHART_H + 8);
+  tft.print(chartSpanLabel[chartTier]);
+  
+  int buttonY = tft.height() - 60;
+  for (int t = 0; t < TIER_COUNT; t++) {
+    drawButton(10 + t * 80, buttonY, 70, 40, chartTierLabel[t], t == chartTier ? HIGHLIGHT_COLOR : TFT_DARKGREY);
+  }
+  drawButton(250, buttonY, 60, 40, chartHumidity ? "Temp" : "Hum", HIGHLIGHT_COLOR);
+}
+
+// Safe limit lines from fromX to the right edge of the plot
+void drawChartGuides(int fromX) {
+  int16_t bottom, top, safeMin, safeMax;
+  chartRange(bottom, top, safeMin, safeMax);
+  tft.drawFastHLine(fromX, chartY(safeMax), CHART_X + CHART_W - fromX, TFT_DARKGREY);
+  tft.drawFastHLine(fromX, chartY(safeMin), CHART_X + CHART_W - fromX, TFT_DARKGREY);
+}
+
+void drawSensorChartScreen() {
+  uint32_t version = sensorHistoryVersion();
+  if (!chartScreenStale && version == chartDrawnVersion) return;
+  bool full = chartScreenStale;
+  chartScreenStale = false;
+  chartDrawnVersion = version;
+  if (full) drawSensorChartFrame();
+  
+  // Window ending at or after the newest sample, moved a quarter at a time
+  uint16_t span = sensorHistoryCapacity(chartTier);
+  uint32_t step = span / 4;
+  uint32_t windowEnd = (sensorHistoryEnd(chartTier) + step - 1) / step * step;
+  if (windowEnd < span) windowEnd = span;
+  uint32_t first = windowEnd - span;
+  
+  ChartPoint points[CHART_BUCKETS];
+  int count = sensorHistoryDownsample(chartTier, chartHumidity, first, span, CHART_BUCKETS, points);
+  
+  // Points before `same` are already on screen
+  int same = 0;
+  if (!full && first == chartDrawnFirst) {
+    while (same < count && same < chartPointCount && samePoint(points[same], chartPoints[same])) same++;
+    if (same == count && same == chartPointCount) return;
+  }
+  
+  // Clear from the last unchanged point; the segment into it is drawn again
+  int clearX = same > 0 ? chartX(points[same - 1]) : CHART_X;
+  tft.fillRect(clearX, CHART_Y, CHART_X + CHART_W - clearX, CHART_H, BACKGROUND_COLOR);
+  drawChartGuides(clearX);
+  
+  int16_t bottom, top, safeMin, safeMax;
+  chartRange(bottom, top, safeMin, safeMax);
+  for (int i = max(same - 2, 0); i < count; i++) {
+    // Red where any reading in the bucket left the safe range
+    bool excursion = points[i].lo < safeMin || points[i].hi > safeMax;
+    uint16_t color = excursion ? ALARM_COLOR : SUCCESS_COLOR;
+    int x = chartX(points[i]);
+    int y = chartY(points[i].value);
+    tft.drawPixel(x, y, color);
+    if (i > 0 && points[i].bucket == points[i - 1].bucket + 1) {
+      bool prevExcursion = points[i - 1].lo < safeMin || points[i - 1].hi > safeMax;
+      tft.drawLine(chartX(points[i - 1]), chartY(points[i - 1].value), x, y,
+                   excursion || prevExcursion ? ALARM_COLOR : SUCCESS_COLOR);
+    }
+  }
+  
+  memcpy(chartPoints, points, count * sizeof(ChartPoint));
+  chartPointCount = count;
+  chartDrawnFirst = first;
+}
+
+// Logs a confirmation outcome with the container it was about
+void journalConfirmation(JournalType type) {
+  int container = pendingConfirmation.control.container_id;
+  if (pendingConfirmation.type == 0) {
+    container = pendingConfirmation.reminders.empty() ? 0 : pendingConfirmation.reminders[0].container_id;
+  }
+  journalAppend(type, container, pendingConfirmation.type, nowMinute());
+}
+
+// ==================== LIST PAGING ====================
+
+int rowsPerPage(int rowHeight) {
+  return (tft.height() - LIST_TOP - LIST_BOTTOM) / rowHeight;
+}
+
+// First row of the current page; pulls listPage back if the list shrank
+int pageStart(int total, int perPage) {
+  int pages = (total + perPage - 1) / perPage;
+  if (listPage >= pages) listPage = pages > 0 ? pages - 1 : 0;
+  return listPage * perPage;
+}
+
+// Prev / page / Next strip under a list; nothing if it fits on one page
+void drawPager(int total, int perPage) {
+  int pages = (total + perPage - 1) / perPage;
+  if (pages <= 1) return;
+  
+  int y = tft.height() - LIST_BOTTOM + 10;
+  drawButton(10, y, 60, 30, "Prev", listPage > 0 ? HIGHLIGHT_COLOR : BACKGROUND_COLOR);
+  drawButton(tft.width() - 70, y, 60, 30, "Next", listPage < pages - 1 ? HIGHLIGHT_COLOR : BACKGROUND_COLOR);
+  
+  tft.fillRect(80, y, tft.width() - 160, 30, BACKGROUND_COLOR);
+  tft.setTextColor(TEXT_COLOR);
   tft.setTextSize(2);
-  tft.setCursor(tft.width() / 2 - 45, tft.height() - 65);
-  tft.print("DISMISS");
+  tft.setCursor(tft.width() / 2 - 24, y + 8);
+  tft.printf("%d/%d", listPage + 1, pages);
+}
+
+// Prev/Next taps; true if the page changed
+bool handlePagerTouch(int x, int y, int total, int perPage) {
+  int pages = (total + perPage - 1) / perPage;
+  int top = tft.height() - LIST_BOTTOM + 10;
+  if (pages <= 1 || y < top || y > top + 30) return false;
+  
+  if (x >= 10 && x <= 70 && listPage > 0) {
+    listPage--;
+    return true;
+  }
+  if (x >= tft.width() - 70 && x <= tft.width() - 10 && listPage < pages - 1) {
+    listPage++;
+    return true;
+  }
+  return false;
+}
+
+// ==================== MODAL SCREENS ====================
+// Painted through the region manager (dirty_region.h): the whole screen on
+// entry or when a handler replaces what it shows, and afterwards only the
+// parts that change, such as a countdown. A static screen sends nothing.
+
+bool usesDirtyRegions(DisplayState state) {
+  switch (state) {
+    case STATE_ALARM:
+    case STATE_TAKE_MEDICINE:
+    case STATE_DISPENSING:
+    case STATE_QUANTITY_CONFIRMATION:
+    case STATE_CONTAINER_SELECTION:
+    case STATE_JAM_ALERT:
+    case STATE_WIFI_ERROR:
+    case STATE_CONTROL_QUEUE_CONFIRMATION:
+      return true;
+    default:
+      return false;
+  }
+}
+
+int confirmationRemaining() {
+  unsigned long elapsed = (millis() - confirmationStartTime) / 1000;
+  int remaining = pendingConfirmation.timeout_seconds - elapsed;
+  return remaining < 0 ? 0 : remaining;
+}
+
+void drawAlarmScreen() {
+  dirtyRepaint(tft, ALARM_COLOR, paintAlarmChrome, paintAlarmScreen, LAYER_ALARM);
+}
+
+void paintAlarmChrome(TFT_eSPI& gfx) {
+  gfx.setTextColor(TFT_WHITE);
+  gfx.setTextSize(4);
+  
+  // Alarm title
+  gfx.setCursor(gfx.width() / 2 - 75, 40);
+  gfx.print("ALERT!");
+  
+  gfx.setTextSize(3);
+  gfx.setCursor(20, 100);
+  gfx.print("Medicine");
+  gfx.setCursor(20, 130);
+  gfx.print("Time");
+  
+  // Dismiss button (larger)
+  gfx.fillRect(gfx.width() / 2 - 60, gfx.height() - 80, 120, 50, TFT_WHITE);
+  gfx.setTextColor(ALARM_COLOR);
+  gfx.setTextSize(2);
+  gfx.setCursor(gfx.width() / 2 - 45, gfx.height() - 65);
+  gfx.print("DISMISS");
+}
+
+void paintAlarmScreen(TFT_eSPI& gfx) {
+  gfx.setTextColor(TFT_WHITE);
+  
+  // Medicine info
+  gfx.setTextSize(2);
+  gfx.setCursor(20, 170);
+  if (!alarmMessage.isEmpty()) {
+    gfx.print(alarmMessage);
+  } else {
+    gfx.print("Check medication");
+  }
 }
 
 void drawDispensingScreen() {
   static bool lastIsDispensing = false;
   static bool lastDispensingComplete = false;
+  static bool lastTimedOut = false;
+  static unsigned long lastAnim = 0;
   
-  // Clear screen if dispensing state changed
+  // Repaint everything if dispensing state changed
   if (isDispensing != lastIsDispensing || dispensingComplete != lastDispensingComplete) {
-    tft.fillScreen(BACKGROUND_COLOR);
+    dirtyInvalidateAll();
     lastIsDispensing = isDispensing;
     lastDispensingComplete = dispensingComplete;
   }
   
-  tft.setTextColor(TEXT_COLOR);
-  
   if (isDispensing && !dispensingComplete) {
-    tft.setTextSize(3);
-    tft.setCursor(30, 60);
-    tft.print("Dispensing");
+    // Loading animation
+    if (millis() - lastAnim > 500) {
+      lastAnim = millis();
+      dispensingAnimStep = (dispensingAnimStep + 1) % 4;
+      dirtyInvalidate(30, 220, 120, 15);
+    }
     
-    tft.setTextSize(2);
-    tft.setCursor(30, 110);
-    tft.print(dispensingMedicineName);
+    // Jam warning once the timeout passes
+    bool timedOut = millis() - dispensingStartTime > DISPENSING_TIMEOUT;
+    if (timedOut != lastTimedOut) {
+      lastTimedOut = timedOut;
+      dirtyInvalidate(30, 260, 200, 45);
+    }
+  }
+  
+  // The chrome differs while dispensing and once complete
+  if (isDispensing && !dispensingComplete) {
+    dirtyRepaint(tft, BACKGROUND_COLOR, paintDispensingChrome, paintDispensingScreen, LAYER_DISPENSING);
+  } else if (dispensingComplete) {
+    dirtyRepaint(tft, BACKGROUND_COLOR, paintDispensedChrome, paintDispensingScreen, LAYER_DISPENSED);
+  } else {
+    dirtyRepaint(tft, BACKGROUND_COLOR, nullptr, paintDispensingScreen, LAYER_NONE);
+  }
+}
+
+void paintDispensingChrome(TFT_eSPI& gfx) {
+  gfx.setTextColor(TEXT_COLOR);
+  gfx.setTextSize(3);
+  gfx.setCursor(30, 60);
+  gfx.print("Dispensing");
+}
+
+void paintDispensedChrome(TFT_eSPI& gfx) {
+  gfx.setTextColor(TEXT_COLOR);
+  gfx.setTextSize(3);
+  gfx.setCursor(50, 60);
+  gfx.print("Complete!");
+  
+  gfx.setTextSize(2);
+  gfx.setCursor(30, 120);
+  gfx.print("Dispensed:");
+  
+  gfx.fillRect(gfx.width() / 2 - 50, gfx.height() - 70, 100, 50, SUCCESS_COLOR);
+  gfx.setTextColor(TFT_WHITE);
+  gfx.setTextSize(2);
+  gfx.setCursor(gfx.width() / 2 - 20, gfx.height() - 55);
+  gfx.print("OK");
+}
+
+void paintDispensingScreen(TFT_eSPI& gfx) {
+  gfx.setTextColor(TEXT_COLOR);
+  
+  if (isDispensing && !dispensingComplete) {
+    gfx.setTextSize(2);
+    gfx.setCursor(30, 110);
+    gfx.print(nameText(dispensingMedicine));
     
-    tft.setCursor(30, 140);
-    tft.printf("Container: %d", dispensingContainer);
+    gfx.setCursor(30, 140);
+    gfx.printf("Container: %d", dispensingContainer);
     
-    tft.setCursor(30, 170);
-    tft.printf("Pills: %d", dispensingDosage);
+    gfx.setCursor(30, 170);
+    gfx.printf("Pills: %d", dispensingDosage);
     
     // Loading animation
-    static unsigned long lastAnim = 0;
-    static int animState = 0;
-    if (millis() - lastAnim > 500) {
-      lastAnim = millis();
-      animState = (animState + 1) % 4;
-      
-      tft.fillRect(30, 220, 120, 15, BACKGROUND_COLOR);
-      for (int i = 0; i <= animState; i++) {
-        tft.fillRect(30 + i * 30, 220, 20, 15, HIGHLIGHT_COLOR);
-      }
+    for (int i = 0; i <= dispensingAnimStep; i++) {
+      gfx.fillRect(30 + i * 30, 220, 20, 15, HIGHLIGHT_COLOR);
     }
     
     // Check for timeout (30 seconds) - show warning below animation
     unsigned long elapsed = millis() - dispensingStartTime;
     if (elapsed > DISPENSING_TIMEOUT) {
-      tft.setTextColor(WARNING_COLOR);
-      tft.setTextSize(2);
-      tft.setCursor(30, 260);
-      tft.print("Check container!");
-      tft.setCursor(30, 285);
-      tft.print("Possible jam");
+      gfx.setTextColor(WARNING_COLOR);
+      gfx.setTextSize(2);
+      gfx.setCursor(30, 260);
+      gfx.print("Check container!");
+      gfx.setCursor(30, 285);
+      gfx.print("Possible jam");
     }
   } else if (dispensingComplete) {
-    tft.setTextSize(3);
-    tft.setCursor(50, 60);
-    tft.print("Complete!");
+    gfx.setTextSize(2);
+    gfx.setCursor(30, 150);
+    gfx.print(nameText(dispensingMedicine));
     
-    tft.setTextSize(2);
-    tft.setCursor(30, 120);
-    tft.printf("Dispensed:");
-    
-    tft.setCursor(30, 150);
-    tft.print(dispensingMedicineName);
-    
-    tft.setCursor(30, 180);
-    tft.printf("%d pills", dispensingDosage);
-    
-    tft.setCursor(30, 210);
-    tft.printf("Container: %d", dispensingContainer);
+    gfx.setCursor(30, 180);
+    gfx.printf("%d pills", dispensingDosage);
     
-    tft.fillRect(tft.width() / 2 - 50, tft.height() - 70, 100, 50, SUCCESS_COLOR);
-    tft.setTextColor(TFT_WHITE);
-    tft.setTextSize(2);
-    tft.setCursor(tft.width() / 2 - 20, tft.height() - 55);
-    tft.print("OK");
+    gfx.setCursor(30, 210);
+    gfx.printf("Container: %d", dispensingContainer);
   }
 }
 
-void drawContainerItem(int x, int y, Container container) {
+void drawContainerItem(int x, int y, const Container& container) {
   // Container box
   tft.drawRect(x, y, tft.width() - 20, 45, HIGHLIGHT_COLOR);
-  tft.fillRect(x + 1, y + 1, (tft.width() - 22) * container.current_capacity / container.max_capacity, 43, 
-               container.low_stock ? WARNING_COLOR : SUCCESS_COLOR);
+  // No bar without a capacity (records that only carry a quantity)
+  int fill = container.max_capacity > 0 ? (tft.width() - 22) * container.current_capacity / container.max_capacity : 0;
+  tft.fillRect(x + 1, y + 1, fill, 43, container.low_stock ? WARNING_COLOR : SUCCESS_COLOR);
   
   // Text
   tft.setTextColor(TEXT_COLOR);
   tft.setTextSize(2);
   tft.setCursor(x + 5, y + 5);
-  tft.print(container.medicine_name);
+  tft.print(nameText(container.medicine));
   
   tft.setCursor(x + 5, y + 25);
   tft.printf("%d/%d", container.current_capacity, container.max_capacity);
@@ -1587,7 +3107,7 @@ void drawContainerItem(int x, int y, Container container) {
   }
 }
 
-void drawReminderItem(int x, int y, Reminder reminder) {
+void drawReminderItem(int x, int y, const Reminder& reminder) {
   // Draw rectangle box with pink background
   uint16_t pinkColor = 0xF81F; // Pink color
   tft.fillRect(x, y, tft.width() - 20, 40, pinkColor);
@@ -1598,49 +3118,80 @@ void drawReminderItem(int x, int y, Reminder reminder) {
   tft.setTextSize(2);
   
   tft.setCursor(x + 8, y + 5);
-  tft.print(reminder.medicine_name);
+  tft.print(nameText(reminder.medicine));
   
   // Build time string from all times (show first 2)
-  String timeStr = "";
+  char timeStr[20] = "";
   for (int i = 0; i < reminder.timeCount && i < 2; i++) {
-    if (i > 0) timeStr += ", ";
-    timeStr += reminder.times[i];
+    if (i > 0) strcat(timeStr, ", ");
+    formatDayMinute(reminderTimes[reminder.firstTime + i].time, timeStr + strlen(timeStr));
   }
-  if (reminder.timeCount > 2) timeStr += "...";
+  if (reminder.timeCount > 2) strcat(timeStr, "...");
   
   tft.setCursor(x + 8, y + 22);
-  tft.printf("C%d | %s", reminder.container_id, timeStr.c_str());
+  tft.printf("C%d | %s", reminder.container_id, timeStr);
 }
 
-void drawScheduleItem(int x, int y, DailySchedule schedule) {
+void drawScheduleItem(int x, int y, const DailySchedule& schedule) {
   tft.setTextColor(TEXT_COLOR);
   tft.setTextSize(2);
   
+  char timeText[6];
+  formatDayMinute(schedule.time, timeText);
   tft.setCursor(x, y);
-  tft.printf("%s - %s", schedule.time.c_str(), schedule.medicine_name.c_str());
+  tft.printf("%s - %s", timeText, nameText(schedule.medicine));
   
   tft.setCursor(x, y + 20);
   tft.printf("%d pills", schedule.dosage);
   
-  // Status indicator
+  drawScheduleStatus(x, y, schedule);
+}
+
+// Status word and dot of a schedule row; repainted alone on status updates
+void drawScheduleStatus(int x, int y, const DailySchedule& schedule) {
   uint16_t statusColor = (schedule.status == "completed") ? SUCCESS_COLOR : 
                          (schedule.status == "pending") ? WARNING_COLOR : TEXT_COLOR;
+  tft.fillRect(x + 120, y + 20, 12 * 11, 16, BACKGROUND_COLOR);
+  tft.setTextColor(statusColor);
+  tft.setTextSize(2);
+  tft.setCursor(x + 120, y + 20);
+  tft.print(schedule.status);
   tft.fillCircle(x + tft.width() - 30, y + 12, 6, statusColor);
 }
 
-void drawButton(int x, int y, int w, int h, String label, uint16_t color) {
+void repaintScheduleRow(int slot) {
+  if (currentState != STATE_SCHEDULE) return;
+  
+  int perPage = rowsPerPage(40);
+  int first = listPage * perPage;
+  if (slot < first || slot >= first + perPage) return;
+  if (applyingBatch) {
+    redrawPending = true;
+    return;
+  }
+  drawScheduleStatus(10, LIST_TOP + (slot - first) * 40, dailySchedule[slot]);
+}
+
+void drawButton(int x, int y, int w, int h, const char* label, uint16_t color) {
   tft.drawRect(x, y, w, h, color);
   tft.setTextColor(color);
   tft.setTextSize(1);
   
-  int textX = x + (w - label.length() * 6) / 2;
+  int textX = x + (w - (int)strlen(label) * 6) / 2;
   int textY = y + (h - 8) / 2;
   
   tft.setCursor(textX, textY);
   tft.print(label);
 }
 
-void showStatusMessage(String message) {
+void showStatusMessage(const char* message) {
+  // Inside a batch only the last one shows, after the repaint
+  if (applyingBatch) {
+    pendingBar = message;
+    pendingBarError = false;
+    return;
+  }
+  
   // Show temporary status message
   tft.fillRect(0, tft.height() - 20, tft.width(), 20, BACKGROUND_COLOR);
   tft.setTextColor(TEXT_COLOR);
@@ -1649,23 +3200,32 @@ void showStatusMessage(String message) {
   tft.print(message);
 }
 
-void showErrorMessage(String errorMsg) {
+void showErrorMessage(const char* errorMsg) {
+  if (applyingBatch) {
+    pendingBar = errorMsg;
+    pendingBarError = true;
+    return;
+  }
+  
   tft.fillRect(0, tft.height() - 20, tft.width(), 20, ALARM_COLOR);
   tft.setTextColor(TFT_WHITE);
   tft.setTextSize(1);
   tft.setCursor(10, tft.height() - 15);
-  tft.print("Error: " + errorMsg);
+  tft.print("Error: ");
+  tft.print(errorMsg);
 }
 
-void showReminderAlert(String medicineName, int containerId, int dosage, String alertType, String message, String timeStr) {
+void showReminderAlert(const char* medicineName, int containerId, int dosage, const char* alertType, const char* message, const char* timeStr) {
   alarmActive = true;
   alarmType = alertType;
   alarmMessage = message;
   currentState = STATE_ALARM;
+  dirtyInvalidateAll();
 }
 
-void showControlQueueResult(int queueId, bool success, String message) {
-  String resultMsg = String("Queue #") + queueId + ": " + (success ? "Success" : "Failed");
+void showControlQueueResult(int queueId, bool success, const char* message) {
+  char resultMsg[32];
+  snprintf(resultMsg, sizeof(resultMsg), "Queue #%d: %s", queueId, success ? "Success" : "Failed");
   if (success) {
     showStatusMessage(resultMsg);
   } else {
@@ -1674,13 +3234,23 @@ void showControlQueueResult(int queueId, bool success, String message) {
 }
 
 void drawTakeMedicineConfirmation() {
-  tft.fillScreen(BACKGROUND_COLOR);
-  tft.setTextColor(TEXT_COLOR);
+  // Only the countdown changes while the screen is up
+  static int lastRemaining = -1;
+  int remaining = confirmationRemaining();
+  if (remaining != lastRemaining) {
+    lastRemaining = remaining;
+    dirtyInvalidate(270, 15, 50, 20);
+  }
+  dirtyRepaint(tft, BACKGROUND_COLOR, paintTakeMedicineChrome, paintTakeMedicineConfirmation, LAYER_TAKE_MEDICINE);
+}
+
+void paintTakeMedicineChrome(TFT_eSPI& gfx) {
+  gfx.setTextColor(TEXT_COLOR);
   
   // Title
-  tft.setTextSize(3);
-  tft.setCursor(20, 15);
-  tft.print("Medication");
+  gfx.setTextSize(3);
+  gfx.setCursor(20, 15);
+  gfx.print("Medication");
   
   // Hybrid Architecture: Draw source indicator badge
   // int badgeWidth = 70;
@@ -1702,143 +3272,164 @@ void drawTakeMedicineConfirmation() {
   //   badgeColor = TFT_DARKGREEN;
   // }
   
-  // tft.fillRoundRect(badgeX, badgeY, badgeWidth, badgeHeight, 4, badgeColor);
-  // tft.setTextColor(TFT_WHITE);
-  // tft.setTextSize(1);
+  // gfx.fillRoundRect(badgeX, badgeY, badgeWidth, badgeHeight, 4, badgeColor);
+  // gfx.setTextColor(TFT_WHITE);
+  // gfx.setTextSize(1);
   // int textWidth = strlen(sourceLabel) * 6;
   // int textX = badgeX + (badgeWidth - textWidth) / 2;
-  // tft.setCursor(textX, badgeY + 5);
-  // tft.print(sourceLabel);
+  // gfx.setCursor(textX, badgeY + 5);
+  // gfx.print(sourceLabel);
   
-  // Timer - clear area first
-  tft.fillRect(270, 15, 50, 20, BACKGROUND_COLOR);
-  unsigned long elapsed = (millis() - confirmationStartTime) / 1000;
-  int remaining = pendingConfirmation.timeout_seconds - elapsed;
-  if (remaining < 0) remaining = 0;
-  tft.setTextSize(2);
-  tft.setCursor(270, 15);
-  tft.printf("%ds", remaining);
+  // Confirm button (left side, bigger for elderly)
+  gfx.fillRect(10, gfx.height() - 70, 145, 60, SUCCESS_COLOR);
+  gfx.drawRect(10, gfx.height() - 70, 145, 60, TFT_WHITE);
+  gfx.setTextColor(TFT_WHITE);
+  gfx.setTextSize(3);
+  gfx.setCursor(20, gfx.height() - 55);
+  gfx.print("CONFIRM");
+  
+  // Cancel button (right side, bigger for elderly)
+  gfx.fillRect(165, gfx.height() - 70, 145, 60, ALARM_COLOR);
+  gfx.drawRect(165, gfx.height() - 70, 145, 60, TFT_WHITE);
+  gfx.setTextColor(TFT_WHITE);
+  gfx.setTextSize(3);
+  gfx.setCursor(185, gfx.height() - 55);
+  gfx.print("CANCEL");
+}
+
+void paintTakeMedicineConfirmation(TFT_eSPI& gfx) {
+  gfx.setTextColor(TEXT_COLOR);
+  
+  // Timer
+  gfx.setTextSize(2);
+  gfx.setCursor(270, 15);
+  gfx.printf("%ds", confirmationRemaining());
   
   // Medicine list
   int yPos = 50;
-  tft.setTextSize(2);
-  for (int i = 0; i < pendingConfirmation.reminder_count && i < 10; i++) {
+  gfx.setTextSize(2);
+  for (size_t i = 0; i < pendingConfirmation.reminders.size(); i++) {
     ReminderItem& item = pendingConfirmation.reminders[i];
     
-    tft.setCursor(10, yPos);
-    tft.print(item.medicine_name);
+    gfx.setCursor(10, yPos);
+    gfx.print(nameText(item.medicine));
     
-    tft.setCursor(10, yPos + 20);
-    tft.setTextSize(2);
-    tft.printf("Container %d | %d pills", item.container_id, item.dosage);
+    gfx.setCursor(10, yPos + 20);
+    gfx.setTextSize(2);
+    gfx.printf("Container %d | %d pills", item.container_id, item.dosage);
     
     yPos += 50;
     
-    if (yPos > tft.height() - 140) break; // Stop if too many
+    if (yPos > gfx.height() - 140) break; // Stop if too many
   }
-  
-  // Confirm button (left side, bigger for elderly)
-  tft.fillRect(10, tft.height() - 70, 145, 60, SUCCESS_COLOR);
-  tft.drawRect(10, tft.height() - 70, 145, 60, TFT_WHITE);
-  tft.setTextColor(TFT_WHITE);
-  tft.setTextSize(3);
-  tft.setCursor(20, tft.height() - 55);
-  tft.print("CONFIRM");
-  
-  // Cancel button (right side, bigger for elderly)
-  tft.fillRect(165, tft.height() - 70, 145, 60, ALARM_COLOR);
-  tft.drawRect(165, tft.height() - 70, 145, 60, TFT_WHITE);
-  tft.setTextColor(TFT_WHITE);
-  tft.setTextSize(3);
-  tft.setCursor(185, tft.height() - 55);
-  tft.print("CANCEL");
 }
 
 void drawQuantityConfirmation() {
-  tft.fillScreen(BACKGROUND_COLOR);
-  tft.setTextColor(TEXT_COLOR);
+  dirtyRepaint(tft, BACKGROUND_COLOR, paintQuantityChrome, paintQuantityConfirmation, LAYER_QUANTITY);
+}
+
+void paintQuantityChrome(TFT_eSPI& gfx) {
+  gfx.setTextColor(TEXT_COLOR);
   
   // Title
-  tft.setTextSize(3);
-  tft.setCursor(30, 20);
-  tft.print("Check Pills");
+  gfx.setTextSize(3);
+  gfx.setCursor(30, 20);
+  gfx.print("Check Pills");
+  
+  // Question
+  gfx.setTextSize(2);
+  gfx.setCursor(20, gfx.height() - 120);
+  gfx.print("Got correct amount?");
+  
+  // Yes button (left)
+  gfx.fillRect(20, gfx.height() - 60, 100, 40, SUCCESS_COLOR);
+  gfx.drawRect(20, gfx.height() - 60, 100, 40, TFT_WHITE);
+  gfx.setTextColor(TFT_WHITE);
+  gfx.setTextSize(2);
+  gfx.setCursor(45, gfx.height() - 45);
+  gfx.print("YES");
+  
+  // One More button (right)
+  gfx.fillRect(gfx.width() - 120, gfx.height() - 60, 100, 40, WARNING_COLOR);
+  gfx.drawRect(gfx.width() - 120, gfx.height() - 60, 100, 40, TFT_WHITE);
+  gfx.setTextColor(TFT_WHITE);
+  gfx.setTextSize(2);
+  gfx.setCursor(gfx.width() - 105, gfx.height() - 50);
+  gfx.print("ONE");
+  gfx.setCursor(gfx.width() - 105, gfx.height() - 35);
+  gfx.print("MORE");
+}
+
+void paintQuantityConfirmation(TFT_eSPI& gfx) {
+  gfx.setTextColor(TEXT_COLOR);
   
   // Medicine info
-  tft.setTextSize(2);
+  gfx.setTextSize(2);
   int yPos = 80;
-  for (int i = 0; i < pendingConfirmation.reminder_count && i < 10; i++) {
+  for (size_t i = 0; i < pendingConfirmation.reminders.size(); i++) {
     ReminderItem& item = pendingConfirmation.reminders[i];
     
-    tft.setCursor(20, yPos);
-    tft.print(item.medicine_name);
+    gfx.setCursor(20, yPos);
+    gfx.print(nameText(item.medicine));
     
-    tft.setCursor(20, yPos + 25);
-    tft.printf("Expected: %d pills", item.dosage);
+    gfx.setCursor(20, yPos + 25);
+    gfx.printf("Expected: %d pills", item.dosage);
     
     yPos += 60;
     
-    if (yPos > tft.height() - 140) break;
+    if (yPos > gfx.height() - 140) break;
   }
-  
-  // Question
-  tft.setTextSize(2);
-  tft.setCursor(20, tft.height() - 120);
-  tft.print("Got correct amount?");
-  
-  // Yes button (left)
-  tft.fillRect(20, tft.height() - 60, 100, 40, SUCCESS_COLOR);
-  tft.drawRect(20, tft.height() - 60, 100, 40, TFT_WHITE);
-  tft.setTextColor(TFT_WHITE);
-  tft.setTextSize(2);
-  tft.setCursor(45, tft.height() - 45);
-  tft.print("YES");
-  
-  // One More button (right)
-  tft.fillRect(tft.width() - 120, tft.height() - 60, 100, 40, WARNING_COLOR);
-  tft.drawRect(tft.width() - 120, tft.height() - 60, 100, 40, TFT_WHITE);
-  tft.setTextColor(TFT_WHITE);
-  tft.setTextSize(2);
-  tft.setCursor(tft.width() - 105, tft.height() - 50);
-  tft.print("ONE");
-  tft.setCursor(tft.width() - 105, tft.height() - 35);
-  tft.print("MORE");
 }
 
 void drawContainerSelectionScreen() {
-  tft.fillScreen(BACKGROUND_COLOR);
-  tft.setTextColor(TEXT_COLOR);
+  dirtyRepaint(tft, BACKGROUND_COLOR, paintContainerSelectionChrome, paintContainerSelectionScreen,
+               LAYER_CONTAINER_SELECTION);
+}
+
+void paintContainerSelectionChrome(TFT_eSPI& gfx) {
+  gfx.setTextColor(TEXT_COLOR);
   
   // Title
-  tft.setTextSize(3);
-  tft.setCursor(20, 15);
-  tft.print("Select One");
+  gfx.setTextSize(3);
+  gfx.setCursor(20, 15);
+  gfx.print("Select One");
   
   // Subtitle
-  tft.setTextSize(2);
-  tft.setCursor(20, 50);
-  tft.print("Which medicine?");
+  gfx.setTextSize(2);
+  gfx.setCursor(20, 50);
+  gfx.print("Which medicine?");
   
+  // Back button at bottom
+  gfx.fillRect(gfx.width() / 2 - 50, gfx.height() - 50, 100, 40, WARNING_COLOR);
+  gfx.drawRect(gfx.width() / 2 - 50, gfx.height() - 50, 100, 40, TFT_WHITE);
+  gfx.setTextColor(TFT_WHITE);
+  gfx.setTextSize(2);
+  gfx.setCursor(gfx.width() / 2 - 30, gfx.height() - 35);
+  gfx.print("BACK");
+}
+
+void paintContainerSelectionScreen(TFT_eSPI& gfx) {
   // List all containers from pending confirmation
   int yPos = 90;
   int itemHeight = 50;
   
   if (hasPendingConfirmation) {
-    for (int i = 0; i < pendingConfirmation.reminder_count && i < 10; i++) {
+    for (size_t i = 0; i < pendingConfirmation.reminders.size(); i++) {
       // Draw button box
       uint16_t buttonColor = HIGHLIGHT_COLOR;
-      tft.drawRect(10, yPos, tft.width() - 20, itemHeight, buttonColor);
-      tft.fillRect(11, yPos + 1, tft.width() - 22, itemHeight - 2, 0x2104); // Dark background
+      gfx.drawRect(10, yPos, gfx.width() - 20, itemHeight, buttonColor);
+      gfx.fillRect(11, yPos + 1, gfx.width() - 22, itemHeight - 2, 0x2104); // Dark background
       
       // Medicine name
-      tft.setTextColor(TEXT_COLOR);
-      tft.setTextSize(2);
-      tft.setCursor(20, yPos + 8);
-      tft.print(pendingConfirmation.reminders[i].medicine_name);
+      gfx.setTextColor(TEXT_COLOR);
+      gfx.setTextSize(2);
+      gfx.setCursor(20, yPos + 8);
+      gfx.print(nameText(pendingConfirmation.reminders[i].medicine));
       
       // Container info
-      tft.setTextSize(1);
-      tft.setCursor(20, yPos + 30);
-      tft.printf("Container %d | %d pill", 
+      gfx.setTextSize(1);
+      gfx.setCursor(20, yPos + 30);
+      gfx.printf("Container %d | %d pill", 
                  pendingConfirmation.reminders[i].container_id,
                  pendingConfirmation.reminders[i].dosage);
       
@@ -1848,14 +3439,6 @@ void drawContainerSelectionScreen() {
       if (i >= 3) break;
     }
   }
-  
-  // Back button at bottom
-  tft.fillRect(tft.width() / 2 - 50, tft.height() - 50, 100, 40, WARNING_COLOR);
-  tft.drawRect(tft.width() / 2 - 50, tft.height() - 50, 100, 40, TFT_WHITE);
-  tft.setTextColor(TFT_WHITE);
-  tft.setTextSize(2);
-  tft.setCursor(tft.width() / 2 - 30, tft.height() - 35);
-  tft.print("BACK");
 }
 
 void handleContainerSelectionTouch(int x, int y) {
@@ -1864,19 +3447,15 @@ void handleContainerSelectionTouch(int x, int y) {
   int itemHeight = 50;
   
   if (hasPendingConfirmation) {
-    for (int i = 0; i < pendingConfirmation.reminder_count && i < 4; i++) {
+    for (size_t i = 0; i < pendingConfirmation.reminders.size() && i < 4; i++) {
       if (x >= 10 && x <= tft.width() - 10 && 
           y >= yPos && y <= yPos + itemHeight) {
         // Container selected - send dispensing request
-        StaticJsonDocument<256> doc;
-        doc["type"] = "dispensing_request";
-        doc["container_id"] = pendingConfirmation.reminders[i].container_id;
-        doc["dosage"] = 1; // Dispense one more pill
-        doc["medicine_name"] = pendingConfirmation.reminders[i].medicine_name;
-        
-        String jsonStr;
-        serializeJson(doc, jsonStr);
-        SerialPort.println(jsonStr);
+        DispensingRequestMsg request;
+        request.container_id = pendingConfirmation.reminders[i].container_id;
+        request.dosage = 1; // Dispense one more pill
+        request.medicine_name = nameText(pendingConfirmation.reminders[i].medicine);
+        sendToMinder(request);
         
         currentState = STATE_DISPENSING;
         return;
@@ -1896,108 +3475,129 @@ void handleContainerSelectionTouch(int x, int y) {
 }
 
 void drawJamAlert() {
-  tft.fillScreen(ALARM_COLOR);
-  tft.setTextColor(TFT_WHITE);
+  dirtyRepaint(tft, ALARM_COLOR, paintJamChrome, paintJamAlert, LAYER_JAM);
+}
+
+void paintJamChrome(TFT_eSPI& gfx) {
+  gfx.setTextColor(TFT_WHITE);
   
   // Warning icon (!)
-  tft.setTextSize(4);
-  tft.setCursor(tft.width() / 2 - 10, 20);
-  tft.print("!");
+  gfx.setTextSize(4);
+  gfx.setCursor(gfx.width() / 2 - 10, 20);
+  gfx.print("!");
   
   // Title
-  tft.setTextSize(3);
-  tft.setCursor(40, 80);
-  tft.print("JAM DETECTED");
+  gfx.setTextSize(3);
+  gfx.setCursor(40, 80);
+  gfx.print("JAM DETECTED");
   
-  // Details
-  tft.setTextSize(2);
-  tft.setCursor(20, 130);
-  tft.printf("Container: %d", jamAlertContainer);
+  // Instructions
+  gfx.setTextSize(2);
+  gfx.setCursor(20, 220);
+  gfx.print("Please clear the jam");
+  gfx.setCursor(20, 245);
+  gfx.print("and press Continue");
   
-  tft.setCursor(20, 155);
-  tft.print(jamAlertMedicine);
+  // Continue button
+  gfx.fillRect(gfx.width() / 2 - 60, gfx.height() - 60, 120, 40, TFT_WHITE);
+  gfx.setTextColor(ALARM_COLOR);
+  gfx.setTextSize(2);
+  gfx.setCursor(gfx.width() / 2 - 50, gfx.height() - 45);
+  gfx.print("CONTINUE");
+}
+
+void paintJamAlert(TFT_eSPI& gfx) {
+  gfx.setTextColor(TFT_WHITE);
   
-  tft.setCursor(20, 180);
-  tft.printf("%d pills remaining", jamAlertPillsRemaining);
+  // Details
+  gfx.setTextSize(2);
+  gfx.setCursor(20, 130);
+  gfx.printf("Container: %d", jamAlertContainer);
   
-  // Instructions
-  tft.setTextSize(2);
-  tft.setCursor(20, 220);
-  tft.print("Please clear the jam");
-  tft.setCursor(20, 245);
-  tft.print("and press Continue");
+  gfx.setCursor(20, 155);
+  gfx.print(nameText(jamAlertMedicine));
   
-  // Continue button
-  tft.fillRect(tft.width() / 2 - 60, tft.height() - 60, 120, 40, TFT_WHITE);
-  tft.setTextColor(ALARM_COLOR);
-  tft.setTextSize(2);
-  tft.setCursor(tft.width() / 2 - 50, tft.height() - 45);
-  tft.print("CONTINUE");
+  gfx.setCursor(20, 180);
+  gfx.printf("%d pills remaining", jamAlertPillsRemaining);
 }
 
 void drawWiFiError() {
-  tft.fillScreen(ALARM_COLOR);
-  tft.setTextColor(TFT_WHITE);
+  dirtyRepaint(tft, ALARM_COLOR, paintWiFiErrorChrome, paintWiFiError, LAYER_WIFI);
+}
+
+void paintWiFiErrorChrome(TFT_eSPI& gfx) {
+  gfx.setTextColor(TFT_WHITE);
   
   // Error icon (X)
-  tft.setTextSize(4);
-  tft.setCursor(tft.width() / 2 - 10, 20);
-  tft.print("X");
+  gfx.setTextSize(4);
+  gfx.setCursor(gfx.width() / 2 - 10, 20);
+  gfx.print("X");
   
   // Title
-  tft.setTextSize(3);
-  tft.setCursor(30, 80);
-  tft.print("WiFi Error");
+  gfx.setTextSize(3);
+  gfx.setCursor(30, 80);
+  gfx.print("WiFi Error");
+  
+  // OK button
+  gfx.fillRect(gfx.width() / 2 - 40, gfx.height() - 60, 80, 40, TFT_WHITE);
+  gfx.setTextColor(ALARM_COLOR);
+  gfx.setTextSize(2);
+  gfx.setCursor(gfx.width() / 2 - 15, gfx.height() - 45);
+  gfx.print("OK");
+}
+
+void paintWiFiError(TFT_eSPI& gfx) {
+  gfx.setTextColor(TFT_WHITE);
   
   // Message
-  tft.setTextSize(2);
-  tft.setCursor(20, 130);
-  // Word wrap the message
+  gfx.setTextSize(2);
+  gfx.setCursor(20, 130);
+  // Word wrap the message, printing each word straight from the buffer
   int lineY = 130;
   int lineLen = 0;
-  String word = "";
-  for (unsigned int i = 0; i < wifiErrorMessage.length(); i++) {
-    char c = wifiErrorMessage[i];
-    if (c == ' ' || i == wifiErrorMessage.length() - 1) {
-      if (i == wifiErrorMessage.length() - 1 && c != ' ') word += c;
-      if (lineLen + word.length() > 20) {
-        lineY += 25;
-        lineLen = 0;
-        tft.setCursor(20, lineY);
-      }
-      tft.print(word + " ");
-      lineLen += word.length() + 1;
-      word = "";
-    } else {
-      word += c;
+  const char* word = wifiErrorMessage.c_str();
+  while (*word) {
+    size_t wordLen = strcspn(word, " ");
+    if (lineLen + wordLen > 20) {
+      lineY += 25;
+      lineLen = 0;
+      gfx.setCursor(20, lineY);
     }
+    for (size_t i = 0; i < wordLen; i++) gfx.print(word[i]);
+    gfx.print(' ');
+    lineLen += wordLen + 1;
+    word += wordLen;
+    if (*word == ' ') word++;
   }
   
   // Instruction
-  tft.setTextSize(2);
-  tft.setCursor(20, 220);
+  gfx.setTextSize(2);
+  gfx.setCursor(20, 220);
   if (wifiErrorInstruction.length() > 0) {
-    tft.print(wifiErrorInstruction);
+    gfx.print(wifiErrorInstruction);
   } else {
-    tft.print("Please restart device");
+    gfx.print("Please restart device");
   }
-  
-  // OK button
-  tft.fillRect(tft.width() / 2 - 40, tft.height() - 60, 80, 40, TFT_WHITE);
-  tft.setTextColor(ALARM_COLOR);
-  tft.setTextSize(2);
-  tft.setCursor(tft.width() / 2 - 15, tft.height() - 45);
-  tft.print("OK");
 }
 
 void drawControlConfirmation() {
-  tft.fillScreen(BACKGROUND_COLOR);
-  tft.setTextColor(TEXT_COLOR);
+  // Only the countdown changes while the screen is up
+  static int lastRemaining = -1;
+  int remaining = confirmationRemaining();
+  if (remaining != lastRemaining) {
+    lastRemaining = remaining;
+    dirtyInvalidate(270, 15, 50, 20);
+  }
+  dirtyRepaint(tft, BACKGROUND_COLOR, paintControlChrome, paintControlConfirmation, LAYER_CONTROL);
+}
+
+void paintControlChrome(TFT_eSPI& gfx) {
+  gfx.setTextColor(TEXT_COLOR);
   
   // Title
-  tft.setTextSize(3);
-  tft.setCursor(20, 15);
-  tft.print("Control");
+  gfx.setTextSize(3);
+  gfx.setCursor(20, 15);
+  gfx.print("Control");
   
   // Hybrid Architecture: Draw source indicator badge (similar to medication alerts)
   // int badgeWidth = 70;
@@ -2016,88 +3616,78 @@ void drawControlConfirmation() {
   //   badgeColor = TFT_DARKGREEN;
   // }
   
-  // tft.fillRoundRect(badgeX, badgeY, badgeWidth, badgeHeight, 4, badgeColor);
-  // tft.setTextColor(TFT_WHITE);
-  // tft.setTextSize(1);
+  // gfx.fillRoundRect(badgeX, badgeY, badgeWidth, badgeHeight, 4, badgeColor);
+  // gfx.setTextColor(TFT_WHITE);
+  // gfx.setTextSize(1);
   // int textWidth = strlen(sourceLabel) * 6;
   // int textX = badgeX + (badgeWidth - textWidth) / 2;
-  // tft.setCursor(textX, badgeY + 5);
-  // tft.print(sourceLabel);
+  // gfx.setCursor(textX, badgeY + 5);
+  // gfx.print(sourceLabel);
   
-  // Timer - clear area first
-  tft.fillRect(270, 15, 50, 20, BACKGROUND_COLOR);
-  unsigned long elapsed = (millis() - confirmationStartTime) / 1000;
-  int remaining = pendingConfirmation.timeout_seconds - elapsed;
-  if (remaining < 0) remaining = 0;
-  tft.setTextSize(2);
-  tft.setCursor(270, 15);
-  tft.printf("%ds", remaining);
+  // Labels
+  gfx.setTextSize(2);
+  gfx.setCursor(20, 60);
+  gfx.print("Action:");
+  gfx.setCursor(20, 120);
+  gfx.print("Medicine:");
+  
+  // Confirm button (left side, bigger for elderly)
+  gfx.fillRect(10, gfx.height() - 70, 145, 60, SUCCESS_COLOR);
+  gfx.drawRect(10, gfx.height() - 70, 145, 60, TFT_WHITE);
+  gfx.setTextColor(TFT_WHITE);
+  gfx.setTextSize(3);
+  gfx.setCursor(20, gfx.height() - 55);
+  gfx.print("CONFIRM");
+  
+  // Cancel button (right side, bigger for elderly)
+  gfx.fillRect(165, gfx.height() - 70, 145, 60, ALARM_COLOR);
+  gfx.drawRect(165, gfx.height() - 70, 145, 60, TFT_WHITE);
+  gfx.setTextColor(TFT_WHITE);
+  gfx.setTextSize(3);
+  gfx.setCursor(185, gfx.height() - 55);
+  gfx.print("CANCEL");
+}
+
+void paintControlConfirmation(TFT_eSPI& gfx) {
+  gfx.setTextColor(TEXT_COLOR);
+  
+  // Timer
+  gfx.setTextSize(2);
+  gfx.setCursor(270, 15);
+  gfx.printf("%ds", confirmationRemaining());
   
   // Control details
-  tft.setTextSize(2);
-  tft.setCursor(20, 60);
-  tft.print("Action:");
-  tft.setCursor(20, 85);
-  tft.print(pendingConfirmation.control.action);
+  gfx.setCursor(20, 85);
+  gfx.print(pendingConfirmation.control.action);
   
-  tft.setCursor(20, 120);
-  tft.print("Medicine:");
-  tft.setCursor(20, 145);
-  tft.print(pendingConfirmation.control.medicine_name);
+  gfx.setCursor(20, 145);
+  gfx.print(nameText(pendingConfirmation.control.medicine));
   
-  tft.setCursor(20, 180);
-  tft.printf("Container: %d", pendingConfirmation.control.container_id);
+  gfx.setCursor(20, 180);
+  gfx.printf("Container: %d", pendingConfirmation.control.container_id);
   
-  tft.setCursor(20, 205);
-  tft.printf("Quantity: %d", pendingConfirmation.control.quantity);
+  gfx.setCursor(20, 205);
+  gfx.printf("Quantity: %d", pendingConfirmation.control.quantity);
   
   // Message if available
   if (pendingConfirmation.control.message.length() > 0) {
-    tft.setCursor(20, 230);
-    tft.print(pendingConfirmation.control.message);
+    gfx.setCursor(20, 230);
+    gfx.print(pendingConfirmation.control.message);
   }
-  
-  // Confirm button (left side, bigger for elderly)
-  tft.fillRect(10, tft.height() - 70, 145, 60, SUCCESS_COLOR);
-  tft.drawRect(10, tft.height() - 70, 145, 60, TFT_WHITE);
-  tft.setTextColor(TFT_WHITE);
-  tft.setTextSize(3);
-  tft.setCursor(20, tft.height() - 55);
-  tft.print("CONFIRM");
-  
-  // Cancel button (right side, bigger for elderly)
-  tft.fillRect(165, tft.height() - 70, 145, 60, ALARM_COLOR);
-  tft.drawRect(165, tft.height() - 70, 145, 60, TFT_WHITE);
-  tft.setTextColor(TFT_WHITE);
-  tft.setTextSize(3);
-  tft.setCursor(185, tft.height() - 55);
-  tft.print("CANCEL");
 }
 
 int getActiveContainerCount() {
-  int count = 0;
-  for (int i = 0; i < containerCount; i++) {
-    if (containers[i].current_capacity > 0) {
-      count++;
-    }
-  }
-  return count;
+  return modelStats.activeContainers;
 }
 
 int getActiveReminderCount() {
-  int count = 0;
-  for (int i = 0; i < reminderCount; i++) {
-    if (reminders[i].active) {
-      count++;
-    }
-  }
-  return count;
+  return modelStats.activeReminders;
 }
 
 void syncTimeWithNTP() {
     // Note: Caller should already hold wifiMutex or ensure thread safety
     configTime(UTC_OFFSET, UTC_OFFSET_DST, NTP_SERVER);
-    Serial.println("NTP time sync initiated");
+    LOG_INFO("NTP time sync initiated");
     
     // Wait for time sync
     int retries = 0;
@@ -2111,8 +3701,8 @@ void syncTimeWithNTP() {
     if (getLocalTime(&timeinfo)) {
         rtcTimeSet = true;
         // xEventGroupSetBits(wifiEventGroup, TIME_SYNCED_BIT);
-        Serial.println("✓ Time synchronized with NTP");
-        Serial.printf("Current time: %04d-%02d-%02d %02d:%02d:%02d\n",
+        LOG_INFO("✓ Time synchronized with NTP");
+        LOG_INFO("Current time: %04d-%02d-%02d %02d:%02d:%02d",
                       timeinfo.tm_year + 1900,
                       timeinfo.tm_mon + 1,
                       timeinfo.tm_mday,
@@ -2120,7 +3710,7 @@ void syncTimeWithNTP() {
                       timeinfo.tm_min,
                       timeinfo.tm_sec);
     } else {
-        Serial.println("⚠ NTP sync failed");
+        LOG_WARN("⚠ NTP sync failed");
     }
 }
 
@@ -2129,7 +3719,7 @@ void syncTimeWithNTP() {
 // ====================================
 
 void generateDummyData() {
-    Serial.println("\n>>> Sending all dummy data <<<");
+    LOG_INFO(">>> Sending all dummy data <<<");
     delay(500);
     sendDummyDeviceInfo();
     delay(500);
@@ -2143,323 +3733,566 @@ void generateDummyData() {
     delay(500);
     sendDummyDailySchedule();
     delay(500);
-    Serial.println(">>> All dummy data sent <<<\n");
+    LOG_INFO(">>> All dummy data sent <<<");
 }
 
-void sendDummyDeviceInfo() {
-    StaticJsonDocument<512> doc;
-    doc["type"] = "device_info";
-    doc["id"] = 1;
-    doc["uid"] = "90c666bf-c1ea-4ce5-940d-6a4b94bc9540";
-    doc["device_name"] = "Minder Device";
-    doc["current_state"] = "online";
-    doc["temperature"] = 26.7;
-    doc["humidity"] = 57.0;
-    doc["timestamp"] = millis();
+// Same burst as generateDummyData(), but as one batch frame with a single repaint
+JsonArray dummyBatchMessages;  // Collects dummy messages while set
+
+void sendDummyBatch() {
+    JsonDocument batch;
+    batch["type"] = "batch";
+    dummyBatchMessages = batch["messages"].to<JsonArray>();
+    sendDummyDeviceInfo();
+    sendDummySystemStatus();
+    sendDummySensorData();
+    sendDummyContainersInfo();
+    sendDummyRemindersInfo();
+    sendDummyDailySchedule();
+    dummyBatchMessages = JsonArray();
     
     String json;
-    serializeJson(doc, json);
+    serializeJson(batch, json);
     processIncomingData(json);
-    Serial.println("Sent dummy: device_info");
+    LOG_INFO("Sent dummy batch: %u messages, %u bytes", (unsigned)batch["messages"].size(), (unsigned)json.length());
 }
 
-void sendDummySystemStatus() {
-    StaticJsonDocument<512> doc;
-    doc["type"] = "system_status";
-    doc["wifi_status"] = "connected";
-    doc["mqtt_status"] = "connected";
-    doc["sd_card_status"] = "mounted";
-    doc["temperature"] = 26.7;
-    doc["humidity"] = 57.0;
-    doc["rtc_time_set"] = true;
-    doc["timestamp"] = millis();
+// Encode a typed message as the minder would and feed it through the receive path
+template <typename T>
+void injectDummyMessage(const T& msg) {
+    if (!dummyBatchMessages.isNull()) {
+        encodeMsg(msg, dummyBatchMessages.add<JsonObject>());
+        return;
+    }
+    
+    JsonDocument doc;
+    encodeMsg(msg, doc.to<JsonObject>());
     
     String json;
     serializeJson(doc, json);
     processIncomingData(json);
-    Serial.println("Sent dummy: system_status");
+    LOG_INFO("Sent dummy: %s", msgTypeName(T::TYPE));
+}
+
+void sendDummyDeviceInfo() {
+    DeviceInfoMsg msg;
+    msg.id = 1;
+    msg.uid = "90c666bf-c1ea-4ce5-940d-6a4b94bc9540";
+    msg.device_name = "Minder Device";
+    msg.current_state = "online";
+    msg.temperature = 26.7;
+    msg.humidity = 57.0;
+    msg.timestamp = millis();
+    injectDummyMessage(msg);
+}
+
+void sendDummySystemStatus() {
+    SystemStatusMsg msg;
+    msg.wifi_status = "connected";
+    msg.mqtt_status = "connected";
+    msg.sd_card_status = "mounted";
+    msg.temperature = 26.7;
+    msg.humidity = 57.0;
+    msg.rtc_time_set = true;
+    msg.timestamp = millis();
+    injectDummyMessage(msg);
 }
 
 void sendDummySensorData() {
-    StaticJsonDocument<256> doc;
-    doc["type"] = "sensor_data";
-    doc["temperature"] = 26.7 + random(-10, 10) / 10.0;
-    doc["humidity"] = 57.0 + random(-20, 20) / 10.0;
-    doc["timestamp"] = millis();
-    
-    String json;
-    serializeJson(doc, json);
-    processIncomingData(json);
-    Serial.println("Sent dummy: sensor_data");
+    SensorDataMsg msg;
+    msg.temperature = 26.7 + random(-10, 10) / 10.0;
+    msg.humidity = 57.0 + random(-20, 20) / 10.0;
+    msg.timestamp = millis();
+    injectDummyMessage(msg);
+}
+
+ContainerRec dummyContainer(int number, const char* medicineName, int quantity, bool lowStock) {
+    ContainerRec rec;
+    rec.id = number;
+    rec.container_id = number;
+    rec.container_number = number;
+    rec.medicine_name = medicineName;
+    rec.quantity = quantity;
+    rec.low_stock = lowStock;
+    return rec;
 }
 
 void sendDummyContainersInfo() {
-    StaticJsonDocument<1024> doc;
-    doc["type"] = "containers_info";
-    doc["timestamp"] = millis();
-    
-    JsonArray containersArray = doc.createNestedArray("containers");
-    
-    // Container 1
-    JsonObject container1 = containersArray.createNestedObject();
-    container1["id"] = 1;
-    container1["container_id"] = 1;
-    container1["container_number"] = 1;
-    container1["medicine_name"] = "Paracetamol";
-    container1["quantity"] = 50;
-    container1["low_stock"] = false;
-    
-    // Container 2
-    JsonObject container2 = containersArray.createNestedObject();
-    container2["id"] = 2;
-    container2["container_id"] = 2;
-    container2["container_number"] = 2;
-    container2["medicine_name"] = "Aspirin";
-    container2["quantity"] = 30;
-    container2["low_stock"] = false;
-    
-    // Container 3
-    JsonObject container3 = containersArray.createNestedObject();
-    container3["id"] = 3;
-    container3["container_id"] = 3;
-    container3["container_number"] = 3;
-    container3["medicine_name"] = "Ibuprofen";
-    container3["quantity"] = 5;
-    container3["low_stock"] = true;
-    
-    // Container 4
-    JsonObject container4 = containersArray.createNestedObject();
-    container4["id"] = 4;
-    container4["container_id"] = 4;
-    container4["container_number"] = 4;
-    container4["medicine_name"] = "Amoxicillin";
-    container4["quantity"] = 20;
-    container4["low_stock"] = false;
+    ContainerRec items[4];
+    items[0] = dummyContainer(1, "Paracetamol", 50, false);
+    items[1] = dummyContainer(2, "Aspirin", 30, false);
+    items[2] = dummyContainer(3, "Ibuprofen", 5, true);
+    items[3] = dummyContainer(4, "Amoxicillin", 20, false);
     
-    String json;
-    serializeJson(doc, json);
-    processIncomingData(json);
-    Serial.println("Sent dummy: containers_info");
+    ContainersInfoMsg msg;
+    msg.timestamp = millis();
+    msg.containers = MsgList<ContainerRec>::fromArray(items, 4);
+    injectDummyMessage(msg);
+}
+
+ReminderRec dummyReminder(int id, const char* medicineName, int container, bool active,
+                          const char* scheduleType, const char* notes,
+                          const ReminderTimeRec* times, size_t timeCount) {
+    ReminderRec rec;
+    rec.id = id;
+    rec.medicine_name = medicineName;
+    rec.container_id = container;
+    rec.container_number = container;
+    rec.active = active;
+    rec.schedule_type = scheduleType;
+    rec.notes = notes;
+    rec.times = MsgList<ReminderTimeRec>::fromArray(times, timeCount);
+    return rec;
 }
 
 void sendDummyRemindersInfo() {
-    StaticJsonDocument<2048> doc;
-    doc["type"] = "reminders_info";
-    doc["timestamp"] = millis();
-    
-    JsonArray remindersArray = doc.createNestedArray("reminders");
-    
-    // Reminder 1
-    JsonObject reminder1 = remindersArray.createNestedObject();
-    reminder1["id"] = 8;
-    reminder1["medicine_name"] = "Paracetamol";
-    reminder1["container_id"] = 1;
-    reminder1["container_number"] = 1;
-    reminder1["active"] = true;
-    reminder1["schedule_type"] = "Once Daily";
-    reminder1["notes"] = "Take with water";
-    JsonArray times1 = reminder1.createNestedArray("times");
-    JsonObject time1 = times1.createNestedObject();
-    time1["time"] = "08:00";
-    time1["dosage"] = 1;
-    
-    // Reminder 2
-    JsonObject reminder2 = remindersArray.createNestedObject();
-    reminder2["id"] = 9;
-    reminder2["medicine_name"] = "Aspirin";
-    reminder2["container_id"] = 2;
-    reminder2["container_number"] = 2;
-    reminder2["active"] = true;
-    reminder2["schedule_type"] = "Twice Daily";
-    reminder2["notes"] = "After meals";
-    JsonArray times2 = reminder2.createNestedArray("times");
-    JsonObject time2a = times2.createNestedObject();
-    time2a["time"] = "08:00";
-    time2a["dosage"] = 1;
-    JsonObject time2b = times2.createNestedObject();
-    time2b["time"] = "14:00";
-    time2b["dosage"] = 1;
-    
-    // Reminder 3
-    JsonObject reminder3 = remindersArray.createNestedObject();
-    reminder3["id"] = 10;
-    reminder3["medicine_name"] = "Ibuprofen";
-    reminder3["container_id"] = 3;
-    reminder3["container_number"] = 3;
-    reminder3["active"] = false;
-    reminder3["schedule_type"] = "As needed";
-    reminder3["notes"] = "Only if fever > 38C";
-    JsonArray times3 = reminder3.createNestedArray("times");
-    JsonObject time3 = times3.createNestedObject();
-    time3["time"] = "12:00";
-    time3["dosage"] = 1;
+    ReminderTimeRec times1[1];
+    times1[0].time = "08:00";
+    ReminderTimeRec times2[2];
+    times2[0].time = "08:00";
+    times2[1].time = "14:00";
+    ReminderTimeRec times3[1];
+    times3[0].time = "12:00";
     
-    String json;
-    serializeJson(doc, json);
-    processIncomingData(json);
-    Serial.println("Sent dummy: reminders_info");
+    ReminderRec items[3];
+    items[0] = dummyReminder(8, "Paracetamol", 1, true, "Once Daily", "Take with water", times1, 1);
+    items[1] = dummyReminder(9, "Aspirin", 2, true, "Twice Daily", "After meals", times2, 2);
+    items[2] = dummyReminder(10, "Ibuprofen", 3, false, "As needed", "Only if fever > 38C", times3, 1);
+    
+    RemindersInfoMsg msg;
+    msg.timestamp = millis();
+    msg.reminders = MsgList<ReminderRec>::fromArray(items, 3);
+    injectDummyMessage(msg);
+}
+
+ScheduleRec dummyScheduleItem(const char* medicineName, int container, const char* time,
+                              const char* scheduleType, const char* notes, int reminderId,
+                              const char* status) {
+    ScheduleRec rec;
+    rec.medicine_name = medicineName;
+    rec.container_id = container;
+    rec.container_number = container;
+    rec.time = time;
+    rec.dosage = 1;
+    rec.schedule_type = scheduleType;
+    rec.notes = notes;
+    rec.reminder_id = reminderId;
+    rec.status = status;
+    return rec;
 }
 
 void sendDummyDailySchedule() {
-    StaticJsonDocument<2048> doc;
-    doc["type"] = "daily_schedule";
-    doc["current_time"] = "17:25";
-    doc["timestamp"] = millis();
-    
-    JsonArray scheduleArray = doc.createNestedArray("schedule");
-    
-    // Schedule 1 - Paracetamol at 08:00
-    JsonObject schedule1 = scheduleArray.createNestedObject();
-    schedule1["medicine_name"] = "Paracetamol";
-    schedule1["container_id"] = 1;
-    schedule1["container_number"] = 1;
-    schedule1["time"] = "08:00";
-    schedule1["dosage"] = 1;
-    schedule1["schedule_type"] = "Once Daily";
-    schedule1["notes"] = "After breakfast";
-    schedule1["reminder_id"] = 8;
-    schedule1["status"] = "pending";
-    
-    // Schedule 2 - Aspirin at 08:00
-    JsonObject schedule2 = scheduleArray.createNestedObject();
-    schedule2["medicine_name"] = "Aspirin";
-    schedule2["container_id"] = 2;
-    schedule2["container_number"] = 2;
-    schedule2["time"] = "08:00";
-    schedule2["dosage"] = 1;
-    schedule2["schedule_type"] = "Twice Daily";
-    schedule2["notes"] = "After breakfast";
-    schedule2["reminder_id"] = 9;
-    schedule2["status"] = "completed";
-    
-    // Schedule 3 - Aspirin at 14:00
-    JsonObject schedule3 = scheduleArray.createNestedObject();
-    schedule3["medicine_name"] = "Aspirin";
-    schedule3["container_id"] = 2;
-    schedule3["container_number"] = 2;
-    schedule3["time"] = "14:00";
-    schedule3["dosage"] = 1;
-    schedule3["schedule_type"] = "Twice Daily";
-    schedule3["notes"] = "After lunch";
-    schedule3["reminder_id"] = 9;
-    schedule3["status"] = "pending";
-    
-    // Schedule 4 - Paracetamol at 20:00
-    JsonObject schedule4 = scheduleArray.createNestedObject();
-    schedule4["medicine_name"] = "Paracetamol";
-    schedule4["container_id"] = 1;
-    schedule4["container_number"] = 1;
-    schedule4["time"] = "20:00";
-    schedule4["dosage"] = 1;
-    schedule4["schedule_type"] = "Once Daily";
-    schedule4["notes"] = "Before sleep";
-    schedule4["reminder_id"] = 8;
-    schedule4["status"] = "pending";
+    ScheduleRec items[4];
+    items[0] = dummyScheduleItem("Paracetamol", 1, "08:00", "Once Daily", "After breakfast", 8, "pending");
+    items[1] = dummyScheduleItem("Aspirin", 2, "08:00", "Twice Daily", "After breakfast", 9, "completed");
+    items[2] = dummyScheduleItem("Aspirin", 2, "14:00", "Twice Daily", "After lunch", 9, "pending");
+    items[3] = dummyScheduleItem("Paracetamol", 1, "20:00", "Once Daily", "Before sleep", 8, "pending");
     
-    String json;
-    serializeJson(doc, json);
-    processIncomingData(json);
-    Serial.println("Sent dummy: daily_schedule");
+    DailyScheduleMsg msg;
+    msg.current_time = "17:25";
+    msg.timestamp = millis();
+    msg.schedule = MsgList<ScheduleRec>::fromArray(items, 4);
+    injectDummyMessage(msg);
 }
 
 void sendDummyReminderAlert() {
-    StaticJsonDocument<512> doc;
-    doc["type"] = "reminder_alert";
-    doc["medicine_name"] = "Paracetamol";
-    doc["container_number"] = 1;
-    doc["container_id"] = 1;
-    doc["dosage"] = 1;
-    doc["schedule_type"] = "Once Daily";
-    doc["notes"] = "Take with water";
-    doc["reminder_time"] = "17:25";
-    doc["timestamp"] = millis();
-    doc["alert_count"] = 1;
-    
-    String json;
-    serializeJson(doc, json);
-    processIncomingData(json);
-    Serial.println("Sent dummy: reminder_alert");
+    ReminderAlertMsg msg;
+    msg.medicine_name = "Paracetamol";
+    msg.container_id = 1;
+    msg.dosage = 1;
+    msg.schedule_type = "Once Daily";
+    msg.notes = "Take with water";
+    msg.reminder_time = "17:25";
+    msg.timestamp = millis();
+    msg.alert_count = 1;
+    injectDummyMessage(msg);
 }
 
 void sendDummyGroupedReminderAlert() {
-    StaticJsonDocument<2048> doc;
-    doc["type"] = "grouped_reminder_alert";
-    doc["timestamp"] = millis();
-    doc["alert_count"] = 2;
-    doc["reminder_time"] = "14:00";
-    
-    JsonArray alertsArray = doc.createNestedArray("alerts");
-    
-    // Alert 1
-    JsonObject alert1 = alertsArray.createNestedObject();
-    alert1["medicine_name"] = "Paracetamol";
-    alert1["container_id"] = 1;
-    alert1["container_number"] = 1;
-    alert1["dosage"] = 1;
-    alert1["schedule_type"] = "Once Daily";
-    alert1["notes"] = "After meal";
-    alert1["reminder_id"] = 8;
-    
-    // Alert 2
-    JsonObject alert2 = alertsArray.createNestedObject();
-    alert2["medicine_name"] = "Aspirin";
-    alert2["container_id"] = 2;
-    alert2["container_number"] = 2;
-    alert2["dosage"] = 1;
-    alert2["schedule_type"] = "Twice Daily";
-    alert2["notes"] = "With food";
-    alert2["reminder_id"] = 9;
+    AlertRec alerts[2];
+    alerts[0].medicine_name = "Paracetamol";
+    alerts[0].container_id = 1;
+    alerts[0].container_number = 1;
+    alerts[0].schedule_type = "Once Daily";
+    alerts[0].notes = "After meal";
+    alerts[0].reminder_id = 8;
+    alerts[1].medicine_name = "Aspirin";
+    alerts[1].container_id = 2;
+    alerts[1].container_number = 2;
+    alerts[1].schedule_type = "Twice Daily";
+    alerts[1].notes = "With food";
+    alerts[1].reminder_id = 9;
     
-    String json;
-    serializeJson(doc, json);
-    processIncomingData(json);
-    Serial.println("Sent dummy: grouped_reminder_alert");
+    GroupedReminderAlertMsg msg;
+    msg.timestamp = millis();
+    msg.alert_count = 2;
+    msg.reminder_time = "14:00";
+    msg.alerts = MsgList<AlertRec>::fromArray(alerts, 2);
+    injectDummyMessage(msg);
 }
 
 void sendDummyAlarmStatus(bool active) {
-    StaticJsonDocument<256> doc;
-    doc["type"] = "alarm_status";
-    doc["alarm_active"] = active;
-    doc["alarm_type"] = active ? "daily_log" : "";
-    doc["timestamp"] = millis();
-    
-    String json;
-    serializeJson(doc, json);
-    processIncomingData(json);
-    Serial.printf("Sent dummy: alarm_status (active=%s)\n", active ? "true" : "false");
+    AlarmStatusMsg msg;
+    msg.alarm_active = active;
+    msg.alarm_type = active ? "daily_log" : "";
+    msg.timestamp = millis();
+    injectDummyMessage(msg);
 }
 
 void sendDummyDispensingStatus(const char* status) {
-    StaticJsonDocument<512> doc;
-    doc["type"] = "dispensing_status";
-    doc["container_number"] = 1;
-    doc["container_id"] = 1;
-    doc["dosage"] = 2;
-    doc["medicine_name"] = "Paracetamol";
-    doc["status"] = status;  // "started" or "completed"
-    doc["pills_remaining"] = (strcmp(status, "started") == 0) ? 28 : 28;
-    doc["timestamp"] = millis();
-    
-    String json;
-    serializeJson(doc, json);
-    processIncomingData(json);
-    Serial.printf("Sent dummy: dispensing_status (status=%s)\n", status);
+    DispensingStatusMsg msg;
+    msg.container_number = 1;
+    msg.dosage = 2;
+    msg.medicine_name = "Paracetamol";
+    msg.status = status;  // "started" or "completed"
+    msg.pills_remaining = 28;
+    msg.timestamp = millis();
+    injectDummyMessage(msg);
 }
 
 void sendDummyStockAlert() {
-    StaticJsonDocument<512> doc;
-    doc["type"] = "stock_alert";
-    doc["medicine_name"] = "Ibuprofen";
-    doc["container_number"] = 3;
-    doc["container_id"] = 3;
-    doc["current_stock"] = 5;
-    doc["minimum_stock"] = 10;
-    doc["alert_level"] = "low";
-    doc["recommendation"] = "Please refill soon";
-    doc["timestamp"] = millis();
+    StockAlertMsg msg;
+    msg.medicine_name = "Ibuprofen";
+    msg.container_number = 3;
+    msg.current_stock = 5;
+    msg.minimum_stock = 10;
+    msg.alert_level = "low";
+    msg.recommendation = "Please refill soon";
+    msg.timestamp = millis();
+    injectDummyMessage(msg);
+}
+
+// ====================================
+// SELF CHECKS
+// ====================================
+
+// Syncs all three collections from in-memory records and returns the heap
+// allocations on the way, for test/test_alloc (0 without the ALLOC_COUNT
+// flags). Overwrites the model with the test data.
+uint32_t syncAllocations() {
+    ContainerRec containerItems[2];
+    containerItems[0] = dummyContainer(1, "Paracetamol", 50, false);
+    containerItems[1] = dummyContainer(2, "A medicine name far too long to fit in a container record", 5, true);
     
-    String json;
-    serializeJson(doc, json);
-    processIncomingData(json);
-    Serial.println("Sent dummy: stock_alert");
-}
\ No newline at end of file
+    ReminderTimeRec times[2];
+    times[0].time = "08:00";
+    times[1].time = "20:00";
+    ReminderRec reminderItems[1];
+    reminderItems[0] = dummyReminder(1, "Paracetamol", 1, true, "Twice Daily", "After meals", times, 2);
+    
+    ScheduleRec scheduleItems[2];
+    scheduleItems[0] = dummyScheduleItem("Paracetamol", 1, "08:00", "Twice Daily", "", 1, "completed");
+    scheduleItems[1] = dummyScheduleItem("Paracetamol", 1, "20:00", "Twice Daily", "", 1, "pending");
+    
+    uint32_t before = allocCount();
+    syncContainers(MsgList<ContainerRec>::fromArray(containerItems, 2));
+    syncReminders(MsgList<ReminderRec>::fromArray(reminderItems, 1));
+    syncDailySchedule(MsgList<ScheduleRec>::fromArray(scheduleItems, 2));
+    return allocCount() - before;
+}
+
+// After syncAllocations(): all five records name the same medicine, so they
+// share one id
+bool syncedNamesShared() {
+    return containers[0].medicine == reminders[0].medicine && reminders[0].medicine == dailySchedule[1].medicine;
+}
+
+// Syncs a day of 48 doses and 30 reminders with 3 times each, more than the
+// old fixed arrays held, and checks nothing was dropped. Overwrites the model.
+void checkModelCapacity() {
+    static const char* names[] = {"Paracetamol", "Aspirin", "Ibuprofen", "Amoxicillin", "Metformin", "Lisinopril"};
+    char times[48][6];
+    ScheduleRec scheduleItems[48];
+    for (int i = 0; i < 48; i++) {
+        snprintf(times[i], sizeof(times[i]), "%02d:%02d", i / 2, (i % 2) * 30);
+        scheduleItems[i] = dummyScheduleItem(names[i % 6], i % 6 + 1, times[i], "Daily", "", i + 1, "pending");
+    }
+    
+    ReminderTimeRec reminderTimesIn[3];
+    reminderTimesIn[0].time = "08:00";
+    reminderTimesIn[1].time = "14:00";
+    reminderTimesIn[2].time = "20:00";
+    ReminderRec reminderItems[30];
+    for (int i = 0; i < 30; i++) {
+        reminderItems[i] = dummyReminder(i + 1, names[i % 6], i % 6 + 1, true, "Daily", "", reminderTimesIn, 3);
+    }
+    
+    syncDailySchedule(MsgList<ScheduleRec>::fromArray(scheduleItems, 48));
+    syncReminders(MsgList<ReminderRec>::fromArray(reminderItems, 30));
+    
+    if (dailySchedule.size() == 48 && reminders.size() == 30 && reminderTimes.size() == 90) {
+        LOG_INFO("Self-check: model holds 48 doses and 30 reminders (%u of %u arena bytes)",
+                 (unsigned)arenaUsed(), (unsigned)MODEL_ARENA_SIZE);
+    } else {
+        LOG_ERROR("Self-check: model kept %u doses, %u reminders, %u times",
+                  (unsigned)dailySchedule.size(), (unsigned)reminders.size(), (unsigned)reminderTimes.size());
+    }
+}
+
+// Bytes on the wire as JSON and as binary
+template <typename T>
+void measureMsg(const T& msg, size_t& jsonBytes, size_t& binaryBytes) {
+    JsonDocument doc;
+    encodeMsg(msg, doc.to<JsonObject>());
+    jsonBytes = measureJson(doc);
+    
+    uint8_t buf[FRAME_MAX_DATA];
+    BinWriter out(buf, sizeof(buf));
+    encodeMsg(msg, out);
+    binaryBytes = out.ok() ? out.length() : 0;
+}
+
+// Marks one dose taken on the Schedule screen, first by resending the whole
+// day and then with schedule_item_status, and logs the bytes and the time to
+// apply and draw each. Overwrites the model.
+void benchScheduleStatusUpdate() {
+    static const char* names[] = {"Paracetamol", "Aspirin", "Ibuprofen", "Amoxicillin", "Metformin", "Lisinopril"};
+    char times[16][6];
+    ScheduleRec items[16];
+    for (int i = 0; i < 16; i++) {
+        snprintf(times[i], sizeof(times[i]), "%02d:00", i + 6);
+        items[i] = dummyScheduleItem(names[i % 6], i % 6 + 1, times[i], "Daily", "", i + 1, "pending");
+    }
+    DailyScheduleMsg full;
+    full.schedule = MsgList<ScheduleRec>::fromArray(items, 16);
+    handleMessage(full);
+    currentState = STATE_SCHEDULE;
+    updateDisplay();
+    
+    // Full path: the minder resends the day with one status changed
+    items[2].status = "completed";
+    unsigned long start = micros();
+    handleMessage(full);
+    unsigned long fullUs = micros() - start;
+    size_t fullJson, fullBinary;
+    measureMsg(full, fullJson, fullBinary);
+    
+    // Row path: just the one dose
+    ScheduleItemStatusMsg one;
+    one.reminder_id = 4;
+    one.time = times[3];
+    one.status = "completed";
+    start = micros();
+    handleMessage(one);
+    unsigned long rowUs = micros() - start;
+    size_t rowJson, rowBinary;
+    measureMsg(one, rowJson, rowBinary);
+    
+    if (dailySchedule[3].status != "completed" || modelStats.pendingDoses != 14) {
+        LOG_ERROR("Self-check: schedule_item_status did not update the row");
+    }
+    LOG_INFO("Bench: full schedule %u B JSON / %u B binary, %lu us", (unsigned)fullJson, (unsigned)fullBinary, fullUs);
+    LOG_INFO("Bench: schedule_item_status %u B JSON / %u B binary, %lu us", (unsigned)rowJson, (unsigned)rowBinary, rowUs);
+    currentState = STATE_HOME;
+}
+
+void benchBandHeights() {
+    static const uint8_t depths[] = {4, 8};
+    static const int heights[] = {16, 32, 48, 64, 96, 128, 240};
+    const int frames = 5;
+    
+    currentState = STATE_TAKE_MEDICINE;
+    updateDisplay();
+    
+    bandEnd();
+    unsigned long start = micros();
+    for (int frame = 0; frame < frames; frame++) {
+        dirtyInvalidateAll();
+        updateDisplay();
+    }
+    LOG_INFO("Bench: direct drawing, %lu us per frame", (micros() - start) / frames);
+    
+    for (int pingPong = 0; pingPong < 2; pingPong++) {
+        for (uint8_t bits : depths) {
+            for (int rows : heights) {
+                if (!bandBegin(tft, rows, bits, uiPalette, 16, pingPong)) continue;
+                start = micros();
+                for (int frame = 0; frame < frames; frame++) {
+                    dirtyInvalidateAll();
+                    updateDisplay();
+                }
+                LOG_INFO("Bench: %d-bit bands of %d rows%s (%u bytes), %lu us per frame",
+                         bits, rows, pingPong ? ", ping-pong" : "", (unsigned)bandBytes(),
+                         (micros() - start) / frames);
+            }
+        }
+    }
+    
+    bandBegin(tft, BAND_HEIGHT, BAND_BITS, uiPalette, 16, BAND_PING_PONG);
+    currentState = STATE_HOME;
+}
+
+// Enters each layered modal screen with its static layers dropped (built on
+// the way) and again with them cached, and times a countdown tick.
+void benchStaticLayers() {
+    static const DisplayState screens[] = {STATE_ALARM, STATE_TAKE_MEDICINE, STATE_QUANTITY_CONFIRMATION,
+                                           STATE_CONTAINER_SELECTION, STATE_JAM_ALERT, STATE_WIFI_ERROR,
+                                           STATE_CONTROL_QUEUE_CONFIRMATION};
+    if (!bandActive()) {
+        LOG_WARN("Bench: static layers need the band compositor");
+        return;
+    }
+    
+    for (DisplayState state : screens) {
+        currentState = state;
+        bandDropLayers();
+        unsigned long start = micros();
+        dirtyInvalidateAll();
+        updateDisplay();
+        unsigned long coldUs = micros() - start;
+        
+        start = micros();
+        dirtyInvalidateAll();
+        updateDisplay();
+        unsigned long cachedUs = micros() - start;
+        
+        start = micros();
+        dirtyInvalidate(270, 15, 50, 20);
+        updateDisplay();
+        unsigned long tickUs = micros() - start;
+        
+        LOG_INFO("Bench: screen %d, cold %lu us, cached %lu us, countdown %lu us", (int)state, coldUs, cachedUs,
+                 tickUs);
+    }
+    
+    // All layers at once
+    for (DisplayState state : screens) {
+        currentState = state;
+        dirtyInvalidateAll();
+        updateDisplay();
+    }
+    LOG_INFO("Bench: static layers use %u of %u bytes", (unsigned)bandLayerBytes(), (unsigned)BAND_LAYER_POOL);
+    currentState = STATE_HOME;
+}
+
+// Feeds 6 hours of readings at 22 C with a 2-minute spike to 34 C and checks
+// the downsampled chart and the hour tier still show it. Fills the sensor
+// history with test readings.
+void checkSensorChart() {
+    unsigned long t = millis();
+    for (int minute = 0; minute < 360; minute++) {
+        float temperature = (minute == 200 || minute == 201) ? 34.0 : 22.0;
+        sensorHistoryAdd(temperature, 50.0, t + minute * 60000UL);
+    }
+    
+    uint32_t first = sensorHistoryEnd(TIER_MINUTE) - 360;
+    ChartPoint points[CHART_BUCKETS];
+    unsigned long start = micros();
+    int count = sensorHistoryDownsample(TIER_MINUTE, false, first, 360, CHART_BUCKETS, points);
+    unsigned long us = micros() - start;
+    
+    bool spikeDrawn = false;
+    for (int i = 0; i < count; i++) {
+        if (points[i].value == 340) spikeDrawn = true;
+    }
+    // The hour holding the spike keeps it as its high, not in its average
+    bool hourKept = false;
+    SensorSample hour;
+    uint32_t hours = sensorHistoryEnd(TIER_HOUR);
+    for (uint32_t i = hours > 7 ? hours - 7 : 0; i < hours; i++) {
+        if (sensorHistoryGet(TIER_HOUR, i, hour) && hour.temperature.hi == 340 && hour.temperature.avg < 240) {
+            hourKept = true;
+        }
+    }
+    
+    if (spikeDrawn && hourKept) {
+        LOG_INFO("Self-check: 360 samples -> %d chart points in %lu us, spike kept", count, us);
+    } else {
+        LOG_ERROR("Self-check: spike lost (chart %d, hour tier %d)", spikeDrawn, hourKept);
+    }
+}
+
+// Records 40 days of two doses a day, taken on even days and missed on odd
+// ones with a late dose every third day, and checks the rolling 7- and 30-day
+// totals against a recount of the same days. Clears the adherence counters.
+void checkAdherence() {
+    adherenceReset();
+    NameId medicine = internName("Paracetamol");
+    AdherenceCounts expectWeek = {};
+    AdherenceCounts expectMonth = {};
+    for (int day = 0; day < 40; day++) {
+        DoseOutcome first = day % 3 == 0 ? DOSE_LATE : DOSE_TAKEN;
+        DoseOutcome second = day % 2 == 0 ? DOSE_TAKEN : DOSE_MISSED;
+        adherenceRecord(1, 8 * 60, medicine, DOSE_MISSED);
+        adherenceRecord(1, 8 * 60, medicine, first);   // replaces the miss
+        adherenceRecord(1, 8 * 60, medicine, first);   // repeated, ignored
+        adherenceRecord(2, 20 * 60, medicine, second);
+        
+        // Days 10..39 fall in the month, 33..39 in the week
+        DoseOutcome outcomes[2] = {first, second};
+        for (int i = 0; i < 2; i++) {
+            uint16_t* month = outcomes[i] == DOSE_TAKEN ? &expectMonth.taken : outcomes[i] == DOSE_LATE ? &expectMonth.late : &expectMonth.missed;
+            uint16_t* week = outcomes[i] == DOSE_TAKEN ? &expectWeek.taken : outcomes[i] == DOSE_LATE ? &expectWeek.late : &expectWeek.missed;
+            if (day >= 40 - ADHERENCE_DAYS) (*month)++;
+            if (day >= 40 - ADHERENCE_WEEK) (*week)++;
+        }
+        if (day < 39) adherenceRollDay();
+    }
+    
+    const AdherenceCounts& week = adherenceTotal(false);
+    const AdherenceCounts& month = adherenceTotal(true);
+    bool ok = memcmp(&week, &expectWeek, sizeof(week)) == 0 && memcmp(&month, &expectMonth, sizeof(month)) == 0 &&
+              memcmp(&adherenceForMedicine(0, true), &expectMonth, sizeof(month)) == 0;
+    if (ok) {
+        LOG_INFO("Self-check: adherence 7d %d%%, 30d %d%% match a recount",
+                 adherencePercent(week), adherencePercent(month));
+    } else {
+        LOG_ERROR("Self-check: adherence 7d %u/%u/%u, expected %u/%u/%u",
+                  week.taken, week.late, week.missed, expectWeek.taken, expectWeek.late, expectWeek.missed);
+    }
+}
+
+// Screens the allocation test draws (test/test_alloc)
+static const DisplayState allocCheckScreens[] = {
+    STATE_HOME, STATE_CONTAINERS, STATE_REMINDERS, STATE_SCHEDULE, STATE_HISTORY,
+    STATE_SENSOR_CHART, STATE_ADHERENCE, STATE_ALARM, STATE_TAKE_MEDICINE, STATE_DISPENSING,
+    STATE_QUANTITY_CONFIRMATION, STATE_CONTAINER_SELECTION, STATE_JAM_ALERT, STATE_WIFI_ERROR,
+    STATE_CONTROL_QUEUE_CONFIRMATION
+};
+
+int allocCheckScreenCount() {
+    return sizeof(allocCheckScreens) / sizeof(allocCheckScreens[0]);
+}
+
+// Draws allocCheckScreens[index] once on entry and then three more times with
+// its data marked changed; returns the heap allocations on the way (0 without
+// the ALLOC_COUNT flags). Leaves the display on the home screen.
+uint32_t screenAllocations(int index) {
+    uint32_t before = allocCount();
+    currentState = allocCheckScreens[index];
+    updateDisplay();
+    for (int frame = 0; frame < 3; frame++) {
+        containersScreenStale = remindersScreenStale = scheduleScreenStale = true;
+        historyScreenStale = chartScreenStale = adherenceScreenStale = true;
+        dirtyInvalidateAll();
+        redrawDataScreen();
+        updateDisplay();
+    }
+    uint32_t allocations = allocCount() - before;
+    currentState = STATE_HOME;
+    return allocations;
+}
+
+void checkModalRepaint() {
+    static const DisplayState screens[] = {
+        STATE_ALARM, STATE_TAKE_MEDICINE, STATE_DISPENSING, STATE_QUANTITY_CONFIRMATION,
+        STATE_CONTAINER_SELECTION, STATE_JAM_ALERT, STATE_WIFI_ERROR, STATE_CONTROL_QUEUE_CONFIRMATION
+    };
+    const int frames = 10;
+    uint32_t fullScreen = (uint32_t)tft.width() * tft.height();
+    
+    // Pixels sent after the first frame; the countdowns may tick once or twice
+    for (DisplayState screen : screens) {
+        currentState = screen;
+        updateDisplay();
+        uint32_t before = dirtyPixelsPainted();
+        for (int frame = 0; frame < frames; frame++) {
+            updateDisplay();
+            delay(100);
+        }
+        uint32_t pixels = dirtyPixelsPainted() - before;
+        LOG_INFO("Self-check: screen %d repainted %lu px over %d frames (full screen %lu px per frame)",
+                 screen, (unsigned long)pixels, frames, (unsigned long)fullScreen);
+    }
+    currentState = STATE_HOME;
+}
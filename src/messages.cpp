@@ -0,0 +1,3207 @@
+// Generated by tools/gen_messages.py from schema/messages.json - do not edit.
+#include "messages.h"
+
+const char* msgTypeName(MsgType type) {
+  switch (type) {
+    case MSG_STATUS: return "status";
+    case MSG_SYNC_ALL_DATA: return "sync_all_data";
+    case MSG_CONTAINERS_INFO: return "containers_info";
+    case MSG_REMINDERS_INFO: return "reminders_info";
+    case MSG_DAILY_SCHEDULE: return "daily_schedule";
+    case MSG_SENSOR_DATA: return "sensor_data";
+    case MSG_SYSTEM_STATUS: return "system_status";
+    case MSG_DEVICE_INFO: return "device_info";
+    case MSG_ALARM_STATUS: return "alarm_status";
+    case MSG_CONFIRMATION_REQUEST: return "confirmation_request";
+    case MSG_REMINDER_ALERT: return "reminder_alert";
+    case MSG_GROUPED_REMINDER_ALERT: return "grouped_reminder_alert";
+    case MSG_DISPENSING_STATUS: return "dispensing_status";
+    case MSG_ALL_DISPENSING_COMPLETED: return "all_dispensing_completed";
+    case MSG_STOCK_ALERT: return "stock_alert";
+    case MSG_JAM_ALERT: return "jam_alert";
+    case MSG_WIFI_ERROR_ALERT: return "wifi_error_alert";
+    case MSG_CURRENT_TIME: return "current_time";
+    case MSG_ERROR: return "error";
+    case MSG_CONTROL_QUEUE_COMPLETE: return "control_queue_complete";
+    case MSG_AP_MODE_STARTED: return "ap_mode_started";
+    case MSG_HELLO_ACK: return "hello_ack";
+    case MSG_BATCH: return "batch";
+    case MSG_SCHEDULE_ITEM_STATUS: return "schedule_item_status";
+    case MSG_OUTBOX_ACK: return "outbox_ack";
+    case MSG_CONFIRMATION_RESPONSE: return "confirmation_response";
+    case MSG_QUANTITY_CONFIRMED: return "quantity_confirmed";
+    case MSG_DISPENSING_REQUEST: return "dispensing_request";
+    case MSG_JAM_CLEARED: return "jam_cleared";
+    case MSG_HELLO: return "hello";
+    case MSG_OFFLINE_REMINDER: return "offline_reminder";
+    default: return "unknown";
+  }
+}
+
+MsgType msgTypeFromName(const char* name) {
+  if (!name) return MSG_UNKNOWN;
+  switch (name[0]) {
+    case 'a':
+      if (strcmp(name, "alarm_status") == 0) return MSG_ALARM_STATUS;
+      if (strcmp(name, "all_dispensing_completed") == 0) return MSG_ALL_DISPENSING_COMPLETED;
+      if (strcmp(name, "ap_mode_started") == 0) return MSG_AP_MODE_STARTED;
+      break;
+    case 'b':
+      if (strcmp(name, "batch") == 0) return MSG_BATCH;
+      break;
+    case 'c':
+      if (strcmp(name, "containers_info") == 0) return MSG_CONTAINERS_INFO;
+      if (strcmp(name, "confirmation_request") == 0) return MSG_CONFIRMATION_REQUEST;
+      if (strcmp(name, "current_time") == 0) return MSG_CURRENT_TIME;
+      if (strcmp(name, "control_queue_complete") == 0) return MSG_CONTROL_QUEUE_COMPLETE;
+      if (strcmp(name, "confirmation_response") == 0) return MSG_CONFIRMATION_RESPONSE;
+      break;
+    case 'd':
+      if (strcmp(name, "daily_schedule") == 0) return MSG_DAILY_SCHEDULE;
+      if (strcmp(name, "device_info") == 0) return MSG_DEVICE_INFO;
+      if (strcmp(name, "dispensing_status") == 0) return MSG_DISPENSING_STATUS;
+      if (strcmp(name, "dispensing_request") == 0) return MSG_DISPENSING_REQUEST;
+      break;
+    case 'e':
+      if (strcmp(name, "error") == 0) return MSG_ERROR;
+      break;
+    case 'g':
+      if (strcmp(name, "grouped_reminder_alert") == 0) return MSG_GROUPED_REMINDER_ALERT;
+      break;
+    case 'h':
+      if (strcmp(name, "hello_ack") == 0) return MSG_HELLO_ACK;
+      if (strcmp(name, "hello") == 0) return MSG_HELLO;
+      break;
+    case 'j':
+      if (strcmp(name, "jam_alert") == 0) return MSG_JAM_ALERT;
+      if (strcmp(name, "jam_cleared") == 0) return MSG_JAM_CLEARED;
+      break;
+    case 'o':
+      if (strcmp(name, "outbox_ack") == 0) return MSG_OUTBOX_ACK;
+      if (strcmp(name, "offline_reminder") == 0) return MSG_OFFLINE_REMINDER;
+      break;
+    case 'q':
+      if (strcmp(name, "quantity_confirmed") == 0) return MSG_QUANTITY_CONFIRMED;
+      break;
+    case 'r':
+      if (strcmp(name, "reminders_info") == 0) return MSG_REMINDERS_INFO;
+      if (strcmp(name, "reminder_alert") == 0) return MSG_REMINDER_ALERT;
+      break;
+    case 's':
+      if (strcmp(name, "status") == 0) return MSG_STATUS;
+      if (strcmp(name, "sync_all_data") == 0) return MSG_SYNC_ALL_DATA;
+      if (strcmp(name, "sensor_data") == 0) return MSG_SENSOR_DATA;
+      if (strcmp(name, "system_status") == 0) return MSG_SYSTEM_STATUS;
+      if (strcmp(name, "stock_alert") == 0) return MSG_STOCK_ALERT;
+      if (strcmp(name, "schedule_item_status") == 0) return MSG_SCHEDULE_ITEM_STATUS;
+      break;
+    case 'w':
+      if (strcmp(name, "wifi_error_alert") == 0) return MSG_WIFI_ERROR_ALERT;
+      break;
+  }
+  return MSG_UNKNOWN;
+}
+
+MsgType msgTypeFromId(uint8_t id) {
+  switch (id) {
+    case 1: return MSG_STATUS;
+    case 2: return MSG_SYNC_ALL_DATA;
+    case 3: return MSG_CONTAINERS_INFO;
+    case 4: return MSG_REMINDERS_INFO;
+    case 5: return MSG_DAILY_SCHEDULE;
+    case 6: return MSG_SENSOR_DATA;
+    case 7: return MSG_SYSTEM_STATUS;
+    case 8: return MSG_DEVICE_INFO;
+    case 9: return MSG_ALARM_STATUS;
+    case 10: return MSG_CONFIRMATION_REQUEST;
+    case 11: return MSG_REMINDER_ALERT;
+    case 12: return MSG_GROUPED_REMINDER_ALERT;
+    case 13: return MSG_DISPENSING_STATUS;
+    case 14: return MSG_ALL_DISPENSING_COMPLETED;
+    case 15: return MSG_STOCK_ALERT;
+    case 16: return MSG_JAM_ALERT;
+    case 17: return MSG_WIFI_ERROR_ALERT;
+    case 18: return MSG_CURRENT_TIME;
+    case 19: return MSG_ERROR;
+    case 20: return MSG_CONTROL_QUEUE_COMPLETE;
+    case 21: return MSG_AP_MODE_STARTED;
+    case 22: return MSG_HELLO_ACK;
+    case 23: return MSG_BATCH;
+    case 24: return MSG_SCHEDULE_ITEM_STATUS;
+    case 25: return MSG_OUTBOX_ACK;
+    case 64: return MSG_CONFIRMATION_RESPONSE;
+    case 65: return MSG_QUANTITY_CONFIRMED;
+    case 66: return MSG_DISPENSING_REQUEST;
+    case 67: return MSG_JAM_CLEARED;
+    case 68: return MSG_HELLO;
+    case 69: return MSG_OFFLINE_REMINDER;
+    default: return MSG_UNKNOWN;
+  }
+}
+
+bool readMsgHeader(BinReader& src, MsgType& type) {
+  if (src.getByte() != MSG_BINARY_MAGIC) return false;
+  type = msgTypeFromId(src.getByte());
+  return src.ok() && type != MSG_UNKNOWN;
+}
+
+bool decodeMsg(JsonObjectConst src, ContainerRec& dst) {
+  if (src.isNull()) return false;
+  dst = ContainerRec();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'c':
+        if (strcmp(key, "container_id") == 0) {
+          dst.container_id = kv.value() | dst.container_id;
+        } else if (strcmp(key, "container_number") == 0) {
+          dst.container_number = kv.value() | dst.container_number;
+        } else if (strcmp(key, "current_capacity") == 0) {
+          dst.current_capacity = kv.value() | dst.current_capacity;
+        }
+        break;
+      case 'i':
+        if (strcmp(key, "id") == 0) {
+          dst.id = kv.value() | dst.id;
+        }
+        break;
+      case 'l':
+        if (strcmp(key, "low_stock") == 0) {
+          dst.low_stock = kv.value() | dst.low_stock;
+        }
+        break;
+      case 'm':
+        if (strcmp(key, "medicine_name") == 0) {
+          dst.medicine_name = kv.value() | dst.medicine_name;
+        } else if (strcmp(key, "max_capacity") == 0) {
+          dst.max_capacity = kv.value() | dst.max_capacity;
+        }
+        break;
+      case 'q':
+        if (strcmp(key, "quantity") == 0) {
+          dst.quantity = kv.value() | dst.quantity;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, ContainerRec& dst) {
+  dst = ContainerRec();
+  dst.id = src.getInt();
+  dst.container_id = src.getInt();
+  dst.container_number = src.getInt();
+  dst.medicine_name = src.getString();
+  dst.current_capacity = src.getInt();
+  dst.max_capacity = src.getInt();
+  dst.quantity = src.getInt();
+  dst.low_stock = src.getBool();
+  return src.ok();
+}
+
+void encodeMsg(const ContainerRec& src, JsonObject dst) {
+  dst["id"] = src.id;
+  if (src.container_id != 0) dst["container_id"] = src.container_id;
+  if (src.container_number != 0) dst["container_number"] = src.container_number;
+  dst["medicine_name"] = src.medicine_name;
+  dst["current_capacity"] = src.current_capacity;
+  dst["max_capacity"] = src.max_capacity;
+  if (src.quantity != 0) dst["quantity"] = src.quantity;
+  dst["low_stock"] = src.low_stock;
+}
+
+void encodeMsg(const ContainerRec& src, BinWriter& dst) {
+  dst.putInt(src.id);
+  dst.putInt(src.container_id);
+  dst.putInt(src.container_number);
+  dst.putString(src.medicine_name);
+  dst.putInt(src.current_capacity);
+  dst.putInt(src.max_capacity);
+  dst.putInt(src.quantity);
+  dst.putBool(src.low_stock);
+}
+
+void writeJson(const ContainerRec& src, JsonWriter& out) {
+  out.raw("{\"id\":");
+  out.value(src.id);
+  if (src.container_id != 0) {
+    out.raw(",\"container_id\":");
+    out.value(src.container_id);
+  }
+  if (src.container_number != 0) {
+    out.raw(",\"container_number\":");
+    out.value(src.container_number);
+  }
+  out.raw(",\"medicine_name\":");
+  out.value(src.medicine_name);
+  out.raw(",\"current_capacity\":");
+  out.value(src.current_capacity);
+  out.raw(",\"max_capacity\":");
+  out.value(src.max_capacity);
+  if (src.quantity != 0) {
+    out.raw(",\"quantity\":");
+    out.value(src.quantity);
+  }
+  out.raw(",\"low_stock\":");
+  out.value(src.low_stock);
+  out.raw("}");
+}
+
+void hashMsg(const ContainerRec& src, MsgHash& h) {
+  h.add(src.id);
+  h.add(src.container_id);
+  h.add(src.container_number);
+  h.add(src.medicine_name);
+  h.add(src.current_capacity);
+  h.add(src.max_capacity);
+  h.add(src.quantity);
+  h.add(src.low_stock);
+}
+
+bool decodeMsg(JsonObjectConst src, ReminderTimeRec& dst) {
+  if (src.isNull()) return false;
+  dst = ReminderTimeRec();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'd':
+        if (strcmp(key, "dosage") == 0) {
+          dst.dosage = kv.value() | dst.dosage;
+        }
+        break;
+      case 't':
+        if (strcmp(key, "time") == 0) {
+          dst.time = kv.value() | dst.time;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, ReminderTimeRec& dst) {
+  dst = ReminderTimeRec();
+  dst.time = src.getString();
+  dst.dosage = src.getInt();
+  return src.ok();
+}
+
+void encodeMsg(const ReminderTimeRec& src, JsonObject dst) {
+  dst["time"] = src.time;
+  dst["dosage"] = src.dosage;
+}
+
+void encodeMsg(const ReminderTimeRec& src, BinWriter& dst) {
+  dst.putString(src.time);
+  dst.putInt(src.dosage);
+}
+
+void writeJson(const ReminderTimeRec& src, JsonWriter& out) {
+  out.raw("{\"time\":");
+  out.value(src.time);
+  out.raw(",\"dosage\":");
+  out.value(src.dosage);
+  out.raw("}");
+}
+
+void hashMsg(const ReminderTimeRec& src, MsgHash& h) {
+  h.add(src.time);
+  h.add(src.dosage);
+}
+
+bool decodeMsg(JsonObjectConst src, ReminderRec& dst) {
+  if (src.isNull()) return false;
+  dst = ReminderRec();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'a':
+        if (strcmp(key, "active") == 0) {
+          dst.active = kv.value() | dst.active;
+        }
+        break;
+      case 'c':
+        if (strcmp(key, "container_id") == 0) {
+          dst.container_id = kv.value() | dst.container_id;
+        } else if (strcmp(key, "container_number") == 0) {
+          dst.container_number = kv.value() | dst.container_number;
+        }
+        break;
+      case 'i':
+        if (strcmp(key, "id") == 0) {
+          dst.id = kv.value() | dst.id;
+        }
+        break;
+      case 'm':
+        if (strcmp(key, "medicine_name") == 0) {
+          dst.medicine_name = kv.value() | dst.medicine_name;
+        }
+        break;
+      case 'n':
+        if (strcmp(key, "notes") == 0) {
+          dst.notes = kv.value() | dst.notes;
+        }
+        break;
+      case 's':
+        if (strcmp(key, "schedule_type") == 0) {
+          dst.schedule_type = kv.value() | dst.schedule_type;
+        }
+        break;
+      case 't':
+        if (strcmp(key, "times") == 0) {
+          dst.times = MsgList<ReminderTimeRec>::fromJson(kv.value().as<JsonArrayConst>());
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, ReminderRec& dst) {
+  dst = ReminderRec();
+  dst.id = src.getInt();
+  dst.medicine_name = src.getString();
+  dst.container_id = src.getInt();
+  dst.container_number = src.getInt();
+  dst.schedule_type = src.getString();
+  dst.active = src.getBool();
+  dst.notes = src.getString();
+  src.getList(dst.times);
+  return src.ok();
+}
+
+void encodeMsg(const ReminderRec& src, JsonObject dst) {
+  dst["id"] = src.id;
+  dst["medicine_name"] = src.medicine_name;
+  dst["container_id"] = src.container_id;
+  if (src.container_number != 0) dst["container_number"] = src.container_number;
+  dst["schedule_type"] = src.schedule_type;
+  dst["active"] = src.active;
+  if (src.notes && src.notes[0]) dst["notes"] = src.notes;
+  {
+    JsonArray items = dst["times"].to<JsonArray>();
+    for (const ReminderTimeRec& item : src.times) {
+      encodeMsg(item, items.add<JsonObject>());
+    }
+  }
+}
+
+void encodeMsg(const ReminderRec& src, BinWriter& dst) {
+  dst.putInt(src.id);
+  dst.putString(src.medicine_name);
+  dst.putInt(src.container_id);
+  dst.putInt(src.container_number);
+  dst.putString(src.schedule_type);
+  dst.putBool(src.active);
+  dst.putString(src.notes);
+  {
+    size_t mark = dst.beginList();
+    uint16_t count = 0;
+    for (const ReminderTimeRec& item : src.times) {
+      encodeMsg(item, dst);
+      count++;
+    }
+    dst.endList(mark, count);
+  }
+}
+
+void writeJson(const ReminderRec& src, JsonWriter& out) {
+  out.raw("{\"id\":");
+  out.value(src.id);
+  out.raw(",\"medicine_name\":");
+  out.value(src.medicine_name);
+  out.raw(",\"container_id\":");
+  out.value(src.container_id);
+  if (src.container_number != 0) {
+    out.raw(",\"container_number\":");
+    out.value(src.container_number);
+  }
+  out.raw(",\"schedule_type\":");
+  out.value(src.schedule_type);
+  out.raw(",\"active\":");
+  out.value(src.active);
+  if (src.notes && src.notes[0]) {
+    out.raw(",\"notes\":");
+    out.value(src.notes);
+  }
+  out.raw(",\"times\":[");
+  {
+    bool firstItem = true;
+    for (const ReminderTimeRec& item : src.times) {
+      if (!firstItem) out.raw(",");
+      writeJson(item, out);
+      firstItem = false;
+    }
+  }
+  out.raw("]}");
+}
+
+void hashMsg(const ReminderRec& src, MsgHash& h) {
+  h.add(src.id);
+  h.add(src.medicine_name);
+  h.add(src.container_id);
+  h.add(src.container_number);
+  h.add(src.schedule_type);
+  h.add(src.active);
+  h.add(src.notes);
+  h.add((uint32_t)src.times.size());
+  for (const ReminderTimeRec& item : src.times) {
+    hashMsg(item, h);
+  }
+}
+
+bool decodeMsg(JsonObjectConst src, ScheduleRec& dst) {
+  if (src.isNull()) return false;
+  dst = ScheduleRec();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'c':
+        if (strcmp(key, "container_id") == 0) {
+          dst.container_id = kv.value() | dst.container_id;
+        } else if (strcmp(key, "container_number") == 0) {
+          dst.container_number = kv.value() | dst.container_number;
+        }
+        break;
+      case 'd':
+        if (strcmp(key, "dosage") == 0) {
+          dst.dosage = kv.value() | dst.dosage;
+        }
+        break;
+      case 'm':
+        if (strcmp(key, "medicine_name") == 0) {
+          dst.medicine_name = kv.value() | dst.medicine_name;
+        }
+        break;
+      case 'n':
+        if (strcmp(key, "notes") == 0) {
+          dst.notes = kv.value() | dst.notes;
+        }
+        break;
+      case 'r':
+        if (strcmp(key, "reminder_id") == 0) {
+          dst.reminder_id = kv.value() | dst.reminder_id;
+        }
+        break;
+      case 's':
+        if (strcmp(key, "schedule_type") == 0) {
+          dst.schedule_type = kv.value() | dst.schedule_type;
+        } else if (strcmp(key, "status") == 0) {
+          dst.status = kv.value() | dst.status;
+        }
+        break;
+      case 't':
+        if (strcmp(key, "time") == 0) {
+          dst.time = kv.value() | dst.time;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, ScheduleRec& dst) {
+  dst = ScheduleRec();
+  dst.time = src.getString();
+  dst.medicine_name = src.getString();
+  dst.container_id = src.getInt();
+  dst.container_number = src.getInt();
+  dst.dosage = src.getInt();
+  dst.schedule_type = src.getString();
+  dst.notes = src.getString();
+  dst.reminder_id = src.getInt();
+  dst.status = src.getString();
+  return src.ok();
+}
+
+void encodeMsg(const ScheduleRec& src, JsonObject dst) {
+  dst["time"] = src.time;
+  dst["medicine_name"] = src.medicine_name;
+  if (src.container_id != 0) dst["container_id"] = src.container_id;
+  if (src.container_number != 0) dst["container_number"] = src.container_number;
+  dst["dosage"] = src.dosage;
+  if (src.schedule_type && src.schedule_type[0]) dst["schedule_type"] = src.schedule_type;
+  if (src.notes && src.notes[0]) dst["notes"] = src.notes;
+  if (src.reminder_id != 0) dst["reminder_id"] = src.reminder_id;
+  dst["status"] = src.status;
+}
+
+void encodeMsg(const ScheduleRec& src, BinWriter& dst) {
+  dst.putString(src.time);
+  dst.putString(src.medicine_name);
+  dst.putInt(src.container_id);
+  dst.putInt(src.container_number);
+  dst.putInt(src.dosage);
+  dst.putString(src.schedule_type);
+  dst.putString(src.notes);
+  dst.putInt(src.reminder_id);
+  dst.putString(src.status);
+}
+
+void writeJson(const ScheduleRec& src, JsonWriter& out) {
+  out.raw("{\"time\":");
+  out.value(src.time);
+  out.raw(",\"medicine_name\":");
+  out.value(src.medicine_name);
+  if (src.container_id != 0) {
+    out.raw(",\"container_id\":");
+    out.value(src.container_id);
+  }
+  if (src.container_number != 0) {
+    out.raw(",\"container_number\":");
+    out.value(src.container_number);
+  }
+  out.raw(",\"dosage\":");
+  out.value(src.dosage);
+  if (src.schedule_type && src.schedule_type[0]) {
+    out.raw(",\"schedule_type\":");
+    out.value(src.schedule_type);
+  }
+  if (src.notes && src.notes[0]) {
+    out.raw(",\"notes\":");
+    out.value(src.notes);
+  }
+  if (src.reminder_id != 0) {
+    out.raw(",\"reminder_id\":");
+    out.value(src.reminder_id);
+  }
+  out.raw(",\"status\":");
+  out.value(src.status);
+  out.raw("}");
+}
+
+void hashMsg(const ScheduleRec& src, MsgHash& h) {
+  h.add(src.time);
+  h.add(src.medicine_name);
+  h.add(src.container_id);
+  h.add(src.container_number);
+  h.add(src.dosage);
+  h.add(src.schedule_type);
+  h.add(src.notes);
+  h.add(src.reminder_id);
+  h.add(src.status);
+}
+
+bool decodeMsg(JsonObjectConst src, ReminderItemRec& dst) {
+  if (src.isNull()) return false;
+  dst = ReminderItemRec();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'c':
+        if (strcmp(key, "container_id") == 0) {
+          dst.container_id = kv.value() | dst.container_id;
+        }
+        break;
+      case 'd':
+        if (strcmp(key, "dosage") == 0) {
+          dst.dosage = kv.value() | dst.dosage;
+        }
+        break;
+      case 'i':
+        if (strcmp(key, "id") == 0) {
+          dst.id = kv.value() | dst.id;
+        }
+        break;
+      case 'm':
+        if (strcmp(key, "medicine_name") == 0) {
+          dst.medicine_name = kv.value() | dst.medicine_name;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, ReminderItemRec& dst) {
+  dst = ReminderItemRec();
+  dst.id = src.getInt();
+  dst.medicine_name = src.getString();
+  dst.container_id = src.getInt();
+  dst.dosage = src.getInt();
+  return src.ok();
+}
+
+void encodeMsg(const ReminderItemRec& src, JsonObject dst) {
+  dst["id"] = src.id;
+  dst["medicine_name"] = src.medicine_name;
+  dst["container_id"] = src.container_id;
+  dst["dosage"] = src.dosage;
+}
+
+void encodeMsg(const ReminderItemRec& src, BinWriter& dst) {
+  dst.putInt(src.id);
+  dst.putString(src.medicine_name);
+  dst.putInt(src.container_id);
+  dst.putInt(src.dosage);
+}
+
+void writeJson(const ReminderItemRec& src, JsonWriter& out) {
+  out.raw("{\"id\":");
+  out.value(src.id);
+  out.raw(",\"medicine_name\":");
+  out.value(src.medicine_name);
+  out.raw(",\"container_id\":");
+  out.value(src.container_id);
+  out.raw(",\"dosage\":");
+  out.value(src.dosage);
+  out.raw("}");
+}
+
+void hashMsg(const ReminderItemRec& src, MsgHash& h) {
+  h.add(src.id);
+  h.add(src.medicine_name);
+  h.add(src.container_id);
+  h.add(src.dosage);
+}
+
+bool decodeMsg(JsonObjectConst src, AlertRec& dst) {
+  if (src.isNull()) return false;
+  dst = AlertRec();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'c':
+        if (strcmp(key, "container_id") == 0) {
+          dst.container_id = kv.value() | dst.container_id;
+        } else if (strcmp(key, "container_number") == 0) {
+          dst.container_number = kv.value() | dst.container_number;
+        }
+        break;
+      case 'd':
+        if (strcmp(key, "dosage") == 0) {
+          dst.dosage = kv.value() | dst.dosage;
+        }
+        break;
+      case 'm':
+        if (strcmp(key, "medicine_name") == 0) {
+          dst.medicine_name = kv.value() | dst.medicine_name;
+        }
+        break;
+      case 'n':
+        if (strcmp(key, "notes") == 0) {
+          dst.notes = kv.value() | dst.notes;
+        }
+        break;
+      case 'r':
+        if (strcmp(key, "reminder_id") == 0) {
+          dst.reminder_id = kv.value() | dst.reminder_id;
+        }
+        break;
+      case 's':
+        if (strcmp(key, "schedule_type") == 0) {
+          dst.schedule_type = kv.value() | dst.schedule_type;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, AlertRec& dst) {
+  dst = AlertRec();
+  dst.medicine_name = src.getString();
+  dst.container_id = src.getInt();
+  dst.container_number = src.getInt();
+  dst.dosage = src.getInt();
+  dst.schedule_type = src.getString();
+  dst.notes = src.getString();
+  dst.reminder_id = src.getInt();
+  return src.ok();
+}
+
+void encodeMsg(const AlertRec& src, JsonObject dst) {
+  dst["medicine_name"] = src.medicine_name;
+  dst["container_id"] = src.container_id;
+  if (src.container_number != 0) dst["container_number"] = src.container_number;
+  dst["dosage"] = src.dosage;
+  if (src.schedule_type && src.schedule_type[0]) dst["schedule_type"] = src.schedule_type;
+  if (src.notes && src.notes[0]) dst["notes"] = src.notes;
+  if (src.reminder_id != 0) dst["reminder_id"] = src.reminder_id;
+}
+
+void encodeMsg(const AlertRec& src, BinWriter& dst) {
+  dst.putString(src.medicine_name);
+  dst.putInt(src.container_id);
+  dst.putInt(src.container_number);
+  dst.putInt(src.dosage);
+  dst.putString(src.schedule_type);
+  dst.putString(src.notes);
+  dst.putInt(src.reminder_id);
+}
+
+void writeJson(const AlertRec& src, JsonWriter& out) {
+  out.raw("{\"medicine_name\":");
+  out.value(src.medicine_name);
+  out.raw(",\"container_id\":");
+  out.value(src.container_id);
+  if (src.container_number != 0) {
+    out.raw(",\"container_number\":");
+    out.value(src.container_number);
+  }
+  out.raw(",\"dosage\":");
+  out.value(src.dosage);
+  if (src.schedule_type && src.schedule_type[0]) {
+    out.raw(",\"schedule_type\":");
+    out.value(src.schedule_type);
+  }
+  if (src.notes && src.notes[0]) {
+    out.raw(",\"notes\":");
+    out.value(src.notes);
+  }
+  if (src.reminder_id != 0) {
+    out.raw(",\"reminder_id\":");
+    out.value(src.reminder_id);
+  }
+  out.raw("}");
+}
+
+void hashMsg(const AlertRec& src, MsgHash& h) {
+  h.add(src.medicine_name);
+  h.add(src.container_id);
+  h.add(src.container_number);
+  h.add(src.dosage);
+  h.add(src.schedule_type);
+  h.add(src.notes);
+  h.add(src.reminder_id);
+}
+
+bool decodeMsg(JsonObjectConst src, StatusMsg& dst) {
+  if (src.isNull()) return false;
+  dst = StatusMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'm':
+        if (strcmp(key, "message") == 0) {
+          dst.message = kv.value() | dst.message;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, StatusMsg& dst) {
+  dst = StatusMsg();
+  dst.message = src.getString();
+  return src.ok();
+}
+
+void encodeMsg(const StatusMsg& src, JsonObject dst) {
+  dst["type"] = "status";
+  dst["message"] = src.message;
+}
+
+void encodeMsg(const StatusMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_STATUS);
+  dst.putString(src.message);
+}
+
+void writeJson(const StatusMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"status\",\"message\":");
+  out.value(src.message);
+  out.raw("}");
+}
+
+void hashMsg(const StatusMsg& src, MsgHash& h) {
+  h.add(src.message);
+}
+
+bool decodeMsg(JsonObjectConst src, SyncAllDataMsg& dst) {
+  if (src.isNull()) return false;
+  dst = SyncAllDataMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'c':
+        if (strcmp(key, "containers") == 0) {
+          dst.containers = MsgList<ContainerRec>::fromJson(kv.value().as<JsonArrayConst>());
+        }
+        break;
+      case 'd':
+        if (strcmp(key, "daily_schedule") == 0) {
+          dst.daily_schedule = MsgList<ScheduleRec>::fromJson(kv.value().as<JsonArrayConst>());
+        }
+        break;
+      case 'm':
+        if (strcmp(key, "mqtt_connected") == 0) {
+          dst.mqtt_connected = kv.value() | dst.mqtt_connected;
+        }
+        break;
+      case 'r':
+        if (strcmp(key, "reminders") == 0) {
+          dst.reminders = MsgList<ReminderRec>::fromJson(kv.value().as<JsonArrayConst>());
+        }
+        break;
+      case 't':
+        if (strcmp(key, "time_synced") == 0) {
+          dst.time_synced = kv.value() | dst.time_synced;
+        }
+        break;
+      case 'w':
+        if (strcmp(key, "wifi_connected") == 0) {
+          dst.wifi_connected = kv.value() | dst.wifi_connected;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, SyncAllDataMsg& dst) {
+  dst = SyncAllDataMsg();
+  dst.wifi_connected = src.getBool();
+  dst.mqtt_connected = src.getBool();
+  dst.time_synced = src.getBool();
+  src.getList(dst.containers);
+  src.getList(dst.reminders);
+  src.getList(dst.daily_schedule);
+  return src.ok();
+}
+
+void encodeMsg(const SyncAllDataMsg& src, JsonObject dst) {
+  dst["type"] = "sync_all_data";
+  dst["wifi_connected"] = src.wifi_connected;
+  dst["mqtt_connected"] = src.mqtt_connected;
+  dst["time_synced"] = src.time_synced;
+  {
+    JsonArray items = dst["containers"].to<JsonArray>();
+    for (const ContainerRec& item : src.containers) {
+      encodeMsg(item, items.add<JsonObject>());
+    }
+  }
+  {
+    JsonArray items = dst["reminders"].to<JsonArray>();
+    for (const ReminderRec& item : src.reminders) {
+      encodeMsg(item, items.add<JsonObject>());
+    }
+  }
+  {
+    JsonArray items = dst["daily_schedule"].to<JsonArray>();
+    for (const ScheduleRec& item : src.daily_schedule) {
+      encodeMsg(item, items.add<JsonObject>());
+    }
+  }
+}
+
+void encodeMsg(const SyncAllDataMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_SYNC_ALL_DATA);
+  dst.putBool(src.wifi_connected);
+  dst.putBool(src.mqtt_connected);
+  dst.putBool(src.time_synced);
+  {
+    size_t mark = dst.beginList();
+    uint16_t count = 0;
+    for (const ContainerRec& item : src.containers) {
+      encodeMsg(item, dst);
+      count++;
+    }
+    dst.endList(mark, count);
+  }
+  {
+    size_t mark = dst.beginList();
+    uint16_t count = 0;
+    for (const ReminderRec& item : src.reminders) {
+      encodeMsg(item, dst);
+      count++;
+    }
+    dst.endList(mark, count);
+  }
+  {
+    size_t mark = dst.beginList();
+    uint16_t count = 0;
+    for (const ScheduleRec& item : src.daily_schedule) {
+      encodeMsg(item, dst);
+      count++;
+    }
+    dst.endList(mark, count);
+  }
+}
+
+void writeJson(const SyncAllDataMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"sync_all_data\",\"wifi_connected\":");
+  out.value(src.wifi_connected);
+  out.raw(",\"mqtt_connected\":");
+  out.value(src.mqtt_connected);
+  out.raw(",\"time_synced\":");
+  out.value(src.time_synced);
+  out.raw(",\"containers\":[");
+  {
+    bool firstItem = true;
+    for (const ContainerRec& item : src.containers) {
+      if (!firstItem) out.raw(",");
+      writeJson(item, out);
+      firstItem = false;
+    }
+  }
+  out.raw("],\"reminders\":[");
+  {
+    bool firstItem = true;
+    for (const ReminderRec& item : src.reminders) {
+      if (!firstItem) out.raw(",");
+      writeJson(item, out);
+      firstItem = false;
+    }
+  }
+  out.raw("],\"daily_schedule\":[");
+  {
+    bool firstItem = true;
+    for (const ScheduleRec& item : src.daily_schedule) {
+      if (!firstItem) out.raw(",");
+      writeJson(item, out);
+      firstItem = false;
+    }
+  }
+  out.raw("]}");
+}
+
+void hashMsg(const SyncAllDataMsg& src, MsgHash& h) {
+  h.add(src.wifi_connected);
+  h.add(src.mqtt_connected);
+  h.add(src.time_synced);
+  h.add((uint32_t)src.containers.size());
+  for (const ContainerRec& item : src.containers) {
+    hashMsg(item, h);
+  }
+  h.add((uint32_t)src.reminders.size());
+  for (const ReminderRec& item : src.reminders) {
+    hashMsg(item, h);
+  }
+  h.add((uint32_t)src.daily_schedule.size());
+  for (const ScheduleRec& item : src.daily_schedule) {
+    hashMsg(item, h);
+  }
+}
+
+bool decodeMsg(JsonObjectConst src, ContainersInfoMsg& dst) {
+  if (src.isNull()) return false;
+  dst = ContainersInfoMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'c':
+        if (strcmp(key, "containers") == 0) {
+          dst.containers = MsgList<ContainerRec>::fromJson(kv.value().as<JsonArrayConst>());
+        }
+        break;
+      case 't':
+        if (strcmp(key, "timestamp") == 0) {
+          dst.timestamp = kv.value() | dst.timestamp;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, ContainersInfoMsg& dst) {
+  dst = ContainersInfoMsg();
+  dst.timestamp = src.getVarint();
+  src.getList(dst.containers);
+  return src.ok();
+}
+
+void encodeMsg(const ContainersInfoMsg& src, JsonObject dst) {
+  dst["type"] = "containers_info";
+  if (src.timestamp != 0) dst["timestamp"] = src.timestamp;
+  {
+    JsonArray items = dst["containers"].to<JsonArray>();
+    for (const ContainerRec& item : src.containers) {
+      encodeMsg(item, items.add<JsonObject>());
+    }
+  }
+}
+
+void encodeMsg(const ContainersInfoMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_CONTAINERS_INFO);
+  dst.putVarint(src.timestamp);
+  {
+    size_t mark = dst.beginList();
+    uint16_t count = 0;
+    for (const ContainerRec& item : src.containers) {
+      encodeMsg(item, dst);
+      count++;
+    }
+    dst.endList(mark, count);
+  }
+}
+
+void writeJson(const ContainersInfoMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"containers_info\"");
+  if (src.timestamp != 0) {
+    out.raw(",\"timestamp\":");
+    out.value(src.timestamp);
+  }
+  out.raw(",\"containers\":[");
+  {
+    bool firstItem = true;
+    for (const ContainerRec& item : src.containers) {
+      if (!firstItem) out.raw(",");
+      writeJson(item, out);
+      firstItem = false;
+    }
+  }
+  out.raw("]}");
+}
+
+void hashMsg(const ContainersInfoMsg& src, MsgHash& h) {
+  h.add((uint32_t)src.containers.size());
+  for (const ContainerRec& item : src.containers) {
+    hashMsg(item, h);
+  }
+}
+
+bool decodeMsg(JsonObjectConst src, RemindersInfoMsg& dst) {
+  if (src.isNull()) return false;
+  dst = RemindersInfoMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'r':
+        if (strcmp(key, "reminders") == 0) {
+          dst.reminders = MsgList<ReminderRec>::fromJson(kv.value().as<JsonArrayConst>());
+        }
+        break;
+      case 't':
+        if (strcmp(key, "timestamp") == 0) {
+          dst.timestamp = kv.value() | dst.timestamp;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, RemindersInfoMsg& dst) {
+  dst = RemindersInfoMsg();
+  dst.timestamp = src.getVarint();
+  src.getList(dst.reminders);
+  return src.ok();
+}
+
+void encodeMsg(const RemindersInfoMsg& src, JsonObject dst) {
+  dst["type"] = "reminders_info";
+  if (src.timestamp != 0) dst["timestamp"] = src.timestamp;
+  {
+    JsonArray items = dst["reminders"].to<JsonArray>();
+    for (const ReminderRec& item : src.reminders) {
+      encodeMsg(item, items.add<JsonObject>());
+    }
+  }
+}
+
+void encodeMsg(const RemindersInfoMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_REMINDERS_INFO);
+  dst.putVarint(src.timestamp);
+  {
+    size_t mark = dst.beginList();
+    uint16_t count = 0;
+    for (const ReminderRec& item : src.reminders) {
+      encodeMsg(item, dst);
+      count++;
+    }
+    dst.endList(mark, count);
+  }
+}
+
+void writeJson(const RemindersInfoMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"reminders_info\"");
+  if (src.timestamp != 0) {
+    out.raw(",\"timestamp\":");
+    out.value(src.timestamp);
+  }
+  out.raw(",\"reminders\":[");
+  {
+    bool firstItem = true;
+    for (const ReminderRec& item : src.reminders) {
+      if (!firstItem) out.raw(",");
+      writeJson(item, out);
+      firstItem = false;
+    }
+  }
+  out.raw("]}");
+}
+
+void hashMsg(const RemindersInfoMsg& src, MsgHash& h) {
+  h.add((uint32_t)src.reminders.size());
+  for (const ReminderRec& item : src.reminders) {
+    hashMsg(item, h);
+  }
+}
+
+bool decodeMsg(JsonObjectConst src, DailyScheduleMsg& dst) {
+  if (src.isNull()) return false;
+  dst = DailyScheduleMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'c':
+        if (strcmp(key, "current_time") == 0) {
+          dst.current_time = kv.value() | dst.current_time;
+        }
+        break;
+      case 's':
+        if (strcmp(key, "schedule") == 0) {
+          dst.schedule = MsgList<ScheduleRec>::fromJson(kv.value().as<JsonArrayConst>());
+        }
+        break;
+      case 't':
+        if (strcmp(key, "timestamp") == 0) {
+          dst.timestamp = kv.value() | dst.timestamp;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, DailyScheduleMsg& dst) {
+  dst = DailyScheduleMsg();
+  dst.current_time = src.getString();
+  dst.timestamp = src.getVarint();
+  src.getList(dst.schedule);
+  return src.ok();
+}
+
+void encodeMsg(const DailyScheduleMsg& src, JsonObject dst) {
+  dst["type"] = "daily_schedule";
+  if (src.current_time && src.current_time[0]) dst["current_time"] = src.current_time;
+  if (src.timestamp != 0) dst["timestamp"] = src.timestamp;
+  {
+    JsonArray items = dst["schedule"].to<JsonArray>();
+    for (const ScheduleRec& item : src.schedule) {
+      encodeMsg(item, items.add<JsonObject>());
+    }
+  }
+}
+
+void encodeMsg(const DailyScheduleMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_DAILY_SCHEDULE);
+  dst.putString(src.current_time);
+  dst.putVarint(src.timestamp);
+  {
+    size_t mark = dst.beginList();
+    uint16_t count = 0;
+    for (const ScheduleRec& item : src.schedule) {
+      encodeMsg(item, dst);
+      count++;
+    }
+    dst.endList(mark, count);
+  }
+}
+
+void writeJson(const DailyScheduleMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"daily_schedule\"");
+  if (src.current_time && src.current_time[0]) {
+    out.raw(",\"current_time\":");
+    out.value(src.current_time);
+  }
+  if (src.timestamp != 0) {
+    out.raw(",\"timestamp\":");
+    out.value(src.timestamp);
+  }
+  out.raw(",\"schedule\":[");
+  {
+    bool firstItem = true;
+    for (const ScheduleRec& item : src.schedule) {
+      if (!firstItem) out.raw(",");
+      writeJson(item, out);
+      firstItem = false;
+    }
+  }
+  out.raw("]}");
+}
+
+void hashMsg(const DailyScheduleMsg& src, MsgHash& h) {
+  h.add(src.current_time);
+  h.add((uint32_t)src.schedule.size());
+  for (const ScheduleRec& item : src.schedule) {
+    hashMsg(item, h);
+  }
+}
+
+bool decodeMsg(JsonObjectConst src, SensorDataMsg& dst) {
+  if (src.isNull()) return false;
+  dst = SensorDataMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'h':
+        if (strcmp(key, "humidity") == 0) {
+          dst.humidity = kv.value() | dst.humidity;
+        }
+        break;
+      case 't':
+        if (strcmp(key, "temperature") == 0) {
+          dst.temperature = kv.value() | dst.temperature;
+        } else if (strcmp(key, "timestamp") == 0) {
+          dst.timestamp = kv.value() | dst.timestamp;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, SensorDataMsg& dst) {
+  dst = SensorDataMsg();
+  dst.temperature = src.getFloat();
+  dst.humidity = src.getFloat();
+  dst.timestamp = src.getVarint();
+  return src.ok();
+}
+
+void encodeMsg(const SensorDataMsg& src, JsonObject dst) {
+  dst["type"] = "sensor_data";
+  dst["temperature"] = src.temperature;
+  dst["humidity"] = src.humidity;
+  if (src.timestamp != 0) dst["timestamp"] = src.timestamp;
+}
+
+void encodeMsg(const SensorDataMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_SENSOR_DATA);
+  dst.putFloat(src.temperature);
+  dst.putFloat(src.humidity);
+  dst.putVarint(src.timestamp);
+}
+
+void writeJson(const SensorDataMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"sensor_data\",\"temperature\":");
+  out.value(src.temperature);
+  out.raw(",\"humidity\":");
+  out.value(src.humidity);
+  if (src.timestamp != 0) {
+    out.raw(",\"timestamp\":");
+    out.value(src.timestamp);
+  }
+  out.raw("}");
+}
+
+void hashMsg(const SensorDataMsg& src, MsgHash& h) {
+  h.add(src.temperature);
+  h.add(src.humidity);
+}
+
+bool decodeMsg(JsonObjectConst src, SystemStatusMsg& dst) {
+  if (src.isNull()) return false;
+  dst = SystemStatusMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'a':
+        if (strcmp(key, "ap_mode") == 0) {
+          dst.ap_mode = kv.value() | dst.ap_mode;
+        }
+        break;
+      case 'h':
+        if (strcmp(key, "humidity") == 0) {
+          dst.humidity = kv.value() | dst.humidity;
+        }
+        break;
+      case 'm':
+        if (strcmp(key, "mqtt_status") == 0) {
+          dst.mqtt_status = kv.value() | dst.mqtt_status;
+        }
+        break;
+      case 'o':
+        if (strcmp(key, "operation_mode") == 0) {
+          dst.operation_mode = kv.value() | dst.operation_mode;
+        }
+        break;
+      case 'p':
+        if (strcmp(key, "pending_actions") == 0) {
+          dst.pending_actions = kv.value() | dst.pending_actions;
+        }
+        break;
+      case 'r':
+        if (strcmp(key, "rtc_time_set") == 0) {
+          dst.rtc_time_set = kv.value() | dst.rtc_time_set;
+        }
+        break;
+      case 's':
+        if (strcmp(key, "sd_card_status") == 0) {
+          dst.sd_card_status = kv.value() | dst.sd_card_status;
+        }
+        break;
+      case 't':
+        if (strcmp(key, "temperature") == 0) {
+          dst.temperature = kv.value() | dst.temperature;
+        } else if (strcmp(key, "timestamp") == 0) {
+          dst.timestamp = kv.value() | dst.timestamp;
+        }
+        break;
+      case 'w':
+        if (strcmp(key, "wifi_status") == 0) {
+          dst.wifi_status = kv.value() | dst.wifi_status;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, SystemStatusMsg& dst) {
+  dst = SystemStatusMsg();
+  dst.wifi_status = src.getString();
+  dst.mqtt_status = src.getString();
+  dst.sd_card_status = src.getString();
+  dst.ap_mode = src.getBool();
+  dst.rtc_time_set = src.getBool();
+  dst.temperature = src.getFloat();
+  dst.humidity = src.getFloat();
+  dst.operation_mode = src.getString();
+  dst.pending_actions = src.getInt();
+  dst.timestamp = src.getVarint();
+  return src.ok();
+}
+
+void encodeMsg(const SystemStatusMsg& src, JsonObject dst) {
+  dst["type"] = "system_status";
+  dst["wifi_status"] = src.wifi_status;
+  dst["mqtt_status"] = src.mqtt_status;
+  if (src.sd_card_status && src.sd_card_status[0]) dst["sd_card_status"] = src.sd_card_status;
+  dst["ap_mode"] = src.ap_mode;
+  dst["rtc_time_set"] = src.rtc_time_set;
+  dst["temperature"] = src.temperature;
+  dst["humidity"] = src.humidity;
+  dst["operation_mode"] = src.operation_mode;
+  dst["pending_actions"] = src.pending_actions;
+  if (src.timestamp != 0) dst["timestamp"] = src.timestamp;
+}
+
+void encodeMsg(const SystemStatusMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_SYSTEM_STATUS);
+  dst.putString(src.wifi_status);
+  dst.putString(src.mqtt_status);
+  dst.putString(src.sd_card_status);
+  dst.putBool(src.ap_mode);
+  dst.putBool(src.rtc_time_set);
+  dst.putFloat(src.temperature);
+  dst.putFloat(src.humidity);
+  dst.putString(src.operation_mode);
+  dst.putInt(src.pending_actions);
+  dst.putVarint(src.timestamp);
+}
+
+void writeJson(const SystemStatusMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"system_status\",\"wifi_status\":");
+  out.value(src.wifi_status);
+  out.raw(",\"mqtt_status\":");
+  out.value(src.mqtt_status);
+  if (src.sd_card_status && src.sd_card_status[0]) {
+    out.raw(",\"sd_card_status\":");
+    out.value(src.sd_card_status);
+  }
+  out.raw(",\"ap_mode\":");
+  out.value(src.ap_mode);
+  out.raw(",\"rtc_time_set\":");
+  out.value(src.rtc_time_set);
+  out.raw(",\"temperature\":");
+  out.value(src.temperature);
+  out.raw(",\"humidity\":");
+  out.value(src.humidity);
+  out.raw(",\"operation_mode\":");
+  out.value(src.operation_mode);
+  out.raw(",\"pending_actions\":");
+  out.value(src.pending_actions);
+  if (src.timestamp != 0) {
+    out.raw(",\"timestamp\":");
+    out.value(src.timestamp);
+  }
+  out.raw("}");
+}
+
+void hashMsg(const SystemStatusMsg& src, MsgHash& h) {
+  h.add(src.wifi_status);
+  h.add(src.mqtt_status);
+  h.add(src.sd_card_status);
+  h.add(src.ap_mode);
+  h.add(src.rtc_time_set);
+  h.add(src.operation_mode);
+  h.add(src.pending_actions);
+}
+
+bool decodeMsg(JsonObjectConst src, DeviceInfoMsg& dst) {
+  if (src.isNull()) return false;
+  dst = DeviceInfoMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'c':
+        if (strcmp(key, "current_state") == 0) {
+          dst.current_state = kv.value() | dst.current_state;
+        }
+        break;
+      case 'd':
+        if (strcmp(key, "device_name") == 0) {
+          dst.device_name = kv.value() | dst.device_name;
+        }
+        break;
+      case 'h':
+        if (strcmp(key, "humidity") == 0) {
+          dst.humidity = kv.value() | dst.humidity;
+        }
+        break;
+      case 'i':
+        if (strcmp(key, "id") == 0) {
+          dst.id = kv.value() | dst.id;
+        }
+        break;
+      case 't':
+        if (strcmp(key, "temperature") == 0) {
+          dst.temperature = kv.value() | dst.temperature;
+        } else if (strcmp(key, "timestamp") == 0) {
+          dst.timestamp = kv.value() | dst.timestamp;
+        }
+        break;
+      case 'u':
+        if (strcmp(key, "uid") == 0) {
+          dst.uid = kv.value() | dst.uid;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, DeviceInfoMsg& dst) {
+  dst = DeviceInfoMsg();
+  dst.id = src.getInt();
+  dst.uid = src.getString();
+  dst.device_name = src.getString();
+  dst.current_state = src.getString();
+  dst.temperature = src.getFloat();
+  dst.humidity = src.getFloat();
+  dst.timestamp = src.getVarint();
+  return src.ok();
+}
+
+void encodeMsg(const DeviceInfoMsg& src, JsonObject dst) {
+  dst["type"] = "device_info";
+  dst["id"] = src.id;
+  dst["uid"] = src.uid;
+  dst["device_name"] = src.device_name;
+  dst["current_state"] = src.current_state;
+  dst["temperature"] = src.temperature;
+  dst["humidity"] = src.humidity;
+  if (src.timestamp != 0) dst["timestamp"] = src.timestamp;
+}
+
+void encodeMsg(const DeviceInfoMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_DEVICE_INFO);
+  dst.putInt(src.id);
+  dst.putString(src.uid);
+  dst.putString(src.device_name);
+  dst.putString(src.current_state);
+  dst.putFloat(src.temperature);
+  dst.putFloat(src.humidity);
+  dst.putVarint(src.timestamp);
+}
+
+void writeJson(const DeviceInfoMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"device_info\",\"id\":");
+  out.value(src.id);
+  out.raw(",\"uid\":");
+  out.value(src.uid);
+  out.raw(",\"device_name\":");
+  out.value(src.device_name);
+  out.raw(",\"current_state\":");
+  out.value(src.current_state);
+  out.raw(",\"temperature\":");
+  out.value(src.temperature);
+  out.raw(",\"humidity\":");
+  out.value(src.humidity);
+  if (src.timestamp != 0) {
+    out.raw(",\"timestamp\":");
+    out.value(src.timestamp);
+  }
+  out.raw("}");
+}
+
+void hashMsg(const DeviceInfoMsg& src, MsgHash& h) {
+  h.add(src.id);
+  h.add(src.uid);
+  h.add(src.device_name);
+  h.add(src.current_state);
+  h.add(src.temperature);
+  h.add(src.humidity);
+}
+
+bool decodeMsg(JsonObjectConst src, AlarmStatusMsg& dst) {
+  if (src.isNull()) return false;
+  dst = AlarmStatusMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'a':
+        if (strcmp(key, "alarm_active") == 0) {
+          dst.alarm_active = kv.value() | dst.alarm_active;
+        } else if (strcmp(key, "alarm_type") == 0) {
+          dst.alarm_type = kv.value() | dst.alarm_type;
+        }
+        break;
+      case 't':
+        if (strcmp(key, "timestamp") == 0) {
+          dst.timestamp = kv.value() | dst.timestamp;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, AlarmStatusMsg& dst) {
+  dst = AlarmStatusMsg();
+  dst.alarm_active = src.getBool();
+  dst.alarm_type = src.getString();
+  dst.timestamp = src.getVarint();
+  return src.ok();
+}
+
+void encodeMsg(const AlarmStatusMsg& src, JsonObject dst) {
+  dst["type"] = "alarm_status";
+  dst["alarm_active"] = src.alarm_active;
+  dst["alarm_type"] = src.alarm_type;
+  if (src.timestamp != 0) dst["timestamp"] = src.timestamp;
+}
+
+void encodeMsg(const AlarmStatusMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_ALARM_STATUS);
+  dst.putBool(src.alarm_active);
+  dst.putString(src.alarm_type);
+  dst.putVarint(src.timestamp);
+}
+
+void writeJson(const AlarmStatusMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"alarm_status\",\"alarm_active\":");
+  out.value(src.alarm_active);
+  out.raw(",\"alarm_type\":");
+  out.value(src.alarm_type);
+  if (src.timestamp != 0) {
+    out.raw(",\"timestamp\":");
+    out.value(src.timestamp);
+  }
+  out.raw("}");
+}
+
+void hashMsg(const AlarmStatusMsg& src, MsgHash& h) {
+  h.add(src.alarm_active);
+  h.add(src.alarm_type);
+}
+
+bool decodeMsg(JsonObjectConst src, ConfirmationRequestMsg& dst) {
+  if (src.isNull()) return false;
+  dst = ConfirmationRequestMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'a':
+        if (strcmp(key, "action") == 0) {
+          dst.action = kv.value() | dst.action;
+        }
+        break;
+      case 'c':
+        if (strcmp(key, "control_id") == 0) {
+          dst.control_id = kv.value() | dst.control_id;
+        } else if (strcmp(key, "container_id") == 0) {
+          dst.container_id = kv.value() | dst.container_id;
+        }
+        break;
+      case 'm':
+        if (strcmp(key, "medicine_name") == 0) {
+          dst.medicine_name = kv.value() | dst.medicine_name;
+        } else if (strcmp(key, "message") == 0) {
+          dst.message = kv.value() | dst.message;
+        }
+        break;
+      case 'q':
+        if (strcmp(key, "quantity") == 0) {
+          dst.quantity = kv.value() | dst.quantity;
+        }
+        break;
+      case 'r':
+        if (strcmp(key, "request_type") == 0) {
+          dst.request_type = kv.value() | dst.request_type;
+        } else if (strcmp(key, "reminders") == 0) {
+          dst.reminders = MsgList<ReminderItemRec>::fromJson(kv.value().as<JsonArrayConst>());
+        }
+        break;
+      case 't':
+        if (strcmp(key, "timeout_seconds") == 0) {
+          dst.timeout_seconds = kv.value() | dst.timeout_seconds;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, ConfirmationRequestMsg& dst) {
+  dst = ConfirmationRequestMsg();
+  dst.request_type = src.getString();
+  dst.timeout_seconds = src.getInt();
+  src.getList(dst.reminders);
+  dst.control_id = src.getInt();
+  dst.action = src.getString();
+  dst.medicine_name = src.getString();
+  dst.container_id = src.getInt();
+  dst.quantity = src.getInt();
+  dst.message = src.getString();
+  return src.ok();
+}
+
+void encodeMsg(const ConfirmationRequestMsg& src, JsonObject dst) {
+  dst["type"] = "confirmation_request";
+  dst["request_type"] = src.request_type;
+  dst["timeout_seconds"] = src.timeout_seconds;
+  {
+    JsonArray items = dst["reminders"].to<JsonArray>();
+    for (const ReminderItemRec& item : src.reminders) {
+      encodeMsg(item, items.add<JsonObject>());
+    }
+  }
+  if (src.control_id != 0) dst["control_id"] = src.control_id;
+  if (src.action && src.action[0]) dst["action"] = src.action;
+  if (src.medicine_name && src.medicine_name[0]) dst["medicine_name"] = src.medicine_name;
+  if (src.container_id != 0) dst["container_id"] = src.container_id;
+  if (src.quantity != 0) dst["quantity"] = src.quantity;
+  if (src.message && src.message[0]) dst["message"] = src.message;
+}
+
+void encodeMsg(const ConfirmationRequestMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_CONFIRMATION_REQUEST);
+  dst.putString(src.request_type);
+  dst.putInt(src.timeout_seconds);
+  {
+    size_t mark = dst.beginList();
+    uint16_t count = 0;
+    for (const ReminderItemRec& item : src.reminders) {
+      encodeMsg(item, dst);
+      count++;
+    }
+    dst.endList(mark, count);
+  }
+  dst.putInt(src.control_id);
+  dst.putString(src.action);
+  dst.putString(src.medicine_name);
+  dst.putInt(src.container_id);
+  dst.putInt(src.quantity);
+  dst.putString(src.message);
+}
+
+void writeJson(const ConfirmationRequestMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"confirmation_request\",\"request_type\":");
+  out.value(src.request_type);
+  out.raw(",\"timeout_seconds\":");
+  out.value(src.timeout_seconds);
+  out.raw(",\"reminders\":[");
+  {
+    bool firstItem = true;
+    for (const ReminderItemRec& item : src.reminders) {
+      if (!firstItem) out.raw(",");
+      writeJson(item, out);
+      firstItem = false;
+    }
+  }
+  out.raw("]");
+  if (src.control_id != 0) {
+    out.raw(",\"control_id\":");
+    out.value(src.control_id);
+  }
+  if (src.action && src.action[0]) {
+    out.raw(",\"action\":");
+    out.value(src.action);
+  }
+  if (src.medicine_name && src.medicine_name[0]) {
+    out.raw(",\"medicine_name\":");
+    out.value(src.medicine_name);
+  }
+  if (src.container_id != 0) {
+    out.raw(",\"container_id\":");
+    out.value(src.container_id);
+  }
+  if (src.quantity != 0) {
+    out.raw(",\"quantity\":");
+    out.value(src.quantity);
+  }
+  if (src.message && src.message[0]) {
+    out.raw(",\"message\":");
+    out.value(src.message);
+  }
+  out.raw("}");
+}
+
+void hashMsg(const ConfirmationRequestMsg& src, MsgHash& h) {
+  h.add(src.request_type);
+  h.add(src.timeout_seconds);
+  h.add((uint32_t)src.reminders.size());
+  for (const ReminderItemRec& item : src.reminders) {
+    hashMsg(item, h);
+  }
+  h.add(src.control_id);
+  h.add(src.action);
+  h.add(src.medicine_name);
+  h.add(src.container_id);
+  h.add(src.quantity);
+  h.add(src.message);
+}
+
+bool decodeMsg(JsonObjectConst src, ReminderAlertMsg& dst) {
+  if (src.isNull()) return false;
+  dst = ReminderAlertMsg();
+  bool seen_container_id = false;
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'a':
+        if (strcmp(key, "alert_count") == 0) {
+          dst.alert_count = kv.value() | dst.alert_count;
+        }
+        break;
+      case 'c':
+        if (strcmp(key, "container_id") == 0) {
+          dst.container_id = kv.value() | dst.container_id;
+          seen_container_id = true;
+        } else if (!seen_container_id && strcmp(key, "container_number") == 0) {
+          dst.container_id = kv.value() | dst.container_id;
+        }
+        break;
+      case 'd':
+        if (strcmp(key, "dosage") == 0) {
+          dst.dosage = kv.value() | dst.dosage;
+        }
+        break;
+      case 'm':
+        if (strcmp(key, "medicine_name") == 0) {
+          dst.medicine_name = kv.value() | dst.medicine_name;
+        }
+        break;
+      case 'n':
+        if (strcmp(key, "notes") == 0) {
+          dst.notes = kv.value() | dst.notes;
+        }
+        break;
+      case 'o':
+        if (strcmp(key, "operation_mode") == 0) {
+          dst.operation_mode = kv.value() | dst.operation_mode;
+        }
+        break;
+      case 'r':
+        if (strcmp(key, "reminder_time") == 0) {
+          dst.reminder_time = kv.value() | dst.reminder_time;
+        }
+        break;
+      case 's':
+        if (strcmp(key, "schedule_type") == 0) {
+          dst.schedule_type = kv.value() | dst.schedule_type;
+        } else if (strcmp(key, "source") == 0) {
+          dst.source = kv.value() | dst.source;
+        }
+        break;
+      case 't':
+        if (strcmp(key, "timestamp") == 0) {
+          dst.timestamp = kv.value() | dst.timestamp;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, ReminderAlertMsg& dst) {
+  dst = ReminderAlertMsg();
+  dst.medicine_name = src.getString();
+  dst.container_id = src.getInt();
+  dst.dosage = src.getInt();
+  dst.schedule_type = src.getString();
+  dst.notes = src.getString();
+  dst.reminder_time = src.getString();
+  dst.source = src.getString();
+  dst.operation_mode = src.getString();
+  dst.alert_count = src.getInt();
+  dst.timestamp = src.getVarint();
+  return src.ok();
+}
+
+void encodeMsg(const ReminderAlertMsg& src, JsonObject dst) {
+  dst["type"] = "reminder_alert";
+  dst["medicine_name"] = src.medicine_name;
+  dst["container_id"] = src.container_id;
+  dst["dosage"] = src.dosage;
+  dst["schedule_type"] = src.schedule_type;
+  dst["notes"] = src.notes;
+  dst["reminder_time"] = src.reminder_time;
+  dst["source"] = src.source;
+  dst["operation_mode"] = src.operation_mode;
+  if (src.alert_count != 0) dst["alert_count"] = src.alert_count;
+  if (src.timestamp != 0) dst["timestamp"] = src.timestamp;
+}
+
+void encodeMsg(const ReminderAlertMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_REMINDER_ALERT);
+  dst.putString(src.medicine_name);
+  dst.putInt(src.container_id);
+  dst.putInt(src.dosage);
+  dst.putString(src.schedule_type);
+  dst.putString(src.notes);
+  dst.putString(src.reminder_time);
+  dst.putString(src.source);
+  dst.putString(src.operation_mode);
+  dst.putInt(src.alert_count);
+  dst.putVarint(src.timestamp);
+}
+
+void writeJson(const ReminderAlertMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"reminder_alert\",\"medicine_name\":");
+  out.value(src.medicine_name);
+  out.raw(",\"container_id\":");
+  out.value(src.container_id);
+  out.raw(",\"dosage\":");
+  out.value(src.dosage);
+  out.raw(",\"schedule_type\":");
+  out.value(src.schedule_type);
+  out.raw(",\"notes\":");
+  out.value(src.notes);
+  out.raw(",\"reminder_time\":");
+  out.value(src.reminder_time);
+  out.raw(",\"source\":");
+  out.value(src.source);
+  out.raw(",\"operation_mode\":");
+  out.value(src.operation_mode);
+  if (src.alert_count != 0) {
+    out.raw(",\"alert_count\":");
+    out.value(src.alert_count);
+  }
+  if (src.timestamp != 0) {
+    out.raw(",\"timestamp\":");
+    out.value(src.timestamp);
+  }
+  out.raw("}");
+}
+
+void hashMsg(const ReminderAlertMsg& src, MsgHash& h) {
+  h.add(src.medicine_name);
+  h.add(src.container_id);
+  h.add(src.dosage);
+  h.add(src.schedule_type);
+  h.add(src.notes);
+  h.add(src.reminder_time);
+  h.add(src.source);
+  h.add(src.operation_mode);
+  h.add(src.alert_count);
+}
+
+bool decodeMsg(JsonObjectConst src, GroupedReminderAlertMsg& dst) {
+  if (src.isNull()) return false;
+  dst = GroupedReminderAlertMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'a':
+        if (strcmp(key, "alert_count") == 0) {
+          dst.alert_count = kv.value() | dst.alert_count;
+        } else if (strcmp(key, "alerts") == 0) {
+          dst.alerts = MsgList<AlertRec>::fromJson(kv.value().as<JsonArrayConst>());
+        }
+        break;
+      case 'r':
+        if (strcmp(key, "reminder_time") == 0) {
+          dst.reminder_time = kv.value() | dst.reminder_time;
+        }
+        break;
+      case 't':
+        if (strcmp(key, "timestamp") == 0) {
+          dst.timestamp = kv.value() | dst.timestamp;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, GroupedReminderAlertMsg& dst) {
+  dst = GroupedReminderAlertMsg();
+  dst.reminder_time = src.getString();
+  dst.alert_count = src.getInt();
+  src.getList(dst.alerts);
+  dst.timestamp = src.getVarint();
+  return src.ok();
+}
+
+void encodeMsg(const GroupedReminderAlertMsg& src, JsonObject dst) {
+  dst["type"] = "grouped_reminder_alert";
+  dst["reminder_time"] = src.reminder_time;
+  dst["alert_count"] = src.alert_count;
+  {
+    JsonArray items = dst["alerts"].to<JsonArray>();
+    for (const AlertRec& item : src.alerts) {
+      encodeMsg(item, items.add<JsonObject>());
+    }
+  }
+  if (src.timestamp != 0) dst["timestamp"] = src.timestamp;
+}
+
+void encodeMsg(const GroupedReminderAlertMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_GROUPED_REMINDER_ALERT);
+  dst.putString(src.reminder_time);
+  dst.putInt(src.alert_count);
+  {
+    size_t mark = dst.beginList();
+    uint16_t count = 0;
+    for (const AlertRec& item : src.alerts) {
+      encodeMsg(item, dst);
+      count++;
+    }
+    dst.endList(mark, count);
+  }
+  dst.putVarint(src.timestamp);
+}
+
+void writeJson(const GroupedReminderAlertMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"grouped_reminder_alert\",\"reminder_time\":");
+  out.value(src.reminder_time);
+  out.raw(",\"alert_count\":");
+  out.value(src.alert_count);
+  out.raw(",\"alerts\":[");
+  {
+    bool firstItem = true;
+    for (const AlertRec& item : src.alerts) {
+      if (!firstItem) out.raw(",");
+      writeJson(item, out);
+      firstItem = false;
+    }
+  }
+  out.raw("]");
+  if (src.timestamp != 0) {
+    out.raw(",\"timestamp\":");
+    out.value(src.timestamp);
+  }
+  out.raw("}");
+}
+
+void hashMsg(const GroupedReminderAlertMsg& src, MsgHash& h) {
+  h.add(src.reminder_time);
+  h.add(src.alert_count);
+  h.add((uint32_t)src.alerts.size());
+  for (const AlertRec& item : src.alerts) {
+    hashMsg(item, h);
+  }
+}
+
+bool decodeMsg(JsonObjectConst src, DispensingStatusMsg& dst) {
+  if (src.isNull()) return false;
+  dst = DispensingStatusMsg();
+  bool seen_container_number = false;
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'c':
+        if (strcmp(key, "container_number") == 0) {
+          dst.container_number = kv.value() | dst.container_number;
+          seen_container_number = true;
+        } else if (!seen_container_number && strcmp(key, "container_id") == 0) {
+          dst.container_number = kv.value() | dst.container_number;
+        }
+        break;
+      case 'd':
+        if (strcmp(key, "dosage") == 0) {
+          dst.dosage = kv.value() | dst.dosage;
+        }
+        break;
+      case 'm':
+        if (strcmp(key, "medicine_name") == 0) {
+          dst.medicine_name = kv.value() | dst.medicine_name;
+        }
+        break;
+      case 'p':
+        if (strcmp(key, "pills_remaining") == 0) {
+          dst.pills_remaining = kv.value() | dst.pills_remaining;
+        }
+        break;
+      case 's':
+        if (strcmp(key, "status") == 0) {
+          dst.status = kv.value() | dst.status;
+        }
+        break;
+      case 't':
+        if (strcmp(key, "timestamp") == 0) {
+          dst.timestamp = kv.value() | dst.timestamp;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, DispensingStatusMsg& dst) {
+  dst = DispensingStatusMsg();
+  dst.status = src.getString();
+  dst.medicine_name = src.getString();
+  dst.container_number = src.getInt();
+  dst.dosage = src.getInt();
+  dst.pills_remaining = src.getInt();
+  dst.timestamp = src.getVarint();
+  return src.ok();
+}
+
+void encodeMsg(const DispensingStatusMsg& src, JsonObject dst) {
+  dst["type"] = "dispensing_status";
+  dst["status"] = src.status;
+  dst["medicine_name"] = src.medicine_name;
+  dst["container_number"] = src.container_number;
+  dst["dosage"] = src.dosage;
+  if (src.pills_remaining != 0) dst["pills_remaining"] = src.pills_remaining;
+  if (src.timestamp != 0) dst["timestamp"] = src.timestamp;
+}
+
+void encodeMsg(const DispensingStatusMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_DISPENSING_STATUS);
+  dst.putString(src.status);
+  dst.putString(src.medicine_name);
+  dst.putInt(src.container_number);
+  dst.putInt(src.dosage);
+  dst.putInt(src.pills_remaining);
+  dst.putVarint(src.timestamp);
+}
+
+void writeJson(const DispensingStatusMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"dispensing_status\",\"status\":");
+  out.value(src.status);
+  out.raw(",\"medicine_name\":");
+  out.value(src.medicine_name);
+  out.raw(",\"container_number\":");
+  out.value(src.container_number);
+  out.raw(",\"dosage\":");
+  out.value(src.dosage);
+  if (src.pills_remaining != 0) {
+    out.raw(",\"pills_remaining\":");
+    out.value(src.pills_remaining);
+  }
+  if (src.timestamp != 0) {
+    out.raw(",\"timestamp\":");
+    out.value(src.timestamp);
+  }
+  out.raw("}");
+}
+
+void hashMsg(const DispensingStatusMsg& src, MsgHash& h) {
+  h.add(src.status);
+  h.add(src.medicine_name);
+  h.add(src.container_number);
+  h.add(src.dosage);
+  h.add(src.pills_remaining);
+}
+
+bool decodeMsg(JsonObjectConst src, AllDispensingCompletedMsg& dst) {
+  if (src.isNull()) return false;
+  dst = AllDispensingCompletedMsg();
+  return true;
+}
+
+bool decodeMsg(BinReader& src, AllDispensingCompletedMsg& dst) {
+  dst = AllDispensingCompletedMsg();
+  return src.ok();
+}
+
+void encodeMsg(const AllDispensingCompletedMsg& src, JsonObject dst) {
+  dst["type"] = "all_dispensing_completed";
+}
+
+void encodeMsg(const AllDispensingCompletedMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_ALL_DISPENSING_COMPLETED);
+}
+
+void writeJson(const AllDispensingCompletedMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"all_dispensing_completed\"}");
+}
+
+void hashMsg(const AllDispensingCompletedMsg& src, MsgHash& h) {
+  (void)src;
+  (void)h;
+}
+
+bool decodeMsg(JsonObjectConst src, StockAlertMsg& dst) {
+  if (src.isNull()) return false;
+  dst = StockAlertMsg();
+  bool seen_container_number = false;
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'a':
+        if (strcmp(key, "alert_level") == 0) {
+          dst.alert_level = kv.value() | dst.alert_level;
+        }
+        break;
+      case 'c':
+        if (strcmp(key, "container_number") == 0) {
+          dst.container_number = kv.value() | dst.container_number;
+          seen_container_number = true;
+        } else if (!seen_container_number && strcmp(key, "container_id") == 0) {
+          dst.container_number = kv.value() | dst.container_number;
+        } else if (strcmp(key, "current_stock") == 0) {
+          dst.current_stock = kv.value() | dst.current_stock;
+        }
+        break;
+      case 'm':
+        if (strcmp(key, "medicine_name") == 0) {
+          dst.medicine_name = kv.value() | dst.medicine_name;
+        } else if (strcmp(key, "minimum_stock") == 0) {
+          dst.minimum_stock = kv.value() | dst.minimum_stock;
+        }
+        break;
+      case 'r':
+        if (strcmp(key, "recommendation") == 0) {
+          dst.recommendation = kv.value() | dst.recommendation;
+        }
+        break;
+      case 't':
+        if (strcmp(key, "timestamp") == 0) {
+          dst.timestamp = kv.value() | dst.timestamp;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, StockAlertMsg& dst) {
+  dst = StockAlertMsg();
+  dst.medicine_name = src.getString();
+  dst.container_number = src.getInt();
+  dst.current_stock = src.getInt();
+  dst.minimum_stock = src.getInt();
+  dst.alert_level = src.getString();
+  dst.recommendation = src.getString();
+  dst.timestamp = src.getVarint();
+  return src.ok();
+}
+
+void encodeMsg(const StockAlertMsg& src, JsonObject dst) {
+  dst["type"] = "stock_alert";
+  dst["medicine_name"] = src.medicine_name;
+  dst["container_number"] = src.container_number;
+  dst["current_stock"] = src.current_stock;
+  dst["minimum_stock"] = src.minimum_stock;
+  if (src.alert_level && src.alert_level[0]) dst["alert_level"] = src.alert_level;
+  if (src.recommendation && src.recommendation[0]) dst["recommendation"] = src.recommendation;
+  if (src.timestamp != 0) dst["timestamp"] = src.timestamp;
+}
+
+void encodeMsg(const StockAlertMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_STOCK_ALERT);
+  dst.putString(src.medicine_name);
+  dst.putInt(src.container_number);
+  dst.putInt(src.current_stock);
+  dst.putInt(src.minimum_stock);
+  dst.putString(src.alert_level);
+  dst.putString(src.recommendation);
+  dst.putVarint(src.timestamp);
+}
+
+void writeJson(const StockAlertMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"stock_alert\",\"medicine_name\":");
+  out.value(src.medicine_name);
+  out.raw(",\"container_number\":");
+  out.value(src.container_number);
+  out.raw(",\"current_stock\":");
+  out.value(src.current_stock);
+  out.raw(",\"minimum_stock\":");
+  out.value(src.minimum_stock);
+  if (src.alert_level && src.alert_level[0]) {
+    out.raw(",\"alert_level\":");
+    out.value(src.alert_level);
+  }
+  if (src.recommendation && src.recommendation[0]) {
+    out.raw(",\"recommendation\":");
+    out.value(src.recommendation);
+  }
+  if (src.timestamp != 0) {
+    out.raw(",\"timestamp\":");
+    out.value(src.timestamp);
+  }
+  out.raw("}");
+}
+
+void hashMsg(const StockAlertMsg& src, MsgHash& h) {
+  h.add(src.medicine_name);
+  h.add(src.container_number);
+  h.add(src.current_stock);
+  h.add(src.minimum_stock);
+  h.add(src.alert_level);
+  h.add(src.recommendation);
+}
+
+bool decodeMsg(JsonObjectConst src, JamAlertMsg& dst) {
+  if (src.isNull()) return false;
+  dst = JamAlertMsg();
+  bool seen_container_number = false;
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'c':
+        if (strcmp(key, "container_number") == 0) {
+          dst.container_number = kv.value() | dst.container_number;
+          seen_container_number = true;
+        } else if (!seen_container_number && strcmp(key, "container_id") == 0) {
+          dst.container_number = kv.value() | dst.container_number;
+        }
+        break;
+      case 'm':
+        if (strcmp(key, "medicine_name") == 0) {
+          dst.medicine_name = kv.value() | dst.medicine_name;
+        }
+        break;
+      case 'p':
+        if (strcmp(key, "pills_remaining") == 0) {
+          dst.pills_remaining = kv.value() | dst.pills_remaining;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, JamAlertMsg& dst) {
+  dst = JamAlertMsg();
+  dst.container_number = src.getInt();
+  dst.medicine_name = src.getString();
+  dst.pills_remaining = src.getInt();
+  return src.ok();
+}
+
+void encodeMsg(const JamAlertMsg& src, JsonObject dst) {
+  dst["type"] = "jam_alert";
+  dst["container_number"] = src.container_number;
+  dst["medicine_name"] = src.medicine_name;
+  dst["pills_remaining"] = src.pills_remaining;
+}
+
+void encodeMsg(const JamAlertMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_JAM_ALERT);
+  dst.putInt(src.container_number);
+  dst.putString(src.medicine_name);
+  dst.putInt(src.pills_remaining);
+}
+
+void writeJson(const JamAlertMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"jam_alert\",\"container_number\":");
+  out.value(src.container_number);
+  out.raw(",\"medicine_name\":");
+  out.value(src.medicine_name);
+  out.raw(",\"pills_remaining\":");
+  out.value(src.pills_remaining);
+  out.raw("}");
+}
+
+void hashMsg(const JamAlertMsg& src, MsgHash& h) {
+  h.add(src.container_number);
+  h.add(src.medicine_name);
+  h.add(src.pills_remaining);
+}
+
+bool decodeMsg(JsonObjectConst src, WifiErrorAlertMsg& dst) {
+  if (src.isNull()) return false;
+  dst = WifiErrorAlertMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'i':
+        if (strcmp(key, "instruction") == 0) {
+          dst.instruction = kv.value() | dst.instruction;
+        }
+        break;
+      case 'm':
+        if (strcmp(key, "message") == 0) {
+          dst.message = kv.value() | dst.message;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, WifiErrorAlertMsg& dst) {
+  dst = WifiErrorAlertMsg();
+  dst.message = src.getString();
+  dst.instruction = src.getString();
+  return src.ok();
+}
+
+void encodeMsg(const WifiErrorAlertMsg& src, JsonObject dst) {
+  dst["type"] = "wifi_error_alert";
+  dst["message"] = src.message;
+  dst["instruction"] = src.instruction;
+}
+
+void encodeMsg(const WifiErrorAlertMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_WIFI_ERROR_ALERT);
+  dst.putString(src.message);
+  dst.putString(src.instruction);
+}
+
+void writeJson(const WifiErrorAlertMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"wifi_error_alert\",\"message\":");
+  out.value(src.message);
+  out.raw(",\"instruction\":");
+  out.value(src.instruction);
+  out.raw("}");
+}
+
+void hashMsg(const WifiErrorAlertMsg& src, MsgHash& h) {
+  h.add(src.message);
+  h.add(src.instruction);
+}
+
+bool decodeMsg(JsonObjectConst src, CurrentTimeMsg& dst) {
+  if (src.isNull()) return false;
+  dst = CurrentTimeMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 't':
+        if (strcmp(key, "time") == 0) {
+          dst.time = kv.value() | dst.time;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, CurrentTimeMsg& dst) {
+  dst = CurrentTimeMsg();
+  dst.time = src.getString();
+  return src.ok();
+}
+
+void encodeMsg(const CurrentTimeMsg& src, JsonObject dst) {
+  dst["type"] = "current_time";
+  dst["time"] = src.time;
+}
+
+void encodeMsg(const CurrentTimeMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_CURRENT_TIME);
+  dst.putString(src.time);
+}
+
+void writeJson(const CurrentTimeMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"current_time\",\"time\":");
+  out.value(src.time);
+  out.raw("}");
+}
+
+void hashMsg(const CurrentTimeMsg& src, MsgHash& h) {
+  h.add(src.time);
+}
+
+bool decodeMsg(JsonObjectConst src, ErrorMsg& dst) {
+  if (src.isNull()) return false;
+  dst = ErrorMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'm':
+        if (strcmp(key, "message") == 0) {
+          dst.message = kv.value() | dst.message;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, ErrorMsg& dst) {
+  dst = ErrorMsg();
+  dst.message = src.getString();
+  return src.ok();
+}
+
+void encodeMsg(const ErrorMsg& src, JsonObject dst) {
+  dst["type"] = "error";
+  dst["message"] = src.message;
+}
+
+void encodeMsg(const ErrorMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_ERROR);
+  dst.putString(src.message);
+}
+
+void writeJson(const ErrorMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"error\",\"message\":");
+  out.value(src.message);
+  out.raw("}");
+}
+
+void hashMsg(const ErrorMsg& src, MsgHash& h) {
+  h.add(src.message);
+}
+
+bool decodeMsg(JsonObjectConst src, ControlQueueCompleteMsg& dst) {
+  if (src.isNull()) return false;
+  dst = ControlQueueCompleteMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'm':
+        if (strcmp(key, "message") == 0) {
+          dst.message = kv.value() | dst.message;
+        }
+        break;
+      case 'q':
+        if (strcmp(key, "queue_id") == 0) {
+          dst.queue_id = kv.value() | dst.queue_id;
+        }
+        break;
+      case 's':
+        if (strcmp(key, "success") == 0) {
+          dst.success = kv.value() | dst.success;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, ControlQueueCompleteMsg& dst) {
+  dst = ControlQueueCompleteMsg();
+  dst.queue_id = src.getInt();
+  dst.success = src.getBool();
+  dst.message = src.getString();
+  return src.ok();
+}
+
+void encodeMsg(const ControlQueueCompleteMsg& src, JsonObject dst) {
+  dst["type"] = "control_queue_complete";
+  dst["queue_id"] = src.queue_id;
+  dst["success"] = src.success;
+  dst["message"] = src.message;
+}
+
+void encodeMsg(const ControlQueueCompleteMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_CONTROL_QUEUE_COMPLETE);
+  dst.putInt(src.queue_id);
+  dst.putBool(src.success);
+  dst.putString(src.message);
+}
+
+void writeJson(const ControlQueueCompleteMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"control_queue_complete\",\"queue_id\":");
+  out.value(src.queue_id);
+  out.raw(",\"success\":");
+  out.value(src.success);
+  out.raw(",\"message\":");
+  out.value(src.message);
+  out.raw("}");
+}
+
+void hashMsg(const ControlQueueCompleteMsg& src, MsgHash& h) {
+  h.add(src.queue_id);
+  h.add(src.success);
+  h.add(src.message);
+}
+
+bool decodeMsg(JsonObjectConst src, ApModeStartedMsg& dst) {
+  if (src.isNull()) return false;
+  dst = ApModeStartedMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'm':
+        if (strcmp(key, "message") == 0) {
+          dst.message = kv.value() | dst.message;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, ApModeStartedMsg& dst) {
+  dst = ApModeStartedMsg();
+  dst.message = src.getString();
+  return src.ok();
+}
+
+void encodeMsg(const ApModeStartedMsg& src, JsonObject dst) {
+  dst["type"] = "ap_mode_started";
+  dst["message"] = src.message;
+}
+
+void encodeMsg(const ApModeStartedMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_AP_MODE_STARTED);
+  dst.putString(src.message);
+}
+
+void writeJson(const ApModeStartedMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"ap_mode_started\",\"message\":");
+  out.value(src.message);
+  out.raw("}");
+}
+
+void hashMsg(const ApModeStartedMsg& src, MsgHash& h) {
+  h.add(src.message);
+}
+
+bool decodeMsg(JsonObjectConst src, HelloAckMsg& dst) {
+  if (src.isNull()) return false;
+  dst = HelloAckMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'e':
+        if (strcmp(key, "encodings") == 0) {
+          dst.encodings = kv.value() | dst.encodings;
+        }
+        break;
+      case 'f':
+        if (strcmp(key, "features") == 0) {
+          dst.features = kv.value() | dst.features;
+        }
+        break;
+      case 'm':
+        if (strcmp(key, "max_frame") == 0) {
+          dst.max_frame = kv.value() | dst.max_frame;
+        } else if (strcmp(key, "max_baud") == 0) {
+          dst.max_baud = kv.value() | dst.max_baud;
+        }
+        break;
+      case 'p':
+        if (strcmp(key, "proto_version") == 0) {
+          dst.proto_version = kv.value() | dst.proto_version;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, HelloAckMsg& dst) {
+  dst = HelloAckMsg();
+  dst.proto_version = src.getVarint();
+  dst.max_frame = src.getVarint();
+  dst.encodings = src.getVarint();
+  dst.features = src.getVarint();
+  dst.max_baud = src.getVarint();
+  return src.ok();
+}
+
+void encodeMsg(const HelloAckMsg& src, JsonObject dst) {
+  dst["type"] = "hello_ack";
+  dst["proto_version"] = src.proto_version;
+  dst["max_frame"] = src.max_frame;
+  dst["encodings"] = src.encodings;
+  dst["features"] = src.features;
+  dst["max_baud"] = src.max_baud;
+}
+
+void encodeMsg(const HelloAckMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_HELLO_ACK);
+  dst.putVarint(src.proto_version);
+  dst.putVarint(src.max_frame);
+  dst.putVarint(src.encodings);
+  dst.putVarint(src.features);
+  dst.putVarint(src.max_baud);
+}
+
+void writeJson(const HelloAckMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"hello_ack\",\"proto_version\":");
+  out.value(src.proto_version);
+  out.raw(",\"max_frame\":");
+  out.value(src.max_frame);
+  out.raw(",\"encodings\":");
+  out.value(src.encodings);
+  out.raw(",\"features\":");
+  out.value(src.features);
+  out.raw(",\"max_baud\":");
+  out.value(src.max_baud);
+  out.raw("}");
+}
+
+void hashMsg(const HelloAckMsg& src, MsgHash& h) {
+  h.add(src.proto_version);
+  h.add(src.max_frame);
+  h.add(src.encodings);
+  h.add(src.features);
+  h.add(src.max_baud);
+}
+
+bool decodeMsg(JsonObjectConst src, ScheduleItemStatusMsg& dst) {
+  if (src.isNull()) return false;
+  dst = ScheduleItemStatusMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'r':
+        if (strcmp(key, "reminder_id") == 0) {
+          dst.reminder_id = kv.value() | dst.reminder_id;
+        }
+        break;
+      case 's':
+        if (strcmp(key, "status") == 0) {
+          dst.status = kv.value() | dst.status;
+        }
+        break;
+      case 't':
+        if (strcmp(key, "time") == 0) {
+          dst.time = kv.value() | dst.time;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, ScheduleItemStatusMsg& dst) {
+  dst = ScheduleItemStatusMsg();
+  dst.reminder_id = src.getInt();
+  dst.time = src.getString();
+  dst.status = src.getString();
+  return src.ok();
+}
+
+void encodeMsg(const ScheduleItemStatusMsg& src, JsonObject dst) {
+  dst["type"] = "schedule_item_status";
+  dst["reminder_id"] = src.reminder_id;
+  dst["time"] = src.time;
+  dst["status"] = src.status;
+}
+
+void encodeMsg(const ScheduleItemStatusMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_SCHEDULE_ITEM_STATUS);
+  dst.putInt(src.reminder_id);
+  dst.putString(src.time);
+  dst.putString(src.status);
+}
+
+void writeJson(const ScheduleItemStatusMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"schedule_item_status\",\"reminder_id\":");
+  out.value(src.reminder_id);
+  out.raw(",\"time\":");
+  out.value(src.time);
+  out.raw(",\"status\":");
+  out.value(src.status);
+  out.raw("}");
+}
+
+void hashMsg(const ScheduleItemStatusMsg& src, MsgHash& h) {
+  h.add(src.reminder_id);
+  h.add(src.time);
+  h.add(src.status);
+}
+
+bool decodeMsg(JsonObjectConst src, OutboxAckMsg& dst) {
+  if (src.isNull()) return false;
+  dst = OutboxAckMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 's':
+        if (strcmp(key, "seq") == 0) {
+          dst.seq = kv.value() | dst.seq;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, OutboxAckMsg& dst) {
+  dst = OutboxAckMsg();
+  dst.seq = src.getVarint();
+  return src.ok();
+}
+
+void encodeMsg(const OutboxAckMsg& src, JsonObject dst) {
+  dst["type"] = "outbox_ack";
+  dst["seq"] = src.seq;
+}
+
+void encodeMsg(const OutboxAckMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_OUTBOX_ACK);
+  dst.putVarint(src.seq);
+}
+
+void writeJson(const OutboxAckMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"outbox_ack\",\"seq\":");
+  out.value(src.seq);
+  out.raw("}");
+}
+
+void hashMsg(const OutboxAckMsg& src, MsgHash& h) {
+  h.add(src.seq);
+}
+
+bool decodeMsg(JsonObjectConst src, ConfirmationResponseMsg& dst) {
+  if (src.isNull()) return false;
+  dst = ConfirmationResponseMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'c':
+        if (strcmp(key, "confirmed") == 0) {
+          dst.confirmed = kv.value() | dst.confirmed;
+        } else if (strcmp(key, "confirmation_type") == 0) {
+          dst.confirmation_type = kv.value() | dst.confirmation_type;
+        } else if (strcmp(key, "control_id") == 0) {
+          dst.control_id = kv.value() | dst.control_id;
+        }
+        break;
+      case 'q':
+        if (strcmp(key, "queued_at") == 0) {
+          dst.queued_at = kv.value() | dst.queued_at;
+        }
+        break;
+      case 's':
+        if (strcmp(key, "seq") == 0) {
+          dst.seq = kv.value() | dst.seq;
+        }
+        break;
+      case 't':
+        if (strcmp(key, "timeout") == 0) {
+          dst.timeout = kv.value() | dst.timeout;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, ConfirmationResponseMsg& dst) {
+  dst = ConfirmationResponseMsg();
+  dst.confirmed = src.getBool();
+  dst.timeout = src.getBool();
+  dst.confirmation_type = src.getInt();
+  dst.control_id = src.getInt();
+  dst.seq = src.getVarint();
+  dst.queued_at = src.getString();
+  return src.ok();
+}
+
+void encodeMsg(const ConfirmationResponseMsg& src, JsonObject dst) {
+  dst["type"] = "confirmation_response";
+  dst["confirmed"] = src.confirmed;
+  if (src.timeout) dst["timeout"] = src.timeout;
+  dst["confirmation_type"] = src.confirmation_type;
+  if (src.control_id != 0) dst["control_id"] = src.control_id;
+  if (src.seq != 0) dst["seq"] = src.seq;
+  if (src.queued_at && src.queued_at[0]) dst["queued_at"] = src.queued_at;
+}
+
+void encodeMsg(const ConfirmationResponseMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_CONFIRMATION_RESPONSE);
+  dst.putBool(src.confirmed);
+  dst.putBool(src.timeout);
+  dst.putInt(src.confirmation_type);
+  dst.putInt(src.control_id);
+  dst.putVarint(src.seq);
+  dst.putString(src.queued_at);
+}
+
+void writeJson(const ConfirmationResponseMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"confirmation_response\",\"confirmed\":");
+  out.value(src.confirmed);
+  if (src.timeout) {
+    out.raw(",\"timeout\":");
+    out.value(src.timeout);
+  }
+  out.raw(",\"confirmation_type\":");
+  out.value(src.confirmation_type);
+  if (src.control_id != 0) {
+    out.raw(",\"control_id\":");
+    out.value(src.control_id);
+  }
+  if (src.seq != 0) {
+    out.raw(",\"seq\":");
+    out.value(src.seq);
+  }
+  if (src.queued_at && src.queued_at[0]) {
+    out.raw(",\"queued_at\":");
+    out.value(src.queued_at, 5);
+  }
+  out.raw("}");
+}
+
+void hashMsg(const ConfirmationResponseMsg& src, MsgHash& h) {
+  h.add(src.confirmed);
+  h.add(src.timeout);
+  h.add(src.confirmation_type);
+  h.add(src.control_id);
+  h.add(src.seq);
+  h.add(src.queued_at);
+}
+
+bool decodeMsg(JsonObjectConst src, QuantityConfirmedMsg& dst) {
+  if (src.isNull()) return false;
+  dst = QuantityConfirmedMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'c':
+        if (strcmp(key, "confirmed") == 0) {
+          dst.confirmed = kv.value() | dst.confirmed;
+        }
+        break;
+      case 'q':
+        if (strcmp(key, "queued_at") == 0) {
+          dst.queued_at = kv.value() | dst.queued_at;
+        }
+        break;
+      case 's':
+        if (strcmp(key, "seq") == 0) {
+          dst.seq = kv.value() | dst.seq;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, QuantityConfirmedMsg& dst) {
+  dst = QuantityConfirmedMsg();
+  dst.confirmed = src.getBool();
+  dst.seq = src.getVarint();
+  dst.queued_at = src.getString();
+  return src.ok();
+}
+
+void encodeMsg(const QuantityConfirmedMsg& src, JsonObject dst) {
+  dst["type"] = "quantity_confirmed";
+  dst["confirmed"] = src.confirmed;
+  if (src.seq != 0) dst["seq"] = src.seq;
+  if (src.queued_at && src.queued_at[0]) dst["queued_at"] = src.queued_at;
+}
+
+void encodeMsg(const QuantityConfirmedMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_QUANTITY_CONFIRMED);
+  dst.putBool(src.confirmed);
+  dst.putVarint(src.seq);
+  dst.putString(src.queued_at);
+}
+
+void writeJson(const QuantityConfirmedMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"quantity_confirmed\",\"confirmed\":");
+  out.value(src.confirmed);
+  if (src.seq != 0) {
+    out.raw(",\"seq\":");
+    out.value(src.seq);
+  }
+  if (src.queued_at && src.queued_at[0]) {
+    out.raw(",\"queued_at\":");
+    out.value(src.queued_at, 5);
+  }
+  out.raw("}");
+}
+
+void hashMsg(const QuantityConfirmedMsg& src, MsgHash& h) {
+  h.add(src.confirmed);
+  h.add(src.seq);
+  h.add(src.queued_at);
+}
+
+bool decodeMsg(JsonObjectConst src, DispensingRequestMsg& dst) {
+  if (src.isNull()) return false;
+  dst = DispensingRequestMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'c':
+        if (strcmp(key, "container_id") == 0) {
+          dst.container_id = kv.value() | dst.container_id;
+        }
+        break;
+      case 'd':
+        if (strcmp(key, "dosage") == 0) {
+          dst.dosage = kv.value() | dst.dosage;
+        }
+        break;
+      case 'm':
+        if (strcmp(key, "medicine_name") == 0) {
+          dst.medicine_name = kv.value() | dst.medicine_name;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, DispensingRequestMsg& dst) {
+  dst = DispensingRequestMsg();
+  dst.container_id = src.getInt();
+  dst.dosage = src.getInt();
+  dst.medicine_name = src.getString();
+  return src.ok();
+}
+
+void encodeMsg(const DispensingRequestMsg& src, JsonObject dst) {
+  dst["type"] = "dispensing_request";
+  dst["container_id"] = src.container_id;
+  dst["dosage"] = src.dosage;
+  dst["medicine_name"] = src.medicine_name;
+}
+
+void encodeMsg(const DispensingRequestMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_DISPENSING_REQUEST);
+  dst.putInt(src.container_id);
+  dst.putInt(src.dosage);
+  dst.putString(src.medicine_name);
+}
+
+void writeJson(const DispensingRequestMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"dispensing_request\",\"container_id\":");
+  out.value(src.container_id);
+  out.raw(",\"dosage\":");
+  out.value(src.dosage);
+  out.raw(",\"medicine_name\":");
+  out.value(src.medicine_name, 32);
+  out.raw("}");
+}
+
+void hashMsg(const DispensingRequestMsg& src, MsgHash& h) {
+  h.add(src.container_id);
+  h.add(src.dosage);
+  h.add(src.medicine_name);
+}
+
+bool decodeMsg(JsonObjectConst src, JamClearedMsg& dst) {
+  if (src.isNull()) return false;
+  dst = JamClearedMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'c':
+        if (strcmp(key, "container_number") == 0) {
+          dst.container_number = kv.value() | dst.container_number;
+        }
+        break;
+      case 'q':
+        if (strcmp(key, "queued_at") == 0) {
+          dst.queued_at = kv.value() | dst.queued_at;
+        }
+        break;
+      case 's':
+        if (strcmp(key, "seq") == 0) {
+          dst.seq = kv.value() | dst.seq;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, JamClearedMsg& dst) {
+  dst = JamClearedMsg();
+  dst.container_number = src.getInt();
+  dst.seq = src.getVarint();
+  dst.queued_at = src.getString();
+  return src.ok();
+}
+
+void encodeMsg(const JamClearedMsg& src, JsonObject dst) {
+  dst["type"] = "jam_cleared";
+  dst["container_number"] = src.container_number;
+  if (src.seq != 0) dst["seq"] = src.seq;
+  if (src.queued_at && src.queued_at[0]) dst["queued_at"] = src.queued_at;
+}
+
+void encodeMsg(const JamClearedMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_JAM_CLEARED);
+  dst.putInt(src.container_number);
+  dst.putVarint(src.seq);
+  dst.putString(src.queued_at);
+}
+
+void writeJson(const JamClearedMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"jam_cleared\",\"container_number\":");
+  out.value(src.container_number);
+  if (src.seq != 0) {
+    out.raw(",\"seq\":");
+    out.value(src.seq);
+  }
+  if (src.queued_at && src.queued_at[0]) {
+    out.raw(",\"queued_at\":");
+    out.value(src.queued_at, 5);
+  }
+  out.raw("}");
+}
+
+void hashMsg(const JamClearedMsg& src, MsgHash& h) {
+  h.add(src.container_number);
+  h.add(src.seq);
+  h.add(src.queued_at);
+}
+
+bool decodeMsg(JsonObjectConst src, HelloMsg& dst) {
+  if (src.isNull()) return false;
+  dst = HelloMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'e':
+        if (strcmp(key, "encodings") == 0) {
+          dst.encodings = kv.value() | dst.encodings;
+        }
+        break;
+      case 'f':
+        if (strcmp(key, "features") == 0) {
+          dst.features = kv.value() | dst.features;
+        }
+        break;
+      case 'm':
+        if (strcmp(key, "max_frame") == 0) {
+          dst.max_frame = kv.value() | dst.max_frame;
+        } else if (strcmp(key, "max_baud") == 0) {
+          dst.max_baud = kv.value() | dst.max_baud;
+        }
+        break;
+      case 'p':
+        if (strcmp(key, "proto_version") == 0) {
+          dst.proto_version = kv.value() | dst.proto_version;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, HelloMsg& dst) {
+  dst = HelloMsg();
+  dst.proto_version = src.getVarint();
+  dst.max_frame = src.getVarint();
+  dst.encodings = src.getVarint();
+  dst.features = src.getVarint();
+  dst.max_baud = src.getVarint();
+  return src.ok();
+}
+
+void encodeMsg(const HelloMsg& src, JsonObject dst) {
+  dst["type"] = "hello";
+  dst["proto_version"] = src.proto_version;
+  dst["max_frame"] = src.max_frame;
+  dst["encodings"] = src.encodings;
+  dst["features"] = src.features;
+  dst["max_baud"] = src.max_baud;
+}
+
+void encodeMsg(const HelloMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_HELLO);
+  dst.putVarint(src.proto_version);
+  dst.putVarint(src.max_frame);
+  dst.putVarint(src.encodings);
+  dst.putVarint(src.features);
+  dst.putVarint(src.max_baud);
+}
+
+void writeJson(const HelloMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"hello\",\"proto_version\":");
+  out.value(src.proto_version);
+  out.raw(",\"max_frame\":");
+  out.value(src.max_frame);
+  out.raw(",\"encodings\":");
+  out.value(src.encodings);
+  out.raw(",\"features\":");
+  out.value(src.features);
+  out.raw(",\"max_baud\":");
+  out.value(src.max_baud);
+  out.raw("}");
+}
+
+void hashMsg(const HelloMsg& src, MsgHash& h) {
+  h.add(src.proto_version);
+  h.add(src.max_frame);
+  h.add(src.encodings);
+  h.add(src.features);
+  h.add(src.max_baud);
+}
+
+bool decodeMsg(JsonObjectConst src, OfflineReminderMsg& dst) {
+  if (src.isNull()) return false;
+  dst = OfflineReminderMsg();
+  for (JsonPairConst kv : src) {
+    const char* key = kv.key().c_str();
+    switch (key[0]) {
+      case 'd':
+        if (strcmp(key, "dismissed") == 0) {
+          dst.dismissed = kv.value() | dst.dismissed;
+        }
+        break;
+      case 'r':
+        if (strcmp(key, "reminder_id") == 0) {
+          dst.reminder_id = kv.value() | dst.reminder_id;
+        } else if (strcmp(key, "reminder_time") == 0) {
+          dst.reminder_time = kv.value() | dst.reminder_time;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool decodeMsg(BinReader& src, OfflineReminderMsg& dst) {
+  dst = OfflineReminderMsg();
+  dst.reminder_id = src.getInt();
+  dst.reminder_time = src.getString();
+  dst.dismissed = src.getBool();
+  return src.ok();
+}
+
+void encodeMsg(const OfflineReminderMsg& src, JsonObject dst) {
+  dst["type"] = "offline_reminder";
+  dst["reminder_id"] = src.reminder_id;
+  dst["reminder_time"] = src.reminder_time;
+  dst["dismissed"] = src.dismissed;
+}
+
+void encodeMsg(const OfflineReminderMsg& src, BinWriter& dst) {
+  dst.putByte(MSG_BINARY_MAGIC);
+  dst.putByte(MSG_OFFLINE_REMINDER);
+  dst.putInt(src.reminder_id);
+  dst.putString(src.reminder_time);
+  dst.putBool(src.dismissed);
+}
+
+void writeJson(const OfflineReminderMsg& src, JsonWriter& out) {
+  out.raw("{\"type\":\"offline_reminder\",\"reminder_id\":");
+  out.value(src.reminder_id);
+  out.raw(",\"reminder_time\":");
+  out.value(src.reminder_time, 5);
+  out.raw(",\"dismissed\":");
+  out.value(src.dismissed);
+  out.raw("}");
+}
+
+void hashMsg(const OfflineReminderMsg& src, MsgHash& h) {
+  h.add(src.reminder_id);
+  h.add(src.reminder_time);
+  h.add(src.dismissed);
+}
@@ -0,0 +1,66 @@
+#include "model_arena.h"
+#include "snapshot.h"
+
+// Sizes are exact; each segment takes its size rounded up to 4 so the next
+// one starts aligned
+static uint32_t arena[MODEL_ARENA_SIZE / 4];
+static size_t segmentSize[SEG_COUNT];
+
+static size_t aligned(size_t bytes) {
+  return (bytes + 3) & ~(size_t)3;
+}
+
+static size_t segmentOffset(uint8_t segment) {
+  size_t offset = 0;
+  for (uint8_t i = 0; i < segment; i++) offset += aligned(segmentSize[i]);
+  return offset;
+}
+
+void* arenaData(uint8_t segment) {
+  return (uint8_t*)arena + segmentOffset(segment);
+}
+
+size_t arenaSize(uint8_t segment) {
+  return segmentSize[segment];
+}
+
+size_t arenaUsed() {
+  return segmentOffset(SEG_COUNT);
+}
+
+size_t arenaFree() {
+  return sizeof(arena) - arenaUsed();
+}
+
+bool arenaResize(uint8_t segment, size_t bytes) {
+  size_t old = aligned(segmentSize[segment]);
+  size_t now = aligned(bytes);
+  if (now > old && now - old > arenaFree()) return false;
+
+  uint8_t* base = (uint8_t*)arena;
+  size_t start = segmentOffset(segment);
+  if (now != old) {
+    size_t tail = arenaUsed() - (start + old);
+    memmove(base + start + now, base + start + old, tail);
+  }
+  if (bytes > segmentSize[segment]) memset(base + start + segmentSize[segment], 0, bytes - segmentSize[segment]);
+  segmentSize[segment] = bytes;
+  return true;
+}
+
+void arenaSave() {
+  uint32_t sizes[SEG_COUNT];
+  for (uint8_t i = 0; i < SEG_COUNT; i++) sizes[i] = segmentSize[i];
+  snapshotPut(sizes, sizeof(sizes));
+  snapshotPut(arena, arenaUsed());
+}
+
+bool arenaLoad() {
+  uint32_t sizes[SEG_COUNT];
+  if (!snapshotGet(sizes, sizeof(sizes))) return false;
+  size_t total = 0;
+  for (uint8_t i = 0; i < SEG_COUNT; i++) total += aligned(sizes[i]);
+  if (total > sizeof(arena) || !snapshotGet(arena, total)) return false;
+  for (uint8_t i = 0; i < SEG_COUNT; i++) segmentSize[i] = sizes[i];
+  return true;
+}
@@ -0,0 +1,120 @@
+#include "name_table.h"
+#include "fixed_string.h"
+#include "log.h"
+#include "snapshot.h"
+
+struct NameEntry {
+  uint16_t offset;  // into namePool
+  uint8_t length;
+  bool used;
+  bool marked;
+};
+
+static NameEntry names[NAME_TABLE_SIZE];
+static char namePool[NAME_POOL_SIZE];
+static uint16_t poolUsed = 0;
+
+static NameId findName(const char* text, size_t len) {
+  for (NameId id = 1; id < NAME_TABLE_SIZE; id++) {
+    const NameEntry& e = names[id];
+    if (e.used && e.length == len && memcmp(namePool + e.offset, text, len) == 0) return id;
+  }
+  return NAME_NONE;
+}
+
+static NameId freeSlot() {
+  for (NameId id = 1; id < NAME_TABLE_SIZE; id++) {
+    if (!names[id].used) return id;
+  }
+  return NAME_NONE;
+}
+
+static NameId addName(const char* text, size_t len) {
+  NameId id = freeSlot();
+  if (id == NAME_NONE || poolUsed + len + 1 > NAME_POOL_SIZE) return NAME_NONE;
+
+  memcpy(namePool + poolUsed, text, len + 1);
+  names[id].offset = poolUsed;
+  names[id].length = len;
+  names[id].used = true;
+  poolUsed += len + 1;
+  return id;
+}
+
+NameId internName(const char* name) {
+  FixedString<NAME_MAX_LEN> text = name;
+  size_t len = text.length();
+  if (len == 0) return NAME_NONE;
+
+  NameId id = findName(text.c_str(), len);
+  if (id != NAME_NONE) return id;
+
+  id = addName(text.c_str(), len);
+  if (id == NAME_NONE) {
+    compactNames();
+    id = addName(text.c_str(), len);
+    if (id == NAME_NONE) LOG_WARN("Name table full, dropping \"%s\"", text.c_str());
+  }
+  return id;
+}
+
+const char* nameText(NameId id) {
+  if (id == NAME_NONE || id >= NAME_TABLE_SIZE || !names[id].used) return "";
+  return namePool + names[id].offset;
+}
+
+void nameMark(NameId id) {
+  if (id != NAME_NONE && id < NAME_TABLE_SIZE) names[id].marked = true;
+}
+
+void compactNames() {
+  for (NameId id = 1; id < NAME_TABLE_SIZE; id++) names[id].marked = false;
+  markLiveNames();
+
+  for (NameId id = 1; id < NAME_TABLE_SIZE; id++) {
+    if (!names[id].marked) names[id].used = false;
+  }
+
+  // Slide the surviving names down in pool order; ids do not change
+  uint16_t cursor = 0;
+  for (;;) {
+    NameId next = NAME_NONE;
+    for (NameId id = 1; id < NAME_TABLE_SIZE; id++) {
+      if (names[id].used && names[id].offset >= cursor &&
+          (next == NAME_NONE || names[id].offset < names[next].offset)) {
+        next = id;
+      }
+    }
+    if (next == NAME_NONE) break;
+
+    NameEntry& e = names[next];
+    if (e.offset != cursor) {
+      memmove(namePool + cursor, namePool + e.offset, e.length + 1);
+      e.offset = cursor;
+    }
+    cursor += e.length + 1;
+  }
+  poolUsed = cursor;
+}
+
+uint8_t nameCount() {
+  uint8_t count = 0;
+  for (NameId id = 1; id < NAME_TABLE_SIZE; id++) {
+    if (names[id].used) count++;
+  }
+  return count;
+}
+
+void nameTableSave() {
+  snapshotPut(&poolUsed, sizeof(poolUsed));
+  snapshotPut(names, sizeof(names));
+  snapshotPut(namePool, poolUsed);
+}
+
+bool nameTableLoad() {
+  uint16_t used;
+  if (!snapshotGet(&used, sizeof(used)) || used > NAME_POOL_SIZE) return false;
+  if (!snapshotGet(names, sizeof(names)) || !snapshotGet(namePool, used)) return false;
+  poolUsed = used;
+  return true;
+}
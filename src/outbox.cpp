@@ -0,0 +1,154 @@
+#include "outbox.h"
+#include <LittleFS.h>
+#include "link.h"
+#include "log.h"
+#include "tx_frame.h"
+
+static const uint8_t OUTBOX_MAGIC[4] = {'O', 'B', 'X', '1'};
+
+struct OutboxEntry {
+  uint32_t seq;
+  uint8_t len;
+  uint8_t payload[OUTBOX_PAYLOAD];
+};
+
+static OutboxEntry entries[OUTBOX_SLOTS];  // oldest first
+static int entryCount = 0;
+static uint32_t nextSeq = 1;
+static bool headSent = false;  // waiting for the head's ack
+static unsigned long headSentAt = 0;
+
+static bool mountFs() {
+  if (LittleFS.begin(true)) return true;
+  LOG_ERROR("Outbox: LittleFS mount failed");
+  return false;
+}
+
+// Rewrites the whole file; it is a few hundred bytes at most
+static void save() {
+  if (!mountFs()) return;
+  File f = LittleFS.open(OUTBOX_TEMP_FILE, "w");
+  if (!f) {
+    LOG_ERROR("Outbox: cannot create %s", OUTBOX_TEMP_FILE);
+    return;
+  }
+  uint8_t count = entryCount;
+  size_t body = entryCount * sizeof(OutboxEntry);
+  bool ok = f.write(OUTBOX_MAGIC, 4) == 4 &&
+            f.write((const uint8_t*)&nextSeq, 4) == 4 &&
+            f.write(&count, 1) == 1 &&
+            f.write((const uint8_t*)entries, body) == body;
+  f.close();
+  if (!ok || !LittleFS.rename(OUTBOX_TEMP_FILE, OUTBOX_FILE)) {
+    LOG_ERROR("Outbox: save failed");
+    LittleFS.remove(OUTBOX_TEMP_FILE);
+  }
+}
+
+void outboxBegin() {
+  entryCount = 0;
+  headSent = false;
+  if (!mountFs() || !LittleFS.exists(OUTBOX_FILE)) return;
+
+  File f = LittleFS.open(OUTBOX_FILE, "r");
+  if (!f) return;
+  uint8_t magic[4];
+  uint8_t count = 0;
+  bool ok = f.read(magic, 4) == 4 && memcmp(magic, OUTBOX_MAGIC, 4) == 0 &&
+            f.read((uint8_t*)&nextSeq, 4) == 4 &&
+            f.read(&count, 1) == 1 && count <= OUTBOX_SLOTS &&
+            f.read((uint8_t*)entries, count * sizeof(OutboxEntry)) == count * sizeof(OutboxEntry);
+  f.close();
+  for (int i = 0; ok && i < count; i++) {
+    if (entries[i].len > OUTBOX_PAYLOAD) ok = false;
+  }
+  if (!ok) {
+    LOG_WARN("Outbox: %s unreadable, starting empty", OUTBOX_FILE);
+    return;
+  }
+  entryCount = count;
+  if (entryCount) LOG_INFO("Outbox: %d responses waiting for the minder", entryCount);
+}
+
+uint32_t outboxTakeSeq() {
+  return nextSeq++;
+}
+
+static void removeAt(int index) {
+  memmove(&entries[index], &entries[index + 1], (entryCount - index - 1) * sizeof(OutboxEntry));
+  entryCount--;
+  if (index == 0) headSent = false;
+}
+
+bool outboxAdd(uint32_t seq, const uint8_t* payload, size_t len) {
+  if (len > OUTBOX_PAYLOAD) return false;
+  if (entryCount == OUTBOX_SLOTS) {
+    LOG_WARN("Outbox full, dropping response #%u", (unsigned)entries[0].seq);
+    removeAt(0);
+  }
+  OutboxEntry& entry = entries[entryCount++];
+  entry.seq = seq;
+  entry.len = len;
+  memcpy(entry.payload, payload, len);
+  save();
+  return true;
+}
+
+template <typename T>
+static void sendDecoded(BinReader& reader) {
+  T msg;
+  if (decodeMsg(reader, msg)) sendToMinder(msg);
+}
+
+static void sendEntry(const OutboxEntry& entry) {
+  // Stored in binary form already
+  if (linkCaps.encodings & LINK_ENC_BINARY) {
+    memcpy(txFrame + TX_FRAME_HEADER, entry.payload, entry.len);
+    sendTxFrame(entry.len);
+    return;
+  }
+
+  // JSON link: back to the typed message first
+  BinReader reader(entry.payload, entry.len);
+  MsgType type;
+  if (!readMsgHeader(reader, type)) return;
+  switch (type) {
+    case MSG_CONFIRMATION_RESPONSE: sendDecoded<ConfirmationResponseMsg>(reader); break;
+    case MSG_QUANTITY_CONFIRMED: sendDecoded<QuantityConfirmedMsg>(reader); break;
+    case MSG_JAM_CLEARED: sendDecoded<JamClearedMsg>(reader); break;
+    default: LOG_WARN("Outbox: cannot send %s", msgTypeName(type)); break;
+  }
+}
+
+void outboxPoll(bool linkUp) {
+  // Wait for the handshake so acks are known to be on or off
+  if (entryCount == 0 || !linkUp || !linkSettled()) return;
+
+  bool acked = linkHasFeature(LINK_FEAT_OUTBOX_ACK);
+  if (acked && headSent && millis() - headSentAt < OUTBOX_RETRY_MS) return;
+
+  sendEntry(entries[0]);
+  if (acked) {
+    if (headSent) LOG_DEBUG("Outbox: resent #%u", (unsigned)entries[0].seq);
+    headSent = true;
+    headSentAt = millis();
+  } else {
+    removeAt(0);
+    save();
+  }
+}
+
+void outboxAck(uint32_t seq) {
+  for (int i = 0; i < entryCount; i++) {
+    if (entries[i].seq == seq) {
+      removeAt(i);
+      save();
+      return;
+    }
+  }
+  // Already removed: a duplicate ack for a resent entry
+}
+
+int outboxDepth() {
+  return entryCount;
+}
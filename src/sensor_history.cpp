@@ -0,0 +1,197 @@
+#include "sensor_history.h"
+
+static const uint16_t tierCapacity[TIER_COUNT] = {360, 168, 90};
+static const uint16_t tierMinutes[TIER_COUNT] = {1, 60, 1440};
+static const uint16_t tierBase[TIER_COUNT] = {0, 360, 360 + 168};
+
+static SensorSample samples[360 + 168 + 90];
+
+// The open sample of each tier, still taking readings
+struct Accumulator {
+  int32_t sum[2];
+  uint16_t count;
+  int16_t lo[2];
+  int16_t hi[2];
+};
+
+static Accumulator open[TIER_COUNT];
+static uint32_t newest[TIER_COUNT];  // index of the open sample
+static bool started = false;
+static uint32_t version = 0;
+
+// Minutes since the first reading, kept across millis() wrapping
+static uint32_t clockMinute = 0;
+static unsigned long clockMs = 0;
+
+static SensorSample& slot(SensorTier tier, uint32_t index) {
+  return samples[tierBase[tier] + index % tierCapacity[tier]];
+}
+
+static SensorStat closeStat(const Accumulator& acc, int series) {
+  SensorStat stat = {SENSOR_GAP, SENSOR_GAP, SENSOR_GAP};
+  if (acc.count) {
+    stat.avg = acc.sum[series] / acc.count;
+    stat.lo = acc.lo[series];
+    stat.hi = acc.hi[series];
+  }
+  return stat;
+}
+
+static SensorSample openSample(SensorTier tier) {
+  SensorSample sample;
+  sample.temperature = closeStat(open[tier], 0);
+  sample.humidity = closeStat(open[tier], 1);
+  return sample;
+}
+
+// Stores the open sample and gaps up to index, which becomes the open one
+static void advance(SensorTier tier, uint32_t index) {
+  slot(tier, newest[tier]) = openSample(tier);
+  SensorSample gap = {{SENSOR_GAP, SENSOR_GAP, SENSOR_GAP}, {SENSOR_GAP, SENSOR_GAP, SENSOR_GAP}};
+  uint32_t from = newest[tier] + 1;
+  if (index - from > tierCapacity[tier]) from = index - tierCapacity[tier];
+  for (uint32_t i = from; i < index; i++) slot(tier, i) = gap;
+  newest[tier] = index;
+  memset(&open[tier], 0, sizeof(open[tier]));
+}
+
+void sensorHistoryAdd(float temperature, float humidity, unsigned long nowMs) {
+  if (!started) {
+    clockMs = nowMs;
+  } else {
+    uint32_t minutes = (nowMs - clockMs) / 60000;
+    clockMinute += minutes;
+    clockMs += minutes * 60000UL;
+  }
+  int16_t value[2] = {(int16_t)lroundf(temperature * 10), (int16_t)lroundf(humidity * 10)};
+
+  for (int t = 0; t < TIER_COUNT; t++) {
+    SensorTier tier = (SensorTier)t;
+    uint32_t index = clockMinute / tierMinutes[t];
+    if (!started) {
+      newest[t] = index;
+      memset(&open[t], 0, sizeof(open[t]));
+    } else if (index != newest[t]) {
+      advance(tier, index);
+    }
+
+    Accumulator& acc = open[t];
+    for (int s = 0; s < 2; s++) {
+      acc.sum[s] += value[s];
+      if (!acc.count || value[s] < acc.lo[s]) acc.lo[s] = value[s];
+      if (!acc.count || value[s] > acc.hi[s]) acc.hi[s] = value[s];
+    }
+    acc.count++;
+  }
+  started = true;
+  version++;
+}
+
+uint16_t sensorHistoryCapacity(SensorTier tier) {
+  return tierCapacity[tier];
+}
+
+uint32_t sensorHistoryEnd(SensorTier tier) {
+  return started ? newest[tier] + 1 : 0;
+}
+
+uint32_t sensorHistoryVersion() {
+  return version;
+}
+
+bool sensorHistoryGet(SensorTier tier, uint32_t index, SensorSample& sample) {
+  if (!started || index > newest[tier] || newest[tier] - index >= tierCapacity[tier]) return false;
+  sample = index == newest[tier] ? openSample(tier) : slot(tier, index);
+  return sample.temperature.avg != SENSOR_GAP;
+}
+
+static bool getStat(SensorTier tier, bool humidity, uint32_t index, SensorStat& stat) {
+  SensorSample sample;
+  if (!sensorHistoryGet(tier, index, sample)) return false;
+  stat = humidity ? sample.humidity : sample.temperature;
+  return true;
+}
+
+// Average position and value of a bucket; false if it has no samples
+static bool bucketAverage(SensorTier tier, bool humidity, uint32_t first, uint32_t from, uint32_t to,
+                          int32_t& x, int32_t& y) {
+  int32_t sumX = 0;
+  int32_t sumY = 0;
+  int32_t n = 0;
+  SensorStat stat;
+  for (uint32_t i = from; i < to; i++) {
+    if (!getStat(tier, humidity, i, stat)) continue;
+    sumX += i - first;
+    sumY += stat.avg;
+    n++;
+  }
+  if (!n) return false;
+  x = sumX / n;
+  y = sumY / n;
+  return true;
+}
+
+int sensorHistoryDownsample(SensorTier tier, bool humidity, uint32_t first, uint16_t span,
+                            int buckets, ChartPoint* out) {
+  int count = 0;
+  bool haveA = false;  // last chosen point
+  int32_t ax = 0;
+  int32_t ay = 0;
+
+  for (int b = 0; b < buckets; b++) {
+    uint32_t from = first + (uint32_t)b * span / buckets;
+    uint32_t to = first + (uint32_t)(b + 1) * span / buckets;
+    uint32_t nextTo = first + (uint32_t)(b + 2) * span / buckets;
+    int32_t cx = 0;
+    int32_t cy = 0;
+    bool haveC = b + 1 < buckets && bucketAverage(tier, humidity, first, to, nextTo, cx, cy);
+
+    // Keep the sample forming the largest triangle with the last point and
+    // the next bucket's average. The first and last bucket keep their
+    // outermost samples, so the chart starts and ends on real readings.
+    ChartPoint best = {};
+    int32_t bestArea = -1;
+    int16_t lo = INT16_MAX;
+    int16_t hi = INT16_MIN;
+    SensorStat stat;
+    for (uint32_t i = from; i < to; i++) {
+      if (!getStat(tier, humidity, i, stat)) continue;
+      if (stat.lo < lo) lo = stat.lo;
+      if (stat.hi > hi) hi = stat.hi;
+
+      int32_t x = i - first;
+      int32_t area;
+      if (b == 0) {
+        area = bestArea < 0 ? 1 : 0;
+      } else if (b == buckets - 1) {
+        area = 1;
+      } else if (haveA && haveC) {
+        area = abs((ax - cx) * (stat.avg - ay) - (ax - x) * (cy - ay));
+      } else if (haveA) {
+        area = abs(stat.avg - ay);
+      } else if (haveC) {
+        area = abs(stat.avg - cy);
+      } else {
+        area = 0;
+      }
+      if (area > bestArea || (b == buckets - 1 && area == bestArea)) {
+        bestArea = area;
+        best.offset = x;
+        best.value = stat.avg;
+      }
+    }
+
+    if (bestArea < 0) {
+      haveA = false;  // a gap: the next bucket starts fresh
+      continue;
+    }
+    best.bucket = b;
+    best.lo = lo;
+    best.hi = hi;
+    out[count++] = best;
+    haveA = true;
+    ax = best.offset;
+    ay = best.value;
+  }
+  return count;
+}
@@ -0,0 +1,147 @@
+#include "snapshot.h"
+#include <LittleFS.h>
+#include "log.h"
+
+static const uint8_t SNAPSHOT_MAGIC[4] = {'S', 'N', 'P', '1'};
+#define SNAPSHOT_HEADER_SIZE 10  // magic + version + layout
+
+static File snapFile;
+static uint32_t snapCrc;
+static uint32_t snapLength;
+static bool snapFailed;
+
+static bool snapDirty = false;
+static unsigned long snapFirstChange = 0;
+static unsigned long snapLastChange = 0;
+
+static uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t len) {
+  crc = ~crc;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+  }
+  return ~crc;
+}
+
+static bool mountFs() {
+  if (LittleFS.begin(true)) return true;
+  LOG_ERROR("Snapshot: LittleFS mount failed");
+  return false;
+}
+
+static void putHeader(uint8_t* header, uint32_t layout) {
+  memcpy(header, SNAPSHOT_MAGIC, 4);
+  uint16_t version = SNAPSHOT_VERSION;
+  memcpy(header + 4, &version, 2);
+  memcpy(header + 6, &layout, 4);
+}
+
+bool snapshotBegin(uint32_t layout) {
+  if (!mountFs()) return false;
+  snapFile = LittleFS.open(SNAPSHOT_TEMP_FILE, "w");
+  if (!snapFile) {
+    LOG_ERROR("Snapshot: cannot create %s", SNAPSHOT_TEMP_FILE);
+    return false;
+  }
+  uint8_t header[SNAPSHOT_HEADER_SIZE];
+  putHeader(header, layout);
+  snapFailed = snapFile.write(header, sizeof(header)) != sizeof(header);
+  snapCrc = crc32Update(0, header, sizeof(header));
+  snapLength = 0;
+  return true;
+}
+
+void snapshotPut(const void* data, size_t len) {
+  if (snapFailed) return;
+  snapFailed = snapFile.write((const uint8_t*)data, len) != len;
+  snapCrc = crc32Update(snapCrc, (const uint8_t*)data, len);
+  snapLength += len;
+}
+
+bool snapshotEnd() {
+  uint32_t trailer[2] = {snapLength, snapCrc};
+  if (!snapFailed) snapFailed = snapFile.write((const uint8_t*)trailer, sizeof(trailer)) != sizeof(trailer);
+  snapFile.close();
+
+  if (snapFailed || !LittleFS.rename(SNAPSHOT_TEMP_FILE, SNAPSHOT_FILE)) {
+    LOG_ERROR("Snapshot: write failed");
+    LittleFS.remove(SNAPSHOT_TEMP_FILE);
+    return false;
+  }
+  LOG_INFO("Snapshot saved (%lu bytes)", (unsigned long)snapLength);
+  return true;
+}
+
+// Reads the whole file once to check header, length and CRC
+static bool validate(uint32_t layout) {
+  File f = LittleFS.open(SNAPSHOT_FILE, "r");
+  if (!f) return false;
+
+  uint8_t header[SNAPSHOT_HEADER_SIZE];
+  uint8_t expected[SNAPSHOT_HEADER_SIZE];
+  putHeader(expected, layout);
+  if (f.read(header, sizeof(header)) != sizeof(header) || memcmp(header, expected, sizeof(header)) != 0) {
+    f.close();
+    LOG_INFO("Snapshot: different version or layout, ignored");
+    return false;
+  }
+
+  size_t size = f.size();
+  if (size < sizeof(header) + 8) {
+    f.close();
+    return false;
+  }
+  uint32_t length = size - sizeof(header) - 8;
+  uint32_t crc = crc32Update(0, header, sizeof(header));
+  uint8_t buf[128];
+  for (uint32_t left = length; left > 0;) {
+    size_t n = f.read(buf, left < sizeof(buf) ? left : sizeof(buf));
+    if (n == 0) break;
+    crc = crc32Update(crc, buf, n);
+    left -= n;
+  }
+  uint32_t trailer[2] = {0, 0};
+  f.read((uint8_t*)trailer, sizeof(trailer));
+  f.close();
+
+  if (trailer[0] != length || trailer[1] != crc) {
+    LOG_WARN("Snapshot: CRC mismatch, ignored");
+    return false;
+  }
+  snapLength = length;
+  return true;
+}
+
+bool snapshotOpen(uint32_t layout) {
+  if (!mountFs() || !validate(layout)) return false;
+  snapFile = LittleFS.open(SNAPSHOT_FILE, "r");
+  if (!snapFile) return false;
+  uint8_t header[SNAPSHOT_HEADER_SIZE];
+  snapFile.read(header, sizeof(header));
+  return true;
+}
+
+bool snapshotGet(void* data, size_t len) {
+  if (len > snapLength) return false;
+  snapLength -= len;
+  return snapFile.read((uint8_t*)data, len) == len;
+}
+
+void snapshotClose() {
+  snapFile.close();
+}
+
+void snapshotMarkDirty() {
+  unsigned long now = millis();
+  if (!snapDirty) snapFirstChange = now;
+  snapLastChange = now;
+  snapDirty = true;
+}
+
+bool snapshotDue() {
+  if (!snapDirty) return false;
+  unsigned long now = millis();
+  if (now - snapLastChange < SNAPSHOT_QUIET_MS && now - snapFirstChange < SNAPSHOT_MAX_WAIT_MS) return false;
+  snapDirty = false;
+  return true;
+}
@@ -0,0 +1,95 @@
+#include "timer_wheel.h"
+#include "model_arena.h"
+
+#define TIMER_NIL 0xFFFF
+
+struct TimerNode {
+  uint16_t next;
+  uint16_t tag;
+  DayMinute minute;
+};
+
+static ArenaList<TimerNode> timerNodes(SEG_TIMERS);
+static uint16_t minuteSlots[60];  // timers due later in the current hour
+static uint16_t hourSlots[24];    // everything else, by hour
+static DayMinute wheelNow = MINUTE_NONE;
+
+static void push(uint16_t& head, uint16_t node) {
+  timerNodes[node].next = head;
+  head = node;
+}
+
+// Into the minute slot if it is still ahead this hour, else its hour slot
+static void place(uint16_t node) {
+  DayMinute minute = timerNodes[node].minute;
+  if (wheelNow != MINUTE_NONE && minute / 60 == wheelNow / 60 && minute > wheelNow) {
+    push(minuteSlots[minute % 60], node);
+  } else {
+    push(hourSlots[minute / 60], node);
+  }
+}
+
+static void resetSlots() {
+  for (int i = 0; i < 60; i++) minuteSlots[i] = TIMER_NIL;
+  for (int i = 0; i < 24; i++) hourSlots[i] = TIMER_NIL;
+}
+
+// Re-files every timer around a new position, without firing
+static void restart(DayMinute now) {
+  wheelNow = now;
+  resetSlots();
+  for (size_t i = 0; i < timerNodes.size(); i++) place(i);
+}
+
+void timerWheelClear() {
+  timerNodes.clear();
+  resetSlots();
+}
+
+bool timerAdd(DayMinute minute, uint16_t tag) {
+  if (minute >= MINUTES_PER_DAY) return false;
+  size_t index = timerNodes.size();
+  if (index >= TIMER_NIL || timerNodes.resize(index + 1) != index + 1) return false;
+  timerNodes[index].tag = tag;
+  timerNodes[index].minute = minute;
+  place(index);
+  return true;
+}
+
+size_t timerCount() {
+  return timerNodes.size();
+}
+
+// One minute forward: spread a new hour, then fire this minute's slot
+static void tick(TimerFire fire) {
+  wheelNow = (wheelNow + 1) % MINUTES_PER_DAY;
+
+  if (wheelNow % 60 == 0) {
+    uint16_t node = hourSlots[wheelNow / 60];
+    hourSlots[wheelNow / 60] = TIMER_NIL;
+    while (node != TIMER_NIL) {
+      uint16_t next = timerNodes[node].next;
+      push(minuteSlots[timerNodes[node].minute % 60], node);
+      node = next;
+    }
+  }
+
+  uint16_t node = minuteSlots[wheelNow % 60];
+  minuteSlots[wheelNow % 60] = TIMER_NIL;
+  while (node != TIMER_NIL) {
+    uint16_t next = timerNodes[node].next;
+    push(hourSlots[wheelNow / 60], node);  // tomorrow
+    fire(timerNodes[node].tag, wheelNow);
+    node = next;
+  }
+}
+
+void timerWheelAdvance(DayMinute now, TimerFire fire) {
+  if (now >= MINUTES_PER_DAY || now == wheelNow) return;
+  int behind = (now - wheelNow + MINUTES_PER_DAY) % MINUTES_PER_DAY;
+  if (wheelNow == MINUTE_NONE || behind > TIMER_MAX_CATCHUP) {
+    restart(now);
+    return;
+  }
+  while (wheelNow != now) tick(fire);
+}
@@ -0,0 +1,19 @@
+#include "tx_frame.h"
+#include "frame.h"
+
+char txFrame[TX_FRAME_SIZE];
+
+void sendTxFrame(size_t payloadLen) {
+  uint8_t* frame = (uint8_t*)txFrame;
+  uint8_t checksum = 0;
+  for (size_t i = 0; i < payloadLen; i++) {
+    checksum ^= frame[TX_FRAME_HEADER + i];
+  }
+  frame[0] = FRAME_SYNC;
+  frame[1] = FRAME_SYNC;
+  frame[2] = payloadLen >> 8;
+  frame[3] = payloadLen & 0xFF;
+  frame[TX_FRAME_HEADER + payloadLen] = checksum;
+  frame[TX_FRAME_HEADER + payloadLen + 1] = 0x00;
+  SerialPort.write(frame, TX_FRAME_HEADER + payloadLen + TX_FRAME_TRAILER);
+}
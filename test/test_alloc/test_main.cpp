@@ -0,0 +1,54 @@
+// Syncing and drawing must not touch the heap. Runs on the board with the
+// malloc wrappers of include/alloc_count.h:
+//
+//   pio test -e test_alloc
+
+#include <Arduino.h>
+#include <unity.h>
+#include "alloc_count.h"
+#include "log.h"
+
+// src/main.cpp
+void displayBegin();
+uint32_t syncAllocations();
+bool syncedNamesShared();
+int allocCheckScreenCount();
+uint32_t screenAllocations(int index);
+
+void setUp() {
+  if (!allocCountEnabled()) TEST_IGNORE_MESSAGE("needs the ALLOC_COUNT flags (env:test_alloc)");
+}
+
+void tearDown() {
+}
+
+void test_sync_without_allocations() {
+  TEST_ASSERT_EQUAL(0, syncAllocations());
+  TEST_ASSERT_TRUE_MESSAGE(syncedNamesShared(), "records hold different ids for the same medicine");
+}
+
+// Runs after the sync, so the list screens have rows
+void test_screens_draw_without_allocations() {
+  for (int i = 0; i < allocCheckScreenCount(); i++) {
+    uint32_t allocations = screenAllocations(i);
+    char screen[16];
+    snprintf(screen, sizeof(screen), "screen %d", i);
+    TEST_ASSERT_EQUAL_MESSAGE(0, allocations, screen);
+  }
+}
+
+void setup() {
+  delay(2000);  // the test runner opens the port after reset
+  Serial.begin(115200);
+  logBegin();
+  displayBegin();
+  allocCountBegin();
+
+  UNITY_BEGIN();
+  RUN_TEST(test_sync_without_allocations);
+  RUN_TEST(test_screens_draw_without_allocations);
+  UNITY_END();
+}
+
+void loop() {
+}
@@ -0,0 +1,489 @@
+#!/usr/bin/env python3
+"""Generate typed message structs and codecs from schema/messages.json.
+
+Writes include/messages.h and src/messages.cpp. The output only depends on
+ArduinoJson and include/msg_codec.h, so the same files can be dropped into the
+minder firmware. Run it by hand after editing the schema, or let PlatformIO run
+it as a pre-build script (see platformio.ini).
+"""
+
+import json
+import os
+import sys
+
+CPP_TYPES = {
+    "bool": "bool",
+    "int": "int",
+    "uint": "uint32_t",
+    "float": "float",
+    "string": "const char*",
+}
+
+BIN_PUT = {
+    "bool": "putBool",
+    "int": "putInt",
+    "uint": "putVarint",
+    "float": "putFloat",
+    "string": "putString",
+}
+
+BIN_GET = {
+    "bool": "getBool",
+    "int": "getInt",
+    "uint": "getVarint",
+    "float": "getFloat",
+    "string": "getString",
+}
+
+
+def camel(name):
+    return "".join(part.capitalize() for part in name.split("_"))
+
+
+def msg_struct(msg):
+    return camel(msg["type"]) + "Msg"
+
+
+def msg_enum(msg):
+    return "MSG_" + msg["type"].upper()
+
+
+def default_literal(field):
+    t = field["type"]
+    d = field.get("default")
+    if t == "string":
+        return json.dumps(d if d is not None else "")
+    if t == "bool":
+        return "true" if d else "false"
+    if t == "float":
+        return repr(float(d or 0.0)) + "f"
+    return str(int(d or 0))
+
+
+def cpp_type(field):
+    if field["type"] == "list":
+        return "MsgList<%s>" % field["of"]
+    return CPP_TYPES[field["type"]]
+
+
+# Worst-case JSON text length of a value, or None when unbounded
+VALUE_BOUNDS = {
+    "bool": 5,      # false
+    "int": 11,      # -2147483648
+    "uint": 10,     # 4294967295
+    "float": 15,    # sign, 10 digits, point, 3 decimals
+}
+
+
+def max_json_len(type_name, fields):
+    total = 2 + len('"type":"%s"' % type_name)
+    for f in fields:
+        if f["type"] == "list":
+            return None
+        if f["type"] == "string":
+            if "max_len" not in f:
+                return None
+            bound = 2 + 6 * f["max_len"]  # quotes + \u00XX per char at worst
+        else:
+            bound = VALUE_BOUNDS[f["type"]]
+        total += 1 + len('"%s":' % f["name"]) + bound
+    return total
+
+
+def emit_struct(out, name, fields, type_enum=None, max_len=None):
+    out.append("struct %s {" % name)
+    if type_enum:
+        out.append("  static const MsgType TYPE = %s;" % type_enum)
+        out.append("  static const size_t MAX_JSON_LEN = %d;%s" %
+                   (max_len or 0, "" if max_len else "  // unbounded"))
+    for f in fields:
+        if f["type"] == "list":
+            out.append("  %s %s;" % (cpp_type(f), f["name"]))
+        else:
+            out.append("  %s %s = %s;" % (cpp_type(f), f["name"], default_literal(f)))
+    out.append("};")
+    out.append("")
+
+
+def emit_prototypes(out, name):
+    out.append("bool decodeMsg(JsonObjectConst src, %s& dst);" % name)
+    out.append("bool decodeMsg(BinReader& src, %s& dst);" % name)
+    out.append("void encodeMsg(const %s& src, JsonObject dst);" % name)
+    out.append("void encodeMsg(const %s& src, BinWriter& dst);" % name)
+    out.append("void writeJson(const %s& src, JsonWriter& out);" % name)
+    out.append("void hashMsg(const %s& src, MsgHash& h);" % name)
+    out.append("")
+
+
+def json_assign(f, target):
+    if f["type"] == "list":
+        return "dst.%s = MsgList<%s>::fromJson(kv.value().as<JsonArrayConst>());" % (target, f["of"])
+    return "dst.%s = kv.value() | dst.%s;" % (target, target)
+
+
+def emit_json_decode(out, name, fields):
+    out.append("bool decodeMsg(JsonObjectConst src, %s& dst) {" % name)
+    out.append("  if (src.isNull()) return false;")
+    out.append("  dst = %s();" % name)
+    if not fields:
+        out.append("  return true;")
+        out.append("}")
+        out.append("")
+        return
+
+    aliased = [f for f in fields if f.get("aliases")]
+    for f in aliased:
+        out.append("  bool seen_%s = false;" % f["name"])
+
+    # One pass over the object; keys are matched by first character, then strcmp
+    keys = {}
+    for f in fields:
+        keys.setdefault(f["name"][0], []).append((f["name"], f, False))
+        for alias in f.get("aliases", []):
+            keys.setdefault(alias[0], []).append((alias, f, True))
+
+    out.append("  for (JsonPairConst kv : src) {")
+    out.append("    const char* key = kv.key().c_str();")
+    out.append("    switch (key[0]) {")
+    for ch in sorted(keys):
+        out.append("      case '%s':" % ch)
+        first = True
+        for key, f, is_alias in keys[ch]:
+            cond = 'strcmp(key, "%s") == 0' % key
+            if is_alias:
+                cond = "!seen_%s && %s" % (f["name"], cond)
+            out.append("        %sif (%s) {" % ("" if first else "} else ", cond))
+            out.append("          " + json_assign(f, f["name"]))
+            if f.get("aliases") and not is_alias:
+                out.append("          seen_%s = true;" % f["name"])
+            first = False
+        out.append("        }")
+        out.append("        break;")
+    out.append("    }")
+    out.append("  }")
+    out.append("  return true;")
+    out.append("}")
+    out.append("")
+
+
+def emit_bin_decode(out, name, fields):
+    out.append("bool decodeMsg(BinReader& src, %s& dst) {" % name)
+    out.append("  dst = %s();" % name)
+    for f in fields:
+        if f["type"] == "list":
+            out.append("  src.getList(dst.%s);" % f["name"])
+        else:
+            out.append("  dst.%s = src.%s();" % (f["name"], BIN_GET[f["type"]]))
+    out.append("  return src.ok();")
+    out.append("}")
+    out.append("")
+
+
+def omit_condition(f):
+    t = f["type"]
+    if t == "string":
+        if not f.get("default"):
+            return "src.%s && src.%s[0]" % (f["name"], f["name"])
+        return "src.%s && strcmp(src.%s, %s) != 0" % (f["name"], f["name"], default_literal(f))
+    if t == "bool":
+        return ("!src.%s" if f.get("default") else "src.%s") % f["name"]
+    return "src.%s != %s" % (f["name"], default_literal(f))
+
+
+def emit_json_encode(out, name, fields, type_name=None):
+    out.append("void encodeMsg(const %s& src, JsonObject dst) {" % name)
+    if type_name:
+        out.append('  dst["type"] = "%s";' % type_name)
+    for f in fields:
+        if f["type"] == "list":
+            out.append("  {")
+            out.append('    JsonArray items = dst["%s"].to<JsonArray>();' % f["name"])
+            out.append("    for (const %s& item : src.%s) {" % (f["of"], f["name"]))
+            out.append("      encodeMsg(item, items.add<JsonObject>());")
+            out.append("    }")
+            out.append("  }")
+            continue
+        line = 'dst["%s"] = src.%s;' % (f["name"], f["name"])
+        if f.get("omit_default"):
+            out.append("  if (%s) %s" % (omit_condition(f), line))
+        else:
+            out.append("  " + line)
+    out.append("}")
+    out.append("")
+
+
+def emit_bin_encode(out, name, fields, type_enum=None):
+    out.append("void encodeMsg(const %s& src, BinWriter& dst) {" % name)
+    if type_enum:
+        out.append("  dst.putByte(MSG_BINARY_MAGIC);")
+        out.append("  dst.putByte(%s);" % type_enum)
+    for f in fields:
+        if f["type"] == "list":
+            out.append("  {")
+            out.append("    size_t mark = dst.beginList();")
+            out.append("    uint16_t count = 0;")
+            out.append("    for (const %s& item : src.%s) {" % (f["of"], f["name"]))
+            out.append("      encodeMsg(item, dst);")
+            out.append("      count++;")
+            out.append("    }")
+            out.append("    dst.endList(mark, count);")
+            out.append("  }")
+        else:
+            out.append("  dst.%s(src.%s);" % (BIN_PUT[f["type"]], f["name"]))
+    out.append("}")
+    out.append("")
+
+
+def emit_hash(out, name, fields):
+    out.append("void hashMsg(const %s& src, MsgHash& h) {" % name)
+    fields = [f for f in fields if f.get("hash", True)]
+    for f in fields:
+        if f["type"] == "list":
+            out.append("  h.add((uint32_t)src.%s.size());" % f["name"])
+            out.append("  for (const %s& item : src.%s) {" % (f["of"], f["name"]))
+            out.append("    hashMsg(item, h);")
+            out.append("  }")
+        else:
+            out.append("  h.add(src.%s);" % f["name"])
+    if not fields:
+        out.append("  (void)src;")
+        out.append("  (void)h;")
+    out.append("}")
+    out.append("")
+
+
+def c_literal(text):
+    return '"%s"' % text.replace("\\", "\\\\").replace('"', '\\"')
+
+
+def emit_json_writer(out, name, fields, type_name=None):
+    """Direct JSON writer: constant key text is merged into literal runs."""
+    out.append("void writeJson(const %s& src, JsonWriter& out) {" % name)
+    pending = ["{"]
+    first = True
+    if type_name:
+        pending.append('"type":"%s"' % type_name)
+        first = False
+
+    def flush():
+        if pending:
+            out.append("  out.raw(%s);" % c_literal("".join(pending)))
+            del pending[:]
+
+    for f in fields:
+        key = ('' if first else ',') + '"%s":' % f["name"]
+        first = False
+        if f.get("omit_default"):
+            flush()
+            out.append("  if (%s) {" % omit_condition(f))
+            out.append("    out.raw(%s);" % c_literal(key))
+            out.append("    " + json_write_value(f))
+            out.append("  }")
+            continue
+        pending.append(key)
+        if f["type"] == "list":
+            pending.append("[")
+            flush()
+            out.append("  {")
+            out.append("    bool firstItem = true;")
+            out.append("    for (const %s& item : src.%s) {" % (f["of"], f["name"]))
+            out.append('      if (!firstItem) out.raw(",");')
+            out.append("      writeJson(item, out);")
+            out.append("      firstItem = false;")
+            out.append("    }")
+            out.append("  }")
+            pending.append("]")
+            continue
+        flush()
+        out.append("  " + json_write_value(f))
+    pending.append("}")
+    flush()
+    out.append("}")
+    out.append("")
+
+
+def json_write_value(f):
+    if f["type"] == "string" and "max_len" in f:
+        return "out.value(src.%s, %d);" % (f["name"], f["max_len"])
+    return "out.value(src.%s);" % f["name"]
+
+
+def emit_dispatcher(out, fn, msgs, handle=True):
+    out.append("template <typename Source>")
+    out.append("bool %s(MsgType type, Source& src) {" % fn)
+    out.append("  switch (type) {")
+    for m in msgs:
+        out.append("    case %s: {" % msg_enum(m))
+        out.append("      %s msg;" % msg_struct(m))
+        if handle:
+            out.append("      if (!decodeMsg(src, msg)) return false;")
+            out.append("      handleMessage(msg);")
+            out.append("      return true;")
+        else:
+            out.append("      return decodeMsg(src, msg);")
+        out.append("    }")
+    out.append("    default:")
+    out.append("      return false;")
+    out.append("  }")
+    out.append("}")
+    out.append("")
+
+
+def generate(schema):
+    records = schema["records"]
+    all_messages = schema["messages"]
+    # Envelopes (e.g. batch) only get an id and a name; their payload is other messages
+    messages = [m for m in all_messages if not m.get("envelope")]
+    banner = "// Generated by tools/gen_messages.py from schema/messages.json - do not edit.\n"
+
+    h = [banner.rstrip(), "#pragma once", "", '#include "msg_codec.h"', ""]
+    h.append("#define MSG_SCHEMA_VERSION %d" % schema["version"])
+    h.append("")
+    h.append("enum MsgType : uint8_t {")
+    h.append("  MSG_UNKNOWN = 0,")
+    for m in all_messages:
+        h.append("  %s = %d," % (msg_enum(m), m["id"]))
+    h.append("};")
+    h.append("")
+    h.append("const char* msgTypeName(MsgType type);")
+    h.append("MsgType msgTypeFromName(const char* name);")
+    h.append("MsgType msgTypeFromId(uint8_t id);")
+    h.append("bool readMsgHeader(BinReader& src, MsgType& type);")
+    h.append("")
+
+    h.append("// ---- Records ----")
+    h.append("")
+    for r in records:
+        emit_struct(h, r["name"], r["fields"])
+    for r in records:
+        emit_prototypes(h, r["name"])
+
+    h.append("// ---- Messages ----")
+    h.append("")
+    for m in messages:
+        emit_struct(h, msg_struct(m), m["fields"], msg_enum(m), max_json_len(m["type"], m["fields"]))
+    for m in messages:
+        emit_prototypes(h, msg_struct(m))
+
+    for side in ("display", "minder"):
+        h.append("// Handlers for messages sent to the %s, implemented by that firmware" % side)
+        for m in messages:
+            if m["to"] == side:
+                h.append("void handleMessage(const %s& msg);" % msg_struct(m))
+        h.append("")
+
+    h.append("// Decode one message from a JSON object or a BinReader and call handleMessage()")
+    emit_dispatcher(h, "dispatchDisplayMessage", [m for m in messages if m["to"] == "display"])
+    emit_dispatcher(h, "dispatchMinderMessage", [m for m in messages if m["to"] == "minder"])
+    h.append("// Decode only, to check a message before anything is applied")
+    emit_dispatcher(h, "validateDisplayMessage", [m for m in messages if m["to"] == "display"], handle=False)
+    emit_dispatcher(h, "validateMinderMessage", [m for m in messages if m["to"] == "minder"], handle=False)
+
+    c = [banner.rstrip(), '#include "messages.h"', ""]
+    c.append("const char* msgTypeName(MsgType type) {")
+    c.append("  switch (type) {")
+    for m in all_messages:
+        c.append('    case %s: return "%s";' % (msg_enum(m), m["type"]))
+    c.append('    default: return "unknown";')
+    c.append("  }")
+    c.append("}")
+    c.append("")
+    c.append("MsgType msgTypeFromName(const char* name) {")
+    c.append("  if (!name) return MSG_UNKNOWN;")
+    c.append("  switch (name[0]) {")
+    by_char = {}
+    for m in all_messages:
+        by_char.setdefault(m["type"][0], []).append(m)
+    for ch in sorted(by_char):
+        c.append("    case '%s':" % ch)
+        for m in by_char[ch]:
+            c.append('      if (strcmp(name, "%s") == 0) return %s;' % (m["type"], msg_enum(m)))
+        c.append("      break;")
+    c.append("  }")
+    c.append("  return MSG_UNKNOWN;")
+    c.append("}")
+    c.append("")
+    c.append("MsgType msgTypeFromId(uint8_t id) {")
+    c.append("  switch (id) {")
+    for m in all_messages:
+        c.append("    case %d: return %s;" % (m["id"], msg_enum(m)))
+    c.append("    default: return MSG_UNKNOWN;")
+    c.append("  }")
+    c.append("}")
+    c.append("")
+    c.append("bool readMsgHeader(BinReader& src, MsgType& type) {")
+    c.append("  if (src.getByte() != MSG_BINARY_MAGIC) return false;")
+    c.append("  type = msgTypeFromId(src.getByte());")
+    c.append("  return src.ok() && type != MSG_UNKNOWN;")
+    c.append("}")
+    c.append("")
+
+    for r in records:
+        emit_json_decode(c, r["name"], r["fields"])
+        emit_bin_decode(c, r["name"], r["fields"])
+        emit_json_encode(c, r["name"], r["fields"])
+        emit_bin_encode(c, r["name"], r["fields"])
+        emit_json_writer(c, r["name"], r["fields"])
+        emit_hash(c, r["name"], r["fields"])
+    for m in messages:
+        name = msg_struct(m)
+        emit_json_decode(c, name, m["fields"])
+        emit_bin_decode(c, name, m["fields"])
+        emit_json_encode(c, name, m["fields"], m["type"])
+        emit_bin_encode(c, name, m["fields"], msg_enum(m))
+        emit_json_writer(c, name, m["fields"], m["type"])
+        emit_hash(c, name, m["fields"])
+
+    return "\n".join(h).rstrip() + "\n", "\n".join(c).rstrip() + "\n"
+
+
+def validate(schema):
+    names = set()
+    ids = set()
+    for r in schema["records"]:
+        names.add(r["name"])
+    for m in schema["messages"]:
+        if m["id"] in ids or not 0 < m["id"] < 256:
+            sys.exit("schema: bad or duplicate id %s for %s" % (m["id"], m["type"]))
+        ids.add(m["id"])
+        if m["to"] not in ("display", "minder"):
+            sys.exit("schema: %s has unknown direction %s" % (m["type"], m["to"]))
+        if m.get("envelope") and m["fields"]:
+            sys.exit("schema: envelope %s cannot have fields" % m["type"])
+    for r in schema["records"]:
+        # writeJson() emits the first field without a leading comma
+        if r["fields"] and r["fields"][0].get("omit_default"):
+            sys.exit("schema: first field of %s cannot be omit_default" % r["name"])
+    for owner in schema["records"] + schema["messages"]:
+        for f in owner["fields"]:
+            if f["type"] == "list":
+                if f["of"] not in names:
+                    sys.exit("schema: unknown record %s" % f["of"])
+            elif f["type"] not in CPP_TYPES:
+                sys.exit("schema: unknown type %s" % f["type"])
+
+
+def write_if_changed(path, text):
+    if os.path.exists(path):
+        with open(path) as fh:
+            if fh.read() == text:
+                return
+    with open(path, "w") as fh:
+        fh.write(text)
+    print("gen_messages: wrote %s" % path)
+
+
+def main(project_dir):
+    with open(os.path.join(project_dir, "schema", "messages.json")) as fh:
+        schema = json.load(fh)
+    validate(schema)
+    header, source = generate(schema)
+    write_if_changed(os.path.join(project_dir, "include", "messages.h"), header)
+    write_if_changed(os.path.join(project_dir, "src", "messages.cpp"), source)
+
+
+if __name__ == "__main__":
+    main(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+else:
+    Import("env")  # noqa: F821 - provided by PlatformIO for extra_scripts
+    main(env.subst("$PROJECT_DIR"))  # noqa: F821
@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+"""Inspect and replay frame captures taken with captureBegin() (see include/capture.h).
+
+A capture is either the CAPTURE_FILE pulled from flash ("CAP1" + records) or a
+serial monitor log containing "CAP <ms> <hex>" lines.
+
+  replay.py dump capture.log
+  replay.py convert capture.log capture.bin
+  replay.py play capture.bin --port /dev/ttyUSB1 [--speed 4 | --speed max]
+                             [--monitor /dev/ttyUSB0]
+
+"play" sends the frames to the display's UART (GPIO16) through a USB serial
+adapter, keeping the recorded spacing divided by --speed. With --monitor, the
+display's debug port is read at the same time. The firmware must be built with
+-DLOG_LEVEL=LOG_LEVEL_DEBUG so that it prints one timing line per frame, and
+the script summarizes those lines when the replay ends.
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+import threading
+import time
+
+SCHEMA = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "schema", "messages.json")
+BINARY_MAGIC = 0xB5
+TIMING_RE = re.compile(r"Frame (\d+) bytes: parse (\d+) us, render (\d+) us")
+
+
+def load(path):
+    """Returns [(ms, payload bytes)] from a binary capture or a monitor log."""
+    with open(path, "rb") as f:
+        raw = f.read()
+    frames = []
+    if raw.startswith(b"CAP1"):
+        pos = 4
+        while pos + 6 <= len(raw):
+            ms, length = struct.unpack_from("<IH", raw, pos)
+            pos += 6
+            if pos + length > len(raw):
+                print("warning: truncated capture", file=sys.stderr)
+                break
+            frames.append((ms, raw[pos:pos + length]))
+            pos += length
+    else:
+        for line in raw.decode("utf-8", "replace").splitlines():
+            m = re.search(r"CAP (\d+) ([0-9a-f]+)", line)
+            if m:
+                frames.append((int(m.group(1)), bytes.fromhex(m.group(2))))
+    return frames
+
+
+def encode_frame(payload):
+    checksum = 0
+    for b in payload:
+        checksum ^= b
+    return bytes([0x7E, 0x7E, len(payload) >> 8, len(payload) & 0xFF]) + payload + bytes([checksum, 0x00])
+
+
+def message_names():
+    with open(SCHEMA) as f:
+        schema = json.load(f)
+    return {m["id"]: m["type"] for m in schema["messages"]}
+
+
+def describe(payload, names):
+    if payload and payload[0] == BINARY_MAGIC:
+        return "%s (binary)" % names.get(payload[1] if len(payload) > 1 else -1, "?")
+    try:
+        return json.loads(payload.decode("utf-8")).get("type", "?")
+    except (ValueError, UnicodeDecodeError, AttributeError):
+        return "<unparseable>"
+
+
+def cmd_dump(args):
+    frames = load(args.capture)
+    names = message_names()
+    base = frames[0][0] if frames else 0
+    for ms, payload in frames:
+        print("%10.3f  %5d  %s" % ((ms - base) / 1000.0, len(payload), describe(payload, names)))
+    print("%d frames" % len(frames))
+
+
+def cmd_convert(args):
+    frames = load(args.capture)
+    with open(args.output, "wb") as f:
+        f.write(b"CAP1")
+        for ms, payload in frames:
+            f.write(struct.pack("<IH", ms & 0xFFFFFFFF, len(payload)))
+            f.write(payload)
+    print("wrote %d frames to %s" % (len(frames), args.output))
+
+
+def monitor(port, timings, stop):
+    while not stop.is_set():
+        line = port.readline().decode("utf-8", "replace")
+        m = TIMING_RE.search(line)
+        if m:
+            timings.append(tuple(int(g) for g in m.groups()))
+
+
+def summarize(name, values):
+    values = sorted(values)
+    if not values:
+        return
+    pick = lambda q: values[min(len(values) - 1, int(q * len(values)))]
+    print("  %-6s avg %6d us  p50 %6d  p95 %6d  max %6d" %
+          (name, sum(values) // len(values), pick(0.5), pick(0.95), values[-1]))
+
+
+def cmd_play(args):
+    import serial  # pyserial
+
+    frames = load(args.capture)
+    speed = 0.0 if args.speed == "max" else float(args.speed)
+    out = serial.Serial(args.port, args.baud)
+
+    timings, stop, reader = [], threading.Event(), None
+    if args.monitor:
+        mon = serial.Serial(args.monitor, 115200, timeout=0.2)
+        reader = threading.Thread(target=monitor, args=(mon, timings, stop), daemon=True)
+        reader.start()
+
+    start = time.monotonic()
+    base = frames[0][0] if frames else 0
+    for ms, payload in frames:
+        if speed > 0:
+            wait = start + (ms - base) / 1000.0 / speed - time.monotonic()
+            if wait > 0:
+                time.sleep(wait)
+        out.write(encode_frame(payload))
+    out.flush()
+    print("sent %d frames in %.1f s" % (len(frames), time.monotonic() - start))
+
+    if reader:
+        time.sleep(args.settle)
+        stop.set()
+        reader.join()
+        print("device timings for %d frames:" % len(timings))
+        summarize("parse", [t[1] for t in timings])
+        summarize("render", [t[2] for t in timings])
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="command")
+    sub.required = True
+
+    p = sub.add_parser("dump", help="list the frames in a capture")
+    p.add_argument("capture")
+    p.set_defaults(func=cmd_dump)
+
+    p = sub.add_parser("convert", help="turn a monitor log into a binary capture for flash")
+    p.add_argument("capture")
+    p.add_argument("output")
+    p.set_defaults(func=cmd_convert)
+
+    p = sub.add_parser("play", help="send a capture to the display's UART")
+    p.add_argument("capture")
+    p.add_argument("--port", required=True, help="serial adapter wired to the display RX (GPIO16)")
+    p.add_argument("--baud", type=int, default=9600)
+    p.add_argument("--speed", default="1", help="time scale (1 = recorded pace) or 'max'")
+    p.add_argument("--monitor", help="display debug port, to collect per-frame timings")
+    p.add_argument("--settle", type=float, default=2.0, help="seconds to keep reading timings after the last frame")
+    p.set_defaults(func=cmd_play)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()